@@ -19,6 +19,16 @@
 */
 #define Q_NASSERT
 
+/*! The preprocessor switch to activate the QS-nano software tracing
+* instrumentation in the code
+*
+* @description
+* When defined, Q_SPY activates the QS-nano software tracing
+* instrumentation. When Q_SPY is not defined, the QS-nano instrumentation
+* in the code does not generate any code.
+*/
+#define Q_SPY
+
 /*! @deprecated macro to  enable keeping track of QF time event usage;
 * instead use: #QF_TIMEEVT_USAGE */
 #define Q_TIMERSET
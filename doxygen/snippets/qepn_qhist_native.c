@@ -0,0 +1,45 @@
+typedef struct  {
+    QHsm super; /* inherit QHsm */
+
+    QHsmHist hist_doorClosed; /* history of doorClosed (kept by QEP-nano) */
+} ToastOven;
+
+/*..........................................................*/
+void ToastOven_ctor(ToastOven * const me) {
+    QHsm_ctor(&me->super, Q_STATE_CAST(&ToastOven_initial));
+    QHsm_addHist(&me->super, &me->hist_doorClosed, /*<== before init */
+                 Q_STATE_CAST(&ToastOven_doorClosed));
+}
+/*..........................................................*/
+static QState ToastOven_doorClosed(ToastOven * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        ~ ~ ~
+        /* no exit action is needed to save the history */
+        case Q_INIT_SIG: {
+            status_ = Q_TRAN(&ToastOven_off);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................*/
+static QState ToastOven_doorOpen(ToastOven * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        ~ ~ ~
+        case CLOSE_SIG: {
+            status_ = Q_TRAN_HIST_DEEP(&ToastOven_doorClosed); /*<== */
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
@@ -0,0 +1,24 @@
+typedef struct {
+    QActive super; /* inherit QActive */
+    ~ ~ ~
+} Philo;
+
+static QState Philo_initial (Philo * const me);
+static QState Philo_thinking(Philo * const me);
+static QState Philo_hungry  (Philo * const me);
+static QState Philo_eating  (Philo * const me);
+
+/* signals handled by the states of Philo (all other signals are
+* discarded without calling any state handler)
+*/
+static QHsmMask const Q_ROM l_philoMasks[] = {
+    { Q_STATE_CAST(&Philo_thinking), Q_SIG_BIT(Q_TIMEOUT_SIG) },
+    { Q_STATE_CAST(&Philo_hungry),   Q_SIG_BIT(EAT_SIG) },
+    { Q_STATE_CAST(&Philo_eating),   Q_SIG_BIT(Q_TIMEOUT_SIG) }
+};
+
+/*..........................................................*/
+void Philo_ctor(Philo * const me) {
+    QActive_ctor(&me->super, Q_STATE_CAST(&Philo_initial));
+    QHSM_SET_MASKS(me, l_philoMasks); /*<== before QHSM_INIT() */
+}
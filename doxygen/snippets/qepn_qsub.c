@@ -0,0 +1,67 @@
+typedef struct {
+    QHsm super; /* inherit QHsm */
+    uint8_t retries; /* used by the Retry submachine */
+} Link;
+
+/* the Retry submachine, reused in the states Link_connecting and
+* Link_sending of the host HSM
+*/
+static QState Link_retry_waiting(Link * const me); /* entry point */
+static QState Link_retry_trying(Link * const me);
+
+/*..........................................................*/
+static QState Link_retry_waiting(Link * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        ~ ~ ~
+        case TIMEOUT_SIG: {
+            if (me->retries < MAX_RETRIES) {
+                ++me->retries;
+                status_ = Q_TRAN(&Link_retry_trying);
+            }
+            else {
+                status_ = Q_TRAN_XP(RETRY_FAILED_SIG); /*<== exit point */
+            }
+            break;
+        }
+        default: {
+            status_ = Q_SUPER_SUB(); /*<== superstate is the host state */
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................*/
+static QState Link_connecting(Link * const me) { /* submachine state */
+    QState status_;
+    switch (Q_SIG(me)) {
+        ~ ~ ~
+        case Q_INIT_SIG: {
+            me->retries = 0U;
+            status_ = Q_TRAN_EP(&Link_connecting, &Link_retry_waiting);
+            break;
+        }
+        case RETRY_FAILED_SIG: { /* exit point of the Retry submachine */
+            status_ = Q_TRAN(&Link_offline);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................*/
+static QState Link_offline(Link * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        ~ ~ ~
+        case SEND_SIG: { /* enter the Retry submachine in Link_sending */
+            status_ = Q_TRAN_EP(&Link_sending, &Link_retry_trying); /*<==*/
+            break;
+        }
+        ~ ~ ~
+    }
+    return status_;
+}
@@ -0,0 +1,744 @@
+/*****************************************************************************
+* Product: QP-nano core micro-benchmarks, POSIX
+* Last Updated for Version: 6.0.4
+* Date of the Last Update:  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. state-machine.com.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* Web  : http://www.state-machine.com
+* Email: info@state-machine.com
+*****************************************************************************/
+#include "qpn.h"  /* QP-nano */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+Q_DEFINE_THIS_FILE
+
+/* The benchmarks print one JSON object per line (JSON Lines) to stdout:
+*
+* {"bench":"tran","case":"b+d",...,"ns":12.3}       -- transition by LCA case
+* {"bench":"tran_depth","depth":3,...}              -- cousin transition
+* {"bench":"dispatch","kind":"ignored","depth":4,...} -- no transition
+* {"bench":"tick","aos":8,"timers":4,...}           -- QF_tickXISR()
+* {"bench":"post_dispatch","aos":2,...,"evt_per_s":...} -- QF_run() loop
+* {"bench":"xthread_latency",...,"p50_ns":...}      -- post from a thread
+*
+* Every record carries the QP-nano configuration ("param_size",
+* "ctr_size"). The "ns" values are the best of BENCH_REPEAT runs
+* (default 3); BENCH_SCALE (default 1) multiplies the iteration counts.
+*/
+
+enum BenchSignals {
+    A_SIG = Q_USER_SIG, /* (a) self-transition */
+    B_SIG,   /* (b) source == target->super */
+    D_SIG,   /* (d) source->super == target */
+    C_SIG,   /* (c) source->super == target->super */
+    E_SIG,   /* (e) source == target->super->super */
+    G_SIG,   /* (g) back from the (e) target */
+    F_SIG,   /* (f) source->super == target->super->super */
+    H_SIG,   /* (g) back from the (f) target */
+    X_SIG,   /* (g) cousin at the same depth in the other branch */
+    N_SIG,   /* handled without a transition */
+    I_SIG,   /* ignored in all states */
+    PING_SIG,
+    PONG_SIG,
+    LAT_SIG,
+    DONE_SIG
+};
+
+#if (Q_PARAM_SIZE != 0)
+    #define BENCH_POST(me_, sig_) QACTIVE_POST((me_), (sig_), 0U)
+#else
+    #define BENCH_POST(me_, sig_) QACTIVE_POST((me_), (sig_))
+#endif
+
+/* HSM for the transition benchmarks ---------------------------------------*/
+/*
+*  top
+*   +-L1-----------------+   +-R1--------+
+*   | +-L2--------+ +-M2-+   | +-R2----+ |
+*   | | +-L3----+ | | M3 |   | | +-R3+ | |
+*   | | |  L4   | | |    |   | | |R4 | | |
+*/
+typedef struct {
+    QHsm super;
+    uint32_t count; /* entry/exit actions executed */
+} BenchHsm;
+
+static BenchHsm l_hsm;
+
+static QState BenchHsm_initial(BenchHsm * const me);
+static QState BenchHsm_L1(BenchHsm * const me);
+static QState BenchHsm_L2(BenchHsm * const me);
+static QState BenchHsm_L3(BenchHsm * const me);
+static QState BenchHsm_L4(BenchHsm * const me);
+static QState BenchHsm_M2(BenchHsm * const me);
+static QState BenchHsm_M3(BenchHsm * const me);
+static QState BenchHsm_R1(BenchHsm * const me);
+static QState BenchHsm_R2(BenchHsm * const me);
+static QState BenchHsm_R3(BenchHsm * const me);
+static QState BenchHsm_R4(BenchHsm * const me);
+
+/* the states of the left branch by depth, index 0 is depth 1 */
+static QStateHandler const l_left[] = {
+    Q_STATE_CAST(&BenchHsm_L1), Q_STATE_CAST(&BenchHsm_L2),
+    Q_STATE_CAST(&BenchHsm_L3), Q_STATE_CAST(&BenchHsm_L4)
+};
+
+/*..........................................................................*/
+static QState BenchHsm_initial(BenchHsm * const me) {
+    me->count = 0U;
+    return Q_TRAN(&BenchHsm_L1);
+}
+/*..........................................................................*/
+static QState BenchHsm_L1(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case B_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L2);
+            break;
+        }
+        case C_SIG: {
+            status_ = Q_TRAN(&BenchHsm_R1);
+            break;
+        }
+        case E_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L3);
+            break;
+        }
+        case X_SIG: {
+            status_ = Q_TRAN(&BenchHsm_R1);
+            break;
+        }
+        case N_SIG: {
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_L2(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case A_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L2);
+            break;
+        }
+        case D_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L1);
+            break;
+        }
+        case F_SIG: {
+            status_ = Q_TRAN(&BenchHsm_M3);
+            break;
+        }
+        case X_SIG: {
+            status_ = Q_TRAN(&BenchHsm_R2);
+            break;
+        }
+        case N_SIG: {
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&BenchHsm_L1);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_L3(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case G_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L1);
+            break;
+        }
+        case X_SIG: {
+            status_ = Q_TRAN(&BenchHsm_R3);
+            break;
+        }
+        case N_SIG: {
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&BenchHsm_L2);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_L4(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case X_SIG: {
+            status_ = Q_TRAN(&BenchHsm_R4);
+            break;
+        }
+        case N_SIG: {
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&BenchHsm_L3);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_M2(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&BenchHsm_L1);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_M3(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case H_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L2);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&BenchHsm_M2);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_R1(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case C_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L1);
+            break;
+        }
+        case X_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L1);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_R2(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case X_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L2);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&BenchHsm_R1);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_R3(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case X_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L3);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&BenchHsm_R2);
+            break;
+        }
+    }
+    return status_;
+}
+/*..........................................................................*/
+static QState BenchHsm_R4(BenchHsm * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: /* intentionally fall through */
+        case Q_EXIT_SIG: {
+            ++me->count;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case X_SIG: {
+            status_ = Q_TRAN(&BenchHsm_L4);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&BenchHsm_R3);
+            break;
+        }
+    }
+    return status_;
+}
+
+/* active objects for the QF-nano benchmarks -------------------------------*/
+typedef struct {
+    QActive super;
+    uint32_t n; /* events left in the current run */
+} BenchAO;
+
+static BenchAO l_ao[8];
+static QEvt l_aoQueue[8][4];
+
+QActiveCB const Q_ROM QF_active[] = {
+    { (QActive *)0,          (QEvt *)0,    0U                   },
+    { (QActive *)&l_ao[0],   l_aoQueue[0], Q_DIM(l_aoQueue[0])  },
+    { (QActive *)&l_ao[1],   l_aoQueue[1], Q_DIM(l_aoQueue[1])  },
+    { (QActive *)&l_ao[2],   l_aoQueue[2], Q_DIM(l_aoQueue[2])  },
+    { (QActive *)&l_ao[3],   l_aoQueue[3], Q_DIM(l_aoQueue[3])  },
+    { (QActive *)&l_ao[4],   l_aoQueue[4], Q_DIM(l_aoQueue[4])  },
+    { (QActive *)&l_ao[5],   l_aoQueue[5], Q_DIM(l_aoQueue[5])  },
+    { (QActive *)&l_ao[6],   l_aoQueue[6], Q_DIM(l_aoQueue[6])  },
+    { (QActive *)&l_ao[7],   l_aoQueue[7], Q_DIM(l_aoQueue[7])  }
+};
+
+static QState BenchAO_initial(BenchAO * const me);
+static QState BenchAO_active(BenchAO * const me);
+
+/* state of the QF_run() part of the benchmark */
+static struct {
+    uint32_t nEvt;         /* # events per throughput run */
+    uint32_t nLat;         /* # latency samples */
+    uint32_t run;          /* current run (0..2*repeat-1), then latency */
+    double   best[2];      /* best time [s] of the self/ping-pong runs */
+    struct timespec t0;    /* start of the current run */
+    struct timespec sent;  /* time stamp of the cross-thread post */
+    uint64_t *lat;         /* latency samples [ns] */
+    uint32_t nLatDone;
+    sem_t ack;             /* the AO received the cross-thread post */
+    pthread_t thread;
+} l_run;
+
+static uint32_t l_scale;
+static uint32_t l_repeat;
+
+/*..........................................................................*/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+/*..........................................................................*/
+static uint32_t envOr(char_t const *name, uint32_t const def) {
+    char_t const *val = getenv(name);
+    return (val != (char_t *)0) ? (uint32_t)strtoul(val, (char **)0, 0)
+                                : def;
+}
+/*..........................................................................*/
+static void printConf(void) {
+    printf("\"param_size\":%d,\"ctr_size\":%d}\n",
+           (int)Q_PARAM_SIZE, (int)QF_TIMEEVT_CTR_SIZE);
+}
+
+/* transition benchmarks ---------------------------------------------------*/
+/* dispatches sig1 and sig2 alternately starting in the given state,
+* returns the best time per dispatch [ns]
+*/
+static double dispatchPair(QStateHandler const start,
+                           enum_t const sig1, enum_t const sig2)
+{
+    uint32_t const n = 1000000U * l_scale;
+    double best = 1e30;
+    uint32_t r;
+
+    for (r = 0U; r < l_repeat; ++r) {
+        double t;
+        uint32_t i;
+        l_hsm.super.state = start; /* stable state configuration */
+        l_hsm.super.temp  = start;
+        t = now();
+        for (i = 0U; i < n; ++i) {
+            Q_SIG(&l_hsm) = (QSignal)sig1;
+            QHSM_DISPATCH(&l_hsm.super);
+            Q_SIG(&l_hsm) = (QSignal)sig2;
+            QHSM_DISPATCH(&l_hsm.super);
+        }
+        t = (now() - t) * 1e9 / (2.0 * (double)n);
+        if (t < best) {
+            best = t;
+        }
+        Q_ASSERT(l_hsm.super.state == start); /* back in the start state */
+    }
+    return best;
+}
+/*..........................................................................*/
+static void benchTran(void) {
+    static struct {
+        char const *name;
+        QStateHandler start;
+        enum_t sig1;
+        enum_t sig2;
+    } const cases[] = {
+        { "a",   Q_STATE_CAST(&BenchHsm_L2), A_SIG, A_SIG },
+        { "b+d", Q_STATE_CAST(&BenchHsm_L1), B_SIG, D_SIG },
+        { "c",   Q_STATE_CAST(&BenchHsm_L1), C_SIG, C_SIG },
+        { "e+g", Q_STATE_CAST(&BenchHsm_L1), E_SIG, G_SIG },
+        { "f+g", Q_STATE_CAST(&BenchHsm_L2), F_SIG, H_SIG }
+    };
+    uint_fast8_t i;
+
+    QHsm_ctor(&l_hsm.super, Q_STATE_CAST(&BenchHsm_initial));
+    QHSM_INIT(&l_hsm.super);
+
+    for (i = 0U; i < Q_DIM(cases); ++i) {
+        printf("{\"bench\":\"tran\",\"case\":\"%s\",\"ns\":%.2f,",
+               cases[i].name,
+               dispatchPair(cases[i].start, cases[i].sig1, cases[i].sig2));
+        printConf();
+    }
+    for (i = 0U; i < Q_DIM(l_left); ++i) {
+        printf("{\"bench\":\"tran_depth\",\"depth\":%u,\"ns\":%.2f,",
+               (unsigned)(i + 1U), dispatchPair(l_left[i], X_SIG, X_SIG));
+        printConf();
+    }
+    for (i = 0U; i < Q_DIM(l_left); ++i) {
+        printf("{\"bench\":\"dispatch\",\"kind\":\"handled\","
+               "\"depth\":%u,\"ns\":%.2f,",
+               (unsigned)(i + 1U), dispatchPair(l_left[i], N_SIG, N_SIG));
+        printConf();
+        printf("{\"bench\":\"dispatch\",\"kind\":\"ignored\","
+               "\"depth\":%u,\"ns\":%.2f,",
+               (unsigned)(i + 1U), dispatchPair(l_left[i], I_SIG, I_SIG));
+        printConf();
+    }
+}
+
+/* clock tick benchmark ----------------------------------------------------*/
+static void benchTick(void) {
+#if (QF_TIMEEVT_CTR_SIZE != 0)
+    /* the longest timeout, which does not expire within a batch */
+    QTimeEvtCtr const tout = (QTimeEvtCtr)~(QTimeEvtCtr)0;
+    uint_fast8_t const maxActive = QF_maxActive_;
+    uint32_t const n = 1000000U * l_scale;
+    uint_fast8_t nAO;
+
+    for (nAO = 1U; nAO <= maxActive; ++nAO) {
+        uint_fast8_t nTimers;
+        QF_maxActive_ = nAO; /* QF_tickXISR() iterates over these AOs */
+        for (nTimers = 0U; nTimers <= nAO; ++nTimers) {
+            double best = 1e30;
+            uint32_t r;
+            for (r = 0U; r < l_repeat; ++r) {
+                double t = 0.0;
+                uint32_t done = 0U;
+                while (done < n) {
+                    uint32_t batch = (uint32_t)tout - 1U;
+                    uint32_t i;
+                    double t0;
+                    uint_fast8_t p;
+                    for (p = 1U; p <= nAO; ++p) { /* (re)arm the timers */
+                        if (p <= nTimers) {
+                            QActive_armX(QF_ROM_ACTIVE_GET_(p), 0U, tout);
+                        }
+                        else {
+                            QActive_disarmX(QF_ROM_ACTIVE_GET_(p), 0U);
+                        }
+                    }
+                    if (batch > (n - done)) {
+                        batch = n - done;
+                    }
+                    QF_INT_DISABLE();
+                    t0 = now();
+                    for (i = 0U; i < batch; ++i) {
+                        QF_tickXISR(0U);
+                    }
+                    t += now() - t0;
+                    QF_INT_ENABLE();
+                    done += batch;
+                }
+                t = t * 1e9 / (double)n;
+                if (t < best) {
+                    best = t;
+                }
+            }
+            printf("{\"bench\":\"tick\",\"aos\":%u,\"timers\":%u,"
+                   "\"ns\":%.2f,",
+                   (unsigned)nAO, (unsigned)nTimers, best);
+            printConf();
+        }
+    }
+    QF_maxActive_ = maxActive;
+    for (nAO = 1U; nAO <= maxActive; ++nAO) {
+        QActive_disarmX(QF_ROM_ACTIVE_GET_(nAO), 0U);
+    }
+#endif /* (QF_TIMEEVT_CTR_SIZE != 0) */
+}
+
+/* QF_run() benchmarks: post+dispatch throughput, cross-thread latency -----*/
+static void *latencyThread(void *par) {
+    uint32_t i;
+    (void)par;
+    for (i = 0U; i < l_run.nLat; ++i) {
+        clock_gettime(CLOCK_MONOTONIC, &l_run.sent);
+        BENCH_POST(&l_ao[0], LAT_SIG);
+        while (sem_wait(&l_run.ack) != 0) { /* retry if interrupted */
+        }
+    }
+    BENCH_POST(&l_ao[0], DONE_SIG);
+    return (void *)0;
+}
+/*..........................................................................*/
+static int cmpU64(void const *a, void const *b) {
+    uint64_t const x = *(uint64_t const *)a;
+    uint64_t const y = *(uint64_t const *)b;
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+/*..........................................................................*/
+static void startRun(void) {
+    if (l_run.run < (2U * l_repeat)) { /* throughput runs alternate */
+        l_ao[0].n = l_run.nEvt;
+        clock_gettime(CLOCK_MONOTONIC, &l_run.t0);
+        BENCH_POST(&l_ao[0], PING_SIG);
+    }
+    else { /* cross-thread latency */
+        l_run.lat = (uint64_t *)calloc(l_run.nLat, sizeof(uint64_t));
+        Q_ASSERT(l_run.lat != (uint64_t *)0);
+        Q_ALLEGE(sem_init(&l_run.ack, 0, 0U) == 0);
+        Q_ALLEGE(pthread_create(&l_run.thread, (pthread_attr_t *)0,
+                                &latencyThread, (void *)0) == 0);
+    }
+}
+/*..........................................................................*/
+static void endRun(void) {
+    struct timespec t1;
+    double t;
+    uint32_t k = l_run.run & 1U; /* 0: self-post, 1: ping-pong */
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    t = (double)(t1.tv_sec - l_run.t0.tv_sec)
+        + ((double)(t1.tv_nsec - l_run.t0.tv_nsec) * 1e-9);
+    if ((l_run.best[k] == 0.0) || (t < l_run.best[k])) {
+        l_run.best[k] = t;
+    }
+    ++l_run.run;
+    if (l_run.run == (2U * l_repeat)) { /* all throughput runs done? */
+        for (k = 0U; k < 2U; ++k) {
+            /* a ping-pong round trip consists of two events */
+            double const nEvt = (double)l_run.nEvt * (double)(k + 1U);
+            printf("{\"bench\":\"post_dispatch\",\"aos\":%u,"
+                   "\"ns\":%.2f,\"evt_per_s\":%.0f,",
+                   (unsigned)(k + 1U),
+                   l_run.best[k] * 1e9 / nEvt, nEvt / l_run.best[k]);
+            printConf();
+        }
+    }
+    startRun();
+}
+/*..........................................................................*/
+static void endLatency(void) {
+    uint32_t const n = l_run.nLat;
+    pthread_join(l_run.thread, (void **)0);
+    sem_destroy(&l_run.ack);
+    qsort(l_run.lat, n, sizeof(uint64_t), &cmpU64);
+    printf("{\"bench\":\"xthread_latency\",\"n\":%u,\"min_ns\":%llu,"
+           "\"p50_ns\":%llu,\"p99_ns\":%llu,\"max_ns\":%llu,",
+           (unsigned)n,
+           (unsigned long long)l_run.lat[0],
+           (unsigned long long)l_run.lat[n / 2U],
+           (unsigned long long)l_run.lat[(n * 99U) / 100U],
+           (unsigned long long)l_run.lat[n - 1U]);
+    printConf();
+    free(l_run.lat);
+    QF_stop();
+}
+/*..........................................................................*/
+static QState BenchAO_initial(BenchAO * const me) {
+    if (me == &l_ao[0]) {
+        startRun(); /* the first throughput run */
+    }
+    return Q_TRAN(&BenchAO_active);
+}
+/*..........................................................................*/
+static QState BenchAO_active(BenchAO * const me) {
+    QState status_;
+    switch (Q_SIG(me)) {
+        /* self-posting (even runs) or ping-pong with l_ao[1] (odd runs) */
+        case PING_SIG: {
+            if (me->n != 0U) {
+                --me->n;
+                if ((l_run.run & 1U) == 0U) {
+                    BENCH_POST(me, PING_SIG);
+                }
+                else {
+                    BENCH_POST(&l_ao[1], PONG_SIG);
+                }
+            }
+            else {
+                endRun();
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        case PONG_SIG: {
+            BENCH_POST(&l_ao[0], PING_SIG);
+            status_ = Q_HANDLED();
+            break;
+        }
+        case LAT_SIG: {
+            struct timespec t1;
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+            l_run.lat[l_run.nLatDone] =
+                ((uint64_t)(t1.tv_sec - l_run.sent.tv_sec) * 1000000000U)
+                + (uint64_t)t1.tv_nsec - (uint64_t)l_run.sent.tv_nsec;
+            ++l_run.nLatDone;
+            sem_post(&l_run.ack);
+            status_ = Q_HANDLED();
+            break;
+        }
+        case DONE_SIG: {
+            endLatency();
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/*..........................................................................*/
+int_t main(void) {
+    uint_fast8_t p;
+
+    l_scale  = envOr("BENCH_SCALE", 1U);
+    l_repeat = envOr("BENCH_REPEAT", 3U);
+    Q_REQUIRE((l_scale > 0U) && (l_repeat > 0U));
+    l_run.nEvt = 1000000U * l_scale;
+    l_run.nLat = 10000U * l_scale;
+
+    for (p = 0U; p < Q_DIM(l_ao); ++p) {
+        QActive_ctor(&l_ao[p].super, Q_STATE_CAST(&BenchAO_initial));
+    }
+    QF_init(Q_DIM(QF_active)); /* initialize the QF-nano framework */
+    for (p = 1U; p <= QF_maxActive_; ++p) { /* as set later by QF_run() */
+        QF_ROM_ACTIVE_GET_(p)->prio = p;
+    }
+
+    benchTran();
+    benchTick();
+    fflush(stdout);
+
+    return QF_run(); /* post+dispatch and latency benchmarks */
+}
+
+/*--------------------------------------------------------------------------*/
+void QF_onStartup(void) {
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+}
+/*..........................................................................*/
+void QF_onClockTickISR(void) {
+#if (QF_TIMEEVT_CTR_SIZE != 0)
+    QF_tickXISR(0U); /* no timers are armed while QF_run() executes */
+#endif
+}
+/*..........................................................................*/
+void Q_onAssert(char_t const Q_ROM * const file, int_t line) {
+    fprintf(stderr, "Assertion failed in %s, line %d\n", file, (int)line);
+    exit(-1);
+}
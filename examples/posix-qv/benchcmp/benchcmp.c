@@ -0,0 +1,380 @@
+/*****************************************************************************
+* Product: BENCHCMP -- performance regression gate for the QP-nano benchmarks
+* Last Updated for Version: 6.0.4
+* Date of the Last Update:  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* http://www.state-machine.com
+* mailto:info@state-machine.com
+*****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/* Compares two sets of results of the examples/posix-qv/bench program in
+* the JSON Lines format. Each set contains several runs, so every metric
+* has several samples. The metrics are matched by all the non-measurement
+* fields of a record (such as "bench", "case", "aos", "param_size").
+*
+* A metric regresses when the 95% confidence interval of the difference of
+* the means (Welch) excludes zero in the bad direction AND the relative
+* change of the means exceeds the threshold.
+*/
+
+#define MAX_KEY      256U
+#define MAX_SAMPLES  64U
+
+/* measured fields and their direction */
+static struct {
+    char const *name;
+    bool higherIsWorse;
+    bool gated;         /* can fail the gate */
+} const l_metrics[] = {
+    { "ns",        true,  true  },
+    { "evt_per_s", false, true  },
+    { "min_ns",    true,  false },
+    { "p50_ns",    true,  true  },
+    { "p99_ns",    true,  true  },
+    { "max_ns",    true,  false }  /* single outliers, reported only */
+};
+#define N_METRICS (sizeof(l_metrics) / sizeof(l_metrics[0]))
+
+typedef struct {
+    char key[MAX_KEY];
+    uint32_t n[N_METRICS];
+    double x[N_METRICS][MAX_SAMPLES];
+} Series;
+
+typedef struct {
+    Series *s;
+    uint32_t len;
+    uint32_t cap;
+} SeriesSet;
+
+/*..........................................................................*/
+static void usage(void) {
+    fprintf(stderr,
+        "usage: benchcmp [-t percent] [-v] baseline.jsonl current.jsonl\n"
+        "Compares the results of several runs of the QP-nano benchmarks\n"
+        "and fails (exit status 1) when any metric regressed.\n"
+        "  -t percent  allowed slowdown (default 5)\n"
+        "  -v          report all metrics, not only the changed ones\n");
+}
+/*..........................................................................*/
+static int metricIndex(char const *name, size_t len) {
+    uint32_t i;
+    for (i = 0U; i < N_METRICS; ++i) {
+        if ((strlen(l_metrics[i].name) == len)
+            && (strncmp(l_metrics[i].name, name, len) == 0))
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+/*..........................................................................*/
+static Series *findSeries(SeriesSet * const set, char const *key) {
+    uint32_t i;
+    for (i = 0U; i < set->len; ++i) {
+        if (strcmp(set->s[i].key, key) == 0) {
+            return &set->s[i];
+        }
+    }
+    if (set->len == set->cap) {
+        set->cap = (set->cap == 0U) ? 64U : (2U * set->cap);
+        set->s = (Series *)realloc(set->s, set->cap * sizeof(Series));
+        if (set->s == (Series *)0) {
+            fprintf(stderr, "benchcmp: out of memory\n");
+            exit(2);
+        }
+    }
+    memset(&set->s[set->len], 0, sizeof(Series));
+    snprintf(set->s[set->len].key, MAX_KEY, "%s", key);
+    return &set->s[set->len++];
+}
+/*..........................................................................*/
+/* parses one flat JSON object {"name":value,...} produced by the bench */
+static bool parseLine(SeriesSet * const set, char const *line) {
+    char key[MAX_KEY];
+    double val[N_METRICS];
+    bool has[N_METRICS];
+    size_t klen = 0U;
+    char const *p = strchr(line, '{');
+    uint32_t i;
+
+    if (p == (char const *)0) {
+        return false;
+    }
+    memset(has, 0, sizeof(has));
+    key[0] = '\0';
+    ++p;
+    while ((*p != '}') && (*p != '\0')) {
+        char const *name;
+        size_t nlen;
+        char const *v;
+        size_t vlen;
+        int m;
+
+        while ((*p == ' ') || (*p == ',')) {
+            ++p;
+        }
+        if (*p != '"') {
+            return false;
+        }
+        name = ++p;
+        while ((*p != '"') && (*p != '\0')) {
+            ++p;
+        }
+        nlen = (size_t)(p - name);
+        if ((*p != '"') || (p[1] != ':')) {
+            return false;
+        }
+        p += 2;
+        v = p;
+        if (*p == '"') { /* string value */
+            ++p;
+            while ((*p != '"') && (*p != '\0')) {
+                ++p;
+            }
+            if (*p == '"') {
+                ++p;
+            }
+        }
+        else {
+            while ((*p != ',') && (*p != '}') && (*p != '\0')) {
+                ++p;
+            }
+        }
+        vlen = (size_t)(p - v);
+
+        m = metricIndex(name, nlen);
+        if (m >= 0) {
+            val[m] = strtod(v, (char **)0);
+            has[m] = true;
+        }
+        else if ((nlen != 1U) || (name[0] != 'n')) { /* part of the key */
+            int const w = snprintf(&key[klen], MAX_KEY - klen, "%s%.*s=%.*s",
+                                   (klen != 0U) ? " " : "",
+                                   (int)nlen, name, (int)vlen, v);
+            if ((w < 0) || ((size_t)w >= (MAX_KEY - klen))) {
+                return false;
+            }
+            klen += (size_t)w;
+        }
+        else {
+            /* the number of samples in a run is not part of the key */
+        }
+    }
+    if (*p != '}') {
+        return false;
+    }
+    {
+        Series * const s = findSeries(set, key);
+        for (i = 0U; i < N_METRICS; ++i) {
+            if (has[i] && (s->n[i] < MAX_SAMPLES)) {
+                s->x[i][s->n[i]] = val[i];
+                ++s->n[i];
+            }
+        }
+    }
+    return true;
+}
+/*..........................................................................*/
+static bool readSet(char const *fileName, SeriesSet * const set) {
+    char line[1024];
+    uint32_t lineNo = 0U;
+    FILE *f = fopen(fileName, "r");
+    if (f == (FILE *)0) {
+        perror(fileName);
+        return false;
+    }
+    while (fgets(line, (int)sizeof(line), f) != (char *)0) {
+        ++lineNo;
+        if ((line[0] != '\n') && (!parseLine(set, line))) {
+            fprintf(stderr, "%s:%u: not a benchmark record\n",
+                    fileName, (unsigned)lineNo);
+            fclose(f);
+            return false;
+        }
+    }
+    fclose(f);
+    return true;
+}
+/*..........................................................................*/
+static void meanVar(double const *x, uint32_t const n,
+                    double * const mean, double * const var)
+{
+    double sum = 0.0;
+    double sq = 0.0;
+    uint32_t i;
+    for (i = 0U; i < n; ++i) {
+        sum += x[i];
+    }
+    *mean = sum / (double)n;
+    for (i = 0U; i < n; ++i) {
+        sq += (x[i] - *mean) * (x[i] - *mean);
+    }
+    *var = (n > 1U) ? (sq / (double)(n - 1U)) : 0.0;
+}
+/*..........................................................................*/
+/* two-sided 97.5% quantile of Student's t distribution */
+static double tQuantile(double const df) {
+    static double const t[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+        2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+        2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+        2.048, 2.045, 2.042
+    };
+    uint32_t const i = (df < 1.0) ? 0U : (uint32_t)df - 1U;
+    return (i < (sizeof(t) / sizeof(t[0]))) ? t[i] : 1.960;
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    SeriesSet base = { (Series *)0, 0U, 0U };
+    SeriesSet cur  = { (Series *)0, 0U, 0U };
+    char const *files[2] = { (char const *)0, (char const *)0 };
+    double threshold = 5.0; /* [%] */
+    bool verbose = false;
+    uint32_t nFiles = 0U;
+    uint32_t nRegress = 0U;
+    uint32_t nCompared = 0U;
+    uint32_t i;
+    int a;
+
+    for (a = 1; a < argc; ++a) {
+        if ((strcmp(argv[a], "-t") == 0) && ((a + 1) < argc)) {
+            threshold = atof(argv[++a]);
+        }
+        else if (strcmp(argv[a], "-v") == 0) {
+            verbose = true;
+        }
+        else if ((argv[a][0] != '-') && (nFiles < 2U)) {
+            files[nFiles++] = argv[a];
+        }
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if ((nFiles != 2U) || (threshold < 0.0)) {
+        usage();
+        return 2;
+    }
+    if ((!readSet(files[0], &base)) || (!readSet(files[1], &cur))) {
+        return 2;
+    }
+
+    printf("%-58s %-9s %12s %12s %18s\n", "benchmark", "metric",
+           "baseline", "current", "slowdown [95% CI]");
+    for (i = 0U; i < base.len; ++i) {
+        Series const * const b = &base.s[i];
+        Series const *c = (Series const *)0;
+        uint32_t j;
+        uint32_t m;
+
+        for (j = 0U; j < cur.len; ++j) {
+            if (strcmp(cur.s[j].key, b->key) == 0) {
+                c = &cur.s[j];
+                break;
+            }
+        }
+        if (c == (Series const *)0) {
+            printf("%-58s missing in %s\n", b->key, files[1]);
+            continue;
+        }
+        for (m = 0U; m < N_METRICS; ++m) {
+            double mb;
+            double vb;
+            double mc;
+            double vc;
+            double se2;
+            double df;
+            double ci;
+            double diff;
+            double change;
+            bool worse;
+            bool significant;
+            bool regress;
+
+            if ((b->n[m] == 0U) || (c->n[m] == 0U)) {
+                continue;
+            }
+            meanVar(b->x[m], b->n[m], &mb, &vb);
+            meanVar(c->x[m], c->n[m], &mc, &vc);
+            if (mb == 0.0) {
+                continue;
+            }
+
+            /* Welch's confidence interval of the difference of the means */
+            se2 = (vb / (double)b->n[m]) + (vc / (double)c->n[m]);
+            if ((se2 > 0.0) && (b->n[m] > 1U) && (c->n[m] > 1U)) {
+                double const qb = vb / (double)b->n[m];
+                double const qc = vc / (double)c->n[m];
+                df = (se2 * se2)
+                     / (((qb * qb) / (double)(b->n[m] - 1U))
+                        + ((qc * qc) / (double)(c->n[m] - 1U)));
+            }
+            else {
+                df = 1.0; /* widest interval for too few samples */
+            }
+            ci = tQuantile(df) * sqrt(se2);
+            diff = mc - mb;
+            if (!l_metrics[m].higherIsWorse) {
+                diff = -diff; /* positive difference is always worse */
+            }
+            change = 100.0 * diff / mb; /* relative slowdown [%] */
+            worse = (diff > 0.0);
+            significant = ((diff - ci) > 0.0) || ((diff + ci) < 0.0);
+            regress = l_metrics[m].gated && worse && significant
+                      && (change > threshold);
+
+            ++nCompared;
+            if (regress) {
+                ++nRegress;
+            }
+            if (verbose || regress
+                || (significant && (fabs(change) > threshold)))
+            {
+                printf("%-58s %-9s %12.2f %12.2f %+7.1f%% [%+.1f,%+.1f] %s\n",
+                       b->key, l_metrics[m].name, mb, mc, change,
+                       100.0 * (diff - ci) / mb, 100.0 * (diff + ci) / mb,
+                       regress ? "REGRESSION"
+                               : ((significant && !worse) ? "improved"
+                                                          : ""));
+            }
+        }
+    }
+    printf("\nbenchcmp: %u metrics compared, %u regressed beyond %.1f%%\n",
+           (unsigned)nCompared, (unsigned)nRegress, threshold);
+    free(base.s);
+    free(cur.s);
+    return (nRegress == 0U) ? 0 : 1;
+}
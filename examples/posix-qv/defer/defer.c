@@ -0,0 +1,205 @@
+/*****************************************************************************
+* Product: "Deferred Event" state pattern example
+* Last Updated for Version: 5.4.2
+* Date of the Last Update:  2015-06-07
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. state-machine.com.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* Web  : http://www.state-machine.com
+* Email: info@state-machine.com
+*****************************************************************************/
+#include "qpn.h"     /* QP-nano API */
+#include "bsp.h"     /* Board Support Package */
+#include "defer.h"   /* Application interface */
+
+#include <stdio.h>   /* this example uses printf() to report status */
+
+/*..........................................................................*/
+typedef struct TServerTag { /* Transaction Server active object */
+    QActive super;          /* inherit QActive */
+
+    /* the deferred requests are stored by QF-nano in the deferral buffer
+    * of this AO, see QF_active[] in main.c
+    */
+} TServer;
+
+/* hierarchical state machine ... */
+static QState TServer_initial    (TServer * const me);
+static QState TServer_operational(TServer * const me);
+static QState TServer_idle       (TServer * const me);
+static QState TServer_receiving  (TServer * const me);
+static QState TServer_authorizing(TServer * const me);
+static QState TServer_final      (TServer * const me);
+
+/* helper functions */
+void TServer_deferRequest(TServer * const me);
+void TServer_recallRequest(TServer * const me);
+
+/* Global objects ----------------------------------------------------------*/
+TServer AO_TServer; /* the single instance of the TServer active object */
+
+/*..........................................................................*/
+void TServer_ctor(void) {
+    QActive_ctor((QActive *)&AO_TServer, Q_STATE_CAST(&TServer_initial));
+}
+/* HSM definition ----------------------------------------------------------*/
+QState TServer_initial(TServer * const me) {
+    (void)me; /* unused parameter */
+    return Q_TRAN(&TServer_operational);
+}
+/*..........................................................................*/
+QState TServer_final(TServer * const me) {
+    QState status;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: {
+            QF_stop(); /* terminate the application */
+            status = Q_HANDLED();
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+/*..........................................................................*/
+QState TServer_operational(TServer * const me) {
+    QState status;
+    switch (Q_SIG(me)) {
+        case Q_INIT_SIG: {
+            status = Q_TRAN(&TServer_idle);
+            break;
+        }
+        case NEW_REQUEST_SIG: {
+            TServer_deferRequest(me); /* defer the request */
+            status = Q_HANDLED();
+            break;
+        }
+        case TERMINATE_SIG: {
+            status = Q_TRAN(&TServer_final);
+            break;
+        }
+        default: {
+            status = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status;
+}
+/*..........................................................................*/
+QState TServer_idle(TServer * const me) {
+    QState status;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: {
+            printf("-> idle\n");
+            TServer_recallRequest(me); /* recall the request */
+            status = Q_HANDLED();
+            break;
+        }
+        case NEW_REQUEST_SIG: {
+            printf("Processing request #%d\n", (int)Q_PAR(me));
+            status = Q_TRAN(&TServer_receiving);
+            break;
+        }
+        default: {
+            status = Q_SUPER(&TServer_operational);
+            break;
+        }
+    }
+    return status;
+}
+/*..........................................................................*/
+QState TServer_receiving(TServer * const me) {
+    QState status;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: {
+            printf("-> receiving\n");
+
+            /* one-shot timeout in 1 second */
+            QActive_armX(&me->super, 0U, BSP_TICKS_PER_SEC, 0U);
+            status = Q_HANDLED();
+            break;
+        }
+        case Q_TIMEOUT_SIG: {
+            status = Q_TRAN(&TServer_authorizing);
+            break;
+        }
+        default: {
+            status = Q_SUPER(&TServer_operational);
+            break;
+        }
+    }
+    return status;
+}
+/*..........................................................................*/
+QState TServer_authorizing(TServer * const me) {
+    QState status;
+    switch (Q_SIG(me)) {
+        case Q_ENTRY_SIG: {
+            printf("-> authorizing\n");
+            /* one-shot timeout in 2 seconds */
+            QActive_armX(&me->super, 0U, 2U*BSP_TICKS_PER_SEC, 0U);
+            status = Q_HANDLED();
+            break;
+        }
+        case Q_TIMEOUT_SIG: {
+            status = Q_TRAN(&TServer_idle);
+            break;
+        }
+        default: {
+            status = Q_SUPER(&TServer_operational);
+            break;
+        }
+    }
+    return status;
+}
+
+/* helper functions ........................................................*/
+void TServer_deferRequest(TServer * const me) {
+    if (QActive_defer(&me->super)) { /* could the request be deferred? */
+        printf("deferring request #%d (%d deferred)\n", (int)Q_PAR(me),
+               (int)QActive_getDeferred(&me->super));
+    }
+    else {
+        printf("!!! cannot defer request #%d\n", (int)Q_PAR(me));
+    }
+}
+void TServer_recallRequest(TServer * const me) {
+    if (QActive_getDeferred(&me->super) == 0U) {
+        printf("No requests to recall\n");
+    }
+    /* the recalled request goes to the front of the queue (LIFO), so it
+    * is processed next, before any requests posted in the meantime
+    */
+    else if (QActive_recall(&me->super)) {
+        printf("recalling a request (%d still deferred)\n",
+               (int)QActive_getDeferred(&me->super));
+    }
+    else {
+        printf("!!! cannot recall a request, the queue is full\n");
+    }
+}
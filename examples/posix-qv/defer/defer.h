@@ -0,0 +1,40 @@
+/*****************************************************************************
+* Product: Deferred Event state pattern example
+* Last Updated for Version: 4.0.00
+* Date of the Last Update:  Apr 05, 2008
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) 2002-2008 Quantum Leaps, LLC. All rights reserved.
+*
+* This software may be distributed and modified under the terms of the GNU
+* General Public License version 2 (GPL) as published by the Free Software
+* Foundation and appearing in the file GPL.TXT included in the packaging of
+* this file. Please note that GPL Section 2[b] requires that all works based
+* on this software must also be made publicly available under the terms of
+* the GPL ("Copyleft").
+*
+* Alternatively, this software may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GPL and are specifically designed for licensees interested in
+* retaining the proprietary status of their code.
+*
+* Contact information:
+* Quantum Leaps Web site:  http://www.quantum-leaps.com
+* e-mail:                  info@quantum-leaps.com
+*****************************************************************************/
+#ifndef defer_h
+#define defer_h
+
+enum TServerSignals {
+    TERMINATE_SIG = Q_USER_SIG,                /* terminate the application */
+    NEW_REQUEST_SIG                     /* new request to the server signal */
+};
+/* active objects ..........................................................*/
+extern struct TServerTag AO_TServer;
+
+void TServer_ctor(void);
+
+#endif                                                           /* defer_h */
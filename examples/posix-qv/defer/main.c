@@ -0,0 +1,58 @@
+/*****************************************************************************
+* Product: QP-nano "Deferred Event" state pattern example
+* Last updated for version 5.8.0
+* Last updated on  2016-11-06
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* http://www.state-machine.com
+* mailto:info@state-machine.com
+*****************************************************************************/
+#include "qpn.h"     /* QP-nano API */
+#include "bsp.h"     /* Board Support Package */
+#include "defer.h"   /* Application interface */
+
+/* Local-scope objects -----------------------------------------------------*/
+static QEvt l_serverQueue[2];
+static QEvt l_serverDefer[3]; /* deferral buffer for the TServer AO */
+
+/* QF_active[] array defines all active object control blocks --------------*/
+QActiveCB const Q_ROM QF_active[] = {
+    { (QActive *)0,           (QEvt *)0,     0U,
+      (QEvt *)0,     0U                   },
+    { (QActive *)&AO_TServer, l_serverQueue, Q_DIM(l_serverQueue),
+      l_serverDefer, Q_DIM(l_serverDefer) }
+};
+
+/*..........................................................................*/
+int main (void) {
+    TServer_ctor();
+
+    QF_init(Q_DIM(QF_active)); /* initialize the QF-nano framework */
+    BSP_init();      /* initialize the Board Support Package */
+
+    return QF_run();   /* transfer control to QF-nano */
+}
@@ -0,0 +1,42 @@
+/*****************************************************************************
+* Product: QP-nano configuration for the "Deferred Event" example
+* Last Updated for Version: 5.6.2
+* Date of the Last Update:  2016-04-05
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* http://www.state-machine.com
+* mailto:info@state-machine.com
+*****************************************************************************/
+#ifndef qpn_conf_h
+#define qpn_conf_h
+
+#define Q_PARAM_SIZE            4
+#define QF_TIMEEVT_CTR_SIZE     2
+#define QF_TIMEEVT_PERIODIC
+#define QF_DEFER
+
+#endif  /* qpn_conf_h */
@@ -34,6 +34,7 @@
 #include "qpn.h"
 #include "dpp.h"
 #include "bsp.h"
+#include "mc.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -42,20 +43,70 @@
 #include <termios.h>
 #include <unistd.h>
 
+#ifndef QF_VIRTUAL_TIME
 Q_DEFINE_THIS_FILE
+#endif /* QF_VIRTUAL_TIME */
 
 /* local variables ---------------------------------------------------------*/
+#ifndef QF_VIRTUAL_TIME
 static struct termios l_tsav; /* structure with saved terminal attributes */
+#endif /* QF_VIRTUAL_TIME */
 static uint32_t l_rnd; /* random seed */
 
 /*..........................................................................*/
 void BSP_init(void) {
+#ifdef QF_VIRTUAL_TIME
+    MC_onInit(); /* seed this simulated instance */
+#else
     printf("Dining Philosopher Problem example\n"
            "QP-nano %s\n"
            "Press 'p' to pause\n"
            "Press 's' to serve\n"
            "Press ESC to quit...\n",
            QP_getVersion());
+
+#ifdef Q_SPY
+    {
+        /* trace output file or pipe, e.g.: QS_OUT=dpp.qs spy/dpp */
+        char_t const *out = getenv("QS_OUT");
+        Q_ALLEGE(QF_setTraceOutput((out != (char_t *)0) ? out : "dpp.qs"));
+    }
+#endif /* Q_SPY */
+
+#ifdef QF_TELEMETRY /* CONF=mon */
+    /* live telemetry for the monitor, e.g.: qmonn /dpp */
+    if (!QF_setTelemetry("/dpp")) {
+        printf("Telemetry /dpp not available (another instance running?)\n");
+    }
+#endif /* QF_TELEMETRY */
+
+#ifdef QF_REPLAY /* CONF=mon */
+    {
+        /* record the run for a later replay, e.g.: QF_RECORD=dpp.rr mon/dpp */
+        char_t const *rec = getenv("QF_RECORD");
+        if (rec != (char_t *)0) {
+            Q_ALLEGE(QF_setRecording(rec));
+        }
+    }
+#endif /* QF_REPLAY */
+
+#ifdef Q_SPY
+    {
+        uint_fast8_t n;
+        for (n = 0U; n < N_PHILO; ++n) {
+            QS_OBJ_ARR_DICTIONARY(AO_Philo, n);
+        }
+    }
+#endif /* Q_SPY */
+    QS_OBJ_DICTIONARY(&AO_Table);
+
+    QS_SIG_DICTIONARY(EAT_SIG,       (void *)0);
+    QS_SIG_DICTIONARY(DONE_SIG,      (void *)0);
+    QS_SIG_DICTIONARY(PAUSE_SIG,     (void *)0);
+    QS_SIG_DICTIONARY(SERVE_SIG,     (void *)0);
+    QS_SIG_DICTIONARY(TERMINATE_SIG, (void *)0);
+    QS_SIG_DICTIONARY(HUNGRY_SIG,    (void *)0);
+#endif /* QF_VIRTUAL_TIME */
 }
 /*..........................................................................*/
 void BSP_terminate(int16_t result) {
@@ -64,11 +115,19 @@ void BSP_terminate(int16_t result) {
 }
 /*..........................................................................*/
 void BSP_displayPhilStat(uint8_t n, char_t const *stat) {
+#ifdef QF_VIRTUAL_TIME
+    MC_onPhilStat(n, stat);
+#else
     printf("Philosopher %2d is %s\n", (int)n, stat);
+#endif /* QF_VIRTUAL_TIME */
 }
 /*..........................................................................*/
 void BSP_displayPaused(uint8_t paused) {
+#ifdef QF_VIRTUAL_TIME
+    MC_onPaused(paused);
+#else
     printf("Paused is %s\n", paused ? "ON" : "OFF");
+#endif /* QF_VIRTUAL_TIME */
 }
 /*..........................................................................*/
 uint32_t BSP_random(void) { /* a very cheap pseudo-random-number generator */
@@ -90,23 +149,58 @@ void Q_onAssert(char_t const Q_ROM * const file, int_t line) {
 
 /*--------------------------------------------------------------------------*/
 void QF_onStartup(void) {
+#ifndef QF_VIRTUAL_TIME
     struct termios tio; /* modified terminal attributes */
 
     tcgetattr(0, &l_tsav); /* save the current terminal attributes */
     tcgetattr(0, &tio);    /* obtain the current terminal attributes */
     tio.c_lflag &= ~(ICANON | ECHO); /* disable the canonical mode & echo */
     tcsetattr(0, TCSANOW, &tio);  /* set the new attributes */
+#endif /* QF_VIRTUAL_TIME */
 
     QF_setTickRate(BSP_TICKS_PER_SEC);
 }
 /*..........................................................................*/
 void QF_onCleanup(void) {
+#ifdef QF_VIRTUAL_TIME
+    MC_onCleanup(); /* send the result of this instance to the runner */
+#else
     /* restore the saved terminal attributes */
     tcsetattr(0, TCSANOW, &l_tsav);
+    QF_reportQueueUsage(); /* report the measured queue usage */
     printf("\nBye! Bye!\n");
+#endif /* QF_VIRTUAL_TIME */
+}
+/*..........................................................................*/
+#ifdef QF_URGENT_QUEUE
+void QF_onQueueUsage(uint_fast8_t const prio, QEQueueIdx const qlen,
+                     QEQueueIdx const nMax, QEQueueIdx const uqlen,
+                     QEQueueIdx const uMax)
+#else
+void QF_onQueueUsage(uint_fast8_t const prio, QEQueueIdx const qlen,
+                     QEQueueIdx const nMax)
+#endif /* QF_URGENT_QUEUE */
+{
+#ifdef QF_VIRTUAL_TIME
+    (void)qlen;
+    MC_onQueueUsage(prio, nMax);
+#else
+    printf("AO prio=%d queue: length=%d, max used=%d\n",
+           (int)prio, (int)qlen, (int)nMax);
+#endif /* QF_VIRTUAL_TIME */
+#ifdef QF_URGENT_QUEUE
+    if (uqlen != (QEQueueIdx)0) { /* any urgent ring buffer? */
+        printf("AO prio=%d urgent: length=%d, max used=%d\n",
+               (int)prio, (int)uqlen, (int)uMax);
+    }
+#endif /* QF_URGENT_QUEUE */
 }
 /*..........................................................................*/
 void QF_onClockTickISR(void) {
+#ifdef QF_VIRTUAL_TIME
+    QF_tickXISR(0U); /* perform the QF-nano clock tick processing */
+    MC_onClockTick(); /* random inputs instead of the keyboard */
+#else
     struct timeval timeout = { 0U, 0U }; /* timeout for select() */
     fd_set con; /* FD set representing the console */
 
@@ -128,6 +222,7 @@ void QF_onClockTickISR(void) {
             QACTIVE_POST_ISR((QActive *)&AO_Table, SERVE_SIG, 0U);
         }
     }
+#endif /* QF_VIRTUAL_TIME */
 }
 
 
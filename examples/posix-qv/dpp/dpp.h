@@ -29,18 +29,15 @@ enum DPPSignals {
 };
 
 /* number of philosophers */
-#define N_PHILO ((uint8_t)5)
-#define PHILO_0_PRIO 1
+#define N_PHILO 5 /* integer literal for QF_ACTIVE_ARRAY() */
 
-extern struct Philo AO_Philo0;
+/* the Philo class is complete here for the array of Philo AOs */
+typedef struct Philo {
+/* protected: */
+    QActive super;
+} Philo;
 
-extern struct Philo AO_Philo1;
-
-extern struct Philo AO_Philo2;
-
-extern struct Philo AO_Philo3;
-
-extern struct Philo AO_Philo4;
+extern Philo AO_Philo[N_PHILO];
 
 extern struct Table AO_Table;
 
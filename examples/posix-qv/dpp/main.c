@@ -31,9 +31,12 @@
 * http://www.state-machine.com
 * mailto:info@state-machine.com
 *****************************************************************************/
+#include <stdlib.h> /* for getenv() */
+
 #include "qpn.h"  /* QP-nano */
 #include "bsp.h"  /* Board Support Package */
 #include "dpp.h"  /* Application interface */
+#include "mc.h"   /* Monte-Carlo runner */
 
 /*..........................................................................*/
 static QEvt l_philoQueue[N_PHILO][N_PHILO];
@@ -42,21 +45,35 @@ static QEvt l_tableQueue[2];
 /* QF_active[] array defines all active object control blocks --------------*/
 QActiveCB const Q_ROM QF_active[] = {
     { (QActive *)0,           (QEvt *)0,        0U                      },
-    { (QActive *)&AO_Philo0,  l_philoQueue[0],  Q_DIM(l_philoQueue[0])  },
-    { (QActive *)&AO_Philo1,  l_philoQueue[1],  Q_DIM(l_philoQueue[1])  },
-    { (QActive *)&AO_Philo2,  l_philoQueue[2],  Q_DIM(l_philoQueue[2])  },
-    { (QActive *)&AO_Philo3,  l_philoQueue[3],  Q_DIM(l_philoQueue[3])  },
-    { (QActive *)&AO_Philo4,  l_philoQueue[4],  Q_DIM(l_philoQueue[4])  },
+    QF_ACTIVE_ARRAY(N_PHILO, AO_Philo, l_philoQueue), /* Philo AOs */
     { (QActive *)&AO_Table,   l_tableQueue,     Q_DIM(l_tableQueue)     }
 };
 
 /*..........................................................................*/
 int_t main() {
+#ifdef QF_VIRTUAL_TIME
+    /* many simulated instances, e.g.: MC_RUNS=10000 sim/dpp */
+    if (!MC_spawn()) {  /* all instances done? */
+        return MC_report();
+    }
+    /* this process runs one simulated instance... */
+#endif /* QF_VIRTUAL_TIME */
+
     Philo_ctor();    /* instantiate all Philo AOs */
     Table_ctor();    /* instantiate the Table AO */
 
     QF_init(Q_DIM(QF_active)); /* initialize the QF-nano framework */
     BSP_init();      /* initialize the Board Support Package */
 
+#ifdef QF_REPLAY
+    {
+        /* replay a recorded run, e.g.: QF_REPLAY=dpp.rr mon/dpp */
+        char_t const *log = getenv("QF_REPLAY");
+        if (log != (char_t *)0) {
+            return QF_replay(log);
+        }
+    }
+#endif /* QF_REPLAY */
+
     return QF_run(); /* transfer control to QF-nano */
 }
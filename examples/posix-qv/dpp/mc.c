@@ -0,0 +1,348 @@
+/*****************************************************************************
+* Product: DPP example, Monte-Carlo runner of simulated instances
+* Last Updated for Version: 6.0.4
+* Date of the Last Update:  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. state-machine.com.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* Web  : http://www.state-machine.com
+* Email: info@state-machine.com
+*****************************************************************************/
+#include "qpn.h"
+#include "dpp.h"
+#include "bsp.h"
+#include "mc.h"
+
+#ifdef QF_VIRTUAL_TIME
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h> /* for memset() */
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+Q_DEFINE_THIS_FILE
+
+/* result of one simulated instance, sent to the runner through a pipe */
+typedef struct {
+    uint32_t seed;
+    uint32_t meals[N_PHILO];   /* # meals of each Philo */
+    uint32_t maxHungry;        /* longest wait of a Philo for forks [ticks] */
+    uint32_t nPauses;          /* # times the Table was paused */
+    uint8_t  queueMax[N_PHILO + 1U]; /* peak queue usage, index prio-1 */
+} MCResult;
+
+/* an instance running in a child process */
+typedef struct {
+    pid_t    pid;  /* 0 for a free slot */
+    int      fd;   /* read end of the result pipe */
+    uint32_t seed;
+} MCSlot;
+
+/* local variables of an instance ------------------------------------------*/
+static MCResult l_res;
+static int      l_fd;          /* write end of the result pipe */
+static uint64_t l_simEnd;      /* end of the simulation [ticks] */
+static uint64_t l_nextInject;  /* time of the next injected event [ticks] */
+static uint64_t l_hungrySince[N_PHILO];
+static uint32_t l_injectRnd;   /* random generator of the injected events */
+static uint8_t  l_paused;
+
+/* local variables of the runner -------------------------------------------*/
+static uint32_t l_nRuns;
+static uint32_t l_nJobs;
+static uint32_t l_seed0;
+static uint32_t l_seconds;
+static uint32_t l_nDone;
+static uint32_t l_nFailed;
+static uint32_t l_mealsMin;
+static uint32_t l_mealsMax;
+static uint64_t l_mealsSum;
+static uint32_t l_worstHungry;
+static uint32_t l_worstSeed;
+static uint8_t  l_queueMax[N_PHILO + 1U];
+static FILE    *l_csv;
+static struct timespec l_t0;
+
+/*..........................................................................*/
+static uint32_t envOr(char_t const *name, uint32_t const def) {
+    char_t const *val = getenv(name);
+    return (val != (char_t *)0) ? (uint32_t)strtoul(val, (char **)0, 0)
+                                : def;
+}
+/*..........................................................................*/
+static uint32_t injectRandom(void) { /* xorshift32 */
+    l_injectRnd ^= l_injectRnd << 13;
+    l_injectRnd ^= l_injectRnd >> 17;
+    l_injectRnd ^= l_injectRnd << 5;
+    return l_injectRnd;
+}
+/*..........................................................................*/
+static void collect(MCSlot const * const slot, int const status) {
+    MCResult r;
+    ssize_t n = read(slot->fd, &r, sizeof(r));
+
+    ++l_nDone;
+    if ((!WIFEXITED(status)) || (WEXITSTATUS(status) != 0)
+        || (n != (ssize_t)sizeof(r)))
+    {
+        ++l_nFailed;
+        if (WIFSIGNALED(status)) {
+            fprintf(stderr, "\nMC: seed %u killed by signal %d\n",
+                    (unsigned)slot->seed, WTERMSIG(status));
+        }
+        else {
+            fprintf(stderr, "\nMC: seed %u failed with exit status %d\n",
+                    (unsigned)slot->seed,
+                    WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        }
+        if (l_csv != (FILE *)0) {
+            fprintf(l_csv, "%u,failed,,,,,,,\n", (unsigned)slot->seed);
+        }
+    }
+    else {
+        uint32_t meals = 0U;
+        uint8_t p;
+        for (p = 0U; p < N_PHILO; ++p) {
+            meals += r.meals[p];
+        }
+        if ((l_nDone - l_nFailed) == 1U) { /* first successful instance? */
+            l_mealsMin = meals;
+            l_mealsMax = meals;
+        }
+        else {
+            if (meals < l_mealsMin) {
+                l_mealsMin = meals;
+            }
+            if (meals > l_mealsMax) {
+                l_mealsMax = meals;
+            }
+        }
+        l_mealsSum += meals;
+        if (r.maxHungry > l_worstHungry) {
+            l_worstHungry = r.maxHungry;
+            l_worstSeed   = r.seed;
+        }
+        for (p = 0U; p <= N_PHILO; ++p) {
+            if (r.queueMax[p] > l_queueMax[p]) {
+                l_queueMax[p] = r.queueMax[p];
+            }
+        }
+        if (l_csv != (FILE *)0) {
+            fprintf(l_csv, "%u,ok,%u,%u,%u,%u,%u,%u,%u\n",
+                    (unsigned)r.seed,
+                    (unsigned)r.meals[0], (unsigned)r.meals[1],
+                    (unsigned)r.meals[2], (unsigned)r.meals[3],
+                    (unsigned)r.meals[4],
+                    (unsigned)r.maxHungry, (unsigned)r.nPauses);
+        }
+    }
+    if ((l_nDone % 100U) == 0U) {
+        fprintf(stderr, "\rMC: %u/%u instances done", (unsigned)l_nDone,
+                (unsigned)l_nRuns);
+    }
+}
+/*..........................................................................*/
+/**
+* Runs MC_RUNS instances of DPP in child processes, at most MC_JOBS at a
+* time, and collects their results. Returns true in each child process,
+* which then continues with one simulated instance, and false in the
+* runner after all instances have finished.
+*/
+bool MC_spawn(void) {
+    MCSlot *slots;
+    uint32_t next = 0U;
+    uint32_t nActive = 0U;
+    long nCpu = sysconf(_SC_NPROCESSORS_ONLN);
+    char_t const *csv = getenv("MC_CSV");
+
+    l_nRuns   = envOr("MC_RUNS", 1000U);
+    l_nJobs   = envOr("MC_JOBS", (nCpu > 0) ? (uint32_t)nCpu : 1U);
+    l_seed0   = envOr("MC_SEED", 1U);
+    l_seconds = envOr("MC_SECONDS", 3600U);
+    Q_REQUIRE(l_nJobs > 0U);
+
+    if (csv != (char_t *)0) {
+        l_csv = fopen(csv, "w");
+        Q_ASSERT(l_csv != (FILE *)0);
+        fprintf(l_csv, "seed,status,meals0,meals1,meals2,meals3,meals4,"
+                "max_hungry_ticks,pauses\n");
+    }
+    slots = (MCSlot *)calloc(l_nJobs, sizeof(MCSlot));
+    Q_ASSERT(slots != (MCSlot *)0);
+
+    clock_gettime(CLOCK_MONOTONIC, &l_t0);
+    while ((next < l_nRuns) || (nActive > 0U)) {
+        int status;
+        pid_t pid;
+        uint32_t j;
+
+        /* keep all the jobs busy... */
+        for (j = 0U; (j < l_nJobs) && (next < l_nRuns); ++j) {
+            if (slots[j].pid == (pid_t)0) {
+                int fds[2];
+                Q_ALLEGE(pipe(fds) == 0);
+                fflush((FILE *)0); /* don't duplicate the buffered output */
+                pid = fork();
+                Q_ASSERT(pid >= (pid_t)0);
+                if (pid == (pid_t)0) { /* the child process? */
+                    uint32_t k;
+                    for (k = 0U; k < l_nJobs; ++k) { /* not ours to read */
+                        if (slots[k].pid != (pid_t)0) {
+                            close(slots[k].fd);
+                        }
+                    }
+                    free(slots);
+                    if (l_csv != (FILE *)0) {
+                        fclose(l_csv);
+                    }
+                    close(fds[0]);
+                    l_fd = fds[1];
+                    memset(&l_res, 0, sizeof(l_res));
+                    l_res.seed = l_seed0 + next;
+                    return true; /* run one instance */
+                }
+                close(fds[1]);
+                slots[j].pid  = pid;
+                slots[j].fd   = fds[0];
+                slots[j].seed = l_seed0 + next;
+                ++next;
+                ++nActive;
+            }
+        }
+
+        /* ...and wait for any of them to finish */
+        pid = wait(&status);
+        Q_ASSERT(pid > (pid_t)0);
+        for (j = 0U; j < l_nJobs; ++j) {
+            if (slots[j].pid == pid) {
+                collect(&slots[j], status);
+                close(slots[j].fd);
+                slots[j].pid = (pid_t)0;
+                --nActive;
+                break;
+            }
+        }
+    }
+    free(slots);
+    return false;
+}
+/*..........................................................................*/
+int_t MC_report(void) {
+    struct timespec t1;
+    uint32_t const nOk = l_nDone - l_nFailed;
+    uint8_t p;
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (l_csv != (FILE *)0) {
+        fclose(l_csv);
+    }
+    printf("\nMC: %u instances of %u simulated s (seeds %u..%u), "
+           "%u failed, %.2f s wall\n",
+           (unsigned)l_nDone, (unsigned)l_seconds, (unsigned)l_seed0,
+           (unsigned)(l_seed0 + l_nRuns - 1U), (unsigned)l_nFailed,
+           (double)(t1.tv_sec - l_t0.tv_sec)
+               + ((double)(t1.tv_nsec - l_t0.tv_nsec) * 1e-9));
+    if (nOk > 0U) {
+        printf("MC: meals per instance: min %u, avg %.1f, max %u\n",
+               (unsigned)l_mealsMin, (double)l_mealsSum / (double)nOk,
+               (unsigned)l_mealsMax);
+        printf("MC: longest wait for forks: %.2f s (seed %u)\n",
+               (double)l_worstHungry / (double)BSP_TICKS_PER_SEC,
+               (unsigned)l_worstSeed);
+        printf("MC: peak queue usage:");
+        for (p = 0U; p <= N_PHILO; ++p) {
+            printf(" prio%u=%u", (unsigned)(p + 1U), (unsigned)l_queueMax[p]);
+        }
+        printf("\n");
+    }
+    if (l_nFailed > 0U) {
+        printf("MC: rerun a failed seed with MC_SEED=<seed> MC_RUNS=1\n");
+    }
+    return (l_nFailed == 0U) ? 0 : 1;
+}
+
+/* hooks of a simulated instance -------------------------------------------*/
+void MC_onInit(void) {
+    BSP_randomSeed((l_res.seed << 1) | 1U); /* LCG needs an odd seed */
+    l_injectRnd = (l_res.seed * 2654435761U) | 1U;
+    l_simEnd = (uint64_t)l_seconds * BSP_TICKS_PER_SEC;
+    l_nextInject = (uint64_t)(injectRandom() % (20U * BSP_TICKS_PER_SEC));
+}
+/*..........................................................................*/
+void MC_onClockTick(void) {
+    uint64_t const now = QF_getVirtualTicks();
+    if (now >= l_simEnd) {
+        QF_stop(); /* end of this instance */
+    }
+    else if (now >= l_nextInject) { /* toggle the Table at random times */
+        QACTIVE_POST_ISR((QActive *)&AO_Table,
+                         (l_paused != 0U) ? SERVE_SIG : PAUSE_SIG, 0U);
+        l_nextInject = now + 1U
+                       + (uint64_t)(injectRandom() % (20U * BSP_TICKS_PER_SEC));
+    }
+    else {
+        /* nothing to inject */
+    }
+}
+/*..........................................................................*/
+void MC_onPhilStat(uint8_t n, char_t const *stat) {
+    uint64_t const now = QF_getVirtualTicks();
+    if (stat[0] == 'h') { /* hungry? */
+        l_hungrySince[n] = now;
+    }
+    else if (stat[0] == 'e') { /* eating? */
+        uint64_t const wait = now - l_hungrySince[n];
+        ++l_res.meals[n];
+        if (wait > (uint64_t)l_res.maxHungry) {
+            l_res.maxHungry = (uint32_t)wait;
+        }
+    }
+    else {
+        /* thinking */
+    }
+}
+/*..........................................................................*/
+void MC_onPaused(uint8_t paused) {
+    l_paused = paused;
+    if (paused != 0U) {
+        ++l_res.nPauses;
+    }
+}
+/*..........................................................................*/
+void MC_onQueueUsage(uint_fast8_t const prio, uint_fast8_t const nMax) {
+    l_res.queueMax[prio - 1U] = (uint8_t)nMax;
+}
+/*..........................................................................*/
+void MC_onCleanup(void) {
+    QF_reportQueueUsage(); /* collect the queue usage */
+    Q_ALLEGE(write(l_fd, &l_res, sizeof(l_res)) == (ssize_t)sizeof(l_res));
+    close(l_fd);
+}
+
+#endif /* QF_VIRTUAL_TIME */
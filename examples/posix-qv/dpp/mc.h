@@ -0,0 +1,49 @@
+/*****************************************************************************
+* Product: DPP example, Monte-Carlo runner of simulated instances
+* Last Updated for Version: 6.0.4
+* Date of the Last Update:  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. state-machine.com.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* Web  : http://www.state-machine.com
+* Email: info@state-machine.com
+*****************************************************************************/
+#ifndef mc_h
+#define mc_h
+
+/* Monte-Carlo runner (virtual-time configuration only) */
+bool MC_spawn(void);  /* true in an instance, false when all are done */
+int_t MC_report(void); /* summary of all instances, returns exit status */
+
+/* hooks for the BSP of a simulated instance */
+void MC_onInit(void);
+void MC_onClockTick(void);
+void MC_onPhilStat(uint8_t n, char_t const *stat);
+void MC_onPaused(uint8_t paused);
+void MC_onQueueUsage(uint_fast8_t const prio, uint_fast8_t const nMax);
+void MC_onCleanup(void);
+
+#endif /* mc_h */
@@ -21,19 +21,12 @@
 
 Q_DEFINE_THIS_MODULE("philo")
 
-/* Active object class -----------------------------------------------------*/
+/* Active object class (the Philo struct is declared in dpp.h) ------------*/
 
 #if ((QP_VERSION < 580) || (QP_VERSION != ((QP_RELEASE^4294967295) % 0x3E8)))
 #error qpn version 5.8.0 or higher required
 #endif
 
-/*${AOs::Philo} ............................................................*/
-typedef struct Philo {
-/* protected: */
-    QActive super;
-} Philo;
-
-/* protected: */
 static QState Philo_initial(Philo * const me);
 static QState Philo_thinking(Philo * const me);
 static QState Philo_hungry(Philo * const me);
@@ -41,20 +34,8 @@ static QState Philo_eating(Philo * const me);
 
 
 /* Global objects ----------------------------------------------------------*/
-/*${AOs::AO_Philo0} ........................................................*/
-struct Philo AO_Philo0;
-
-/*${AOs::AO_Philo1} ........................................................*/
-struct Philo AO_Philo1;
-
-/*${AOs::AO_Philo2} ........................................................*/
-struct Philo AO_Philo2;
-
-/*${AOs::AO_Philo3} ........................................................*/
-struct Philo AO_Philo3;
-
-/*${AOs::AO_Philo4} ........................................................*/
-struct Philo AO_Philo4;
+/*${AOs::AO_Philo[N_PHILO]} ................................................*/
+Philo AO_Philo[N_PHILO];
 
 
 /* Local objects -----------------------------------------------------------*/
@@ -66,17 +47,24 @@ struct Philo AO_Philo4;
 /* Philo definition --------------------------------------------------------*/
 /*${AOs::Philo_ctor} .......................................................*/
 void Philo_ctor(void) {
-    QActive_ctor(&AO_Philo0.super, Q_STATE_CAST(&Philo_initial));
-    QActive_ctor(&AO_Philo1.super, Q_STATE_CAST(&Philo_initial));
-    QActive_ctor(&AO_Philo2.super, Q_STATE_CAST(&Philo_initial));
-    QActive_ctor(&AO_Philo3.super, Q_STATE_CAST(&Philo_initial));
-    QActive_ctor(&AO_Philo4.super, Q_STATE_CAST(&Philo_initial));
+    uint8_t n;
+    for (n = 0U; n < N_PHILO; ++n) {
+        QActive_ctor(&AO_Philo[n].super, Q_STATE_CAST(&Philo_initial));
+    }
     BSP_randomSeed(123U);
 }
 /*${AOs::Philo} ............................................................*/
 /*${AOs::Philo::SM} ........................................................*/
 static QState Philo_initial(Philo * const me) {
     /* ${AOs::Philo::SM::initial} */
+    static uint8_t registered = 0U; /* starts off with 0, per C-standard */
+    if (registered == 0U) {
+        registered = 1U;
+        QS_FUN_DICTIONARY(&Philo_initial);
+        QS_FUN_DICTIONARY(&Philo_thinking);
+        QS_FUN_DICTIONARY(&Philo_hungry);
+        QS_FUN_DICTIONARY(&Philo_eating);
+    }
     return Q_TRAN(&Philo_thinking);
 }
 /*${AOs::Philo::SM::thinking} ..............................................*/
@@ -120,7 +108,7 @@ static QState Philo_hungry(Philo * const me) {
     switch (Q_SIG(me)) {
         /* ${AOs::Philo::SM::hungry} */
         case Q_ENTRY_SIG: {
-            QACTIVE_POST(&AO_Table, HUNGRY_SIG, me->super.prio);
+            QACTIVE_POST(&AO_Table, HUNGRY_SIG, QACTIVE_INDEX(me, AO_Philo));
             status_ = Q_HANDLED();
             break;
         }
@@ -155,7 +143,7 @@ static QState Philo_eating(Philo * const me) {
         /* ${AOs::Philo::SM::eating} */
         case Q_EXIT_SIG: {
             QActive_disarmX(&me->super, 0U);
-            QACTIVE_POST(QF_ACTIVE_CAST(&AO_Table), DONE_SIG, me->super.prio);
+            QACTIVE_POST(&AO_Table, DONE_SIG, QACTIVE_INDEX(me, AO_Philo));
             status_ = Q_HANDLED();
             break;
         }
@@ -38,5 +38,6 @@
 #define QF_MAX_TICK_RATE        1
 #define QF_TIMEEVT_CTR_SIZE     2
 #define QF_TIMEEVT_PERIODIC
+#define QF_EQUEUE_USAGE
 
 #endif  /* qpn_conf_h */
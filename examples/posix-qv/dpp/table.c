@@ -71,6 +71,12 @@ void Table_ctor(void) {
 static QState Table_initial(Table * const me) {
     /* ${AOs::Table::SM::initial} */
     uint8_t n;
+
+    QS_FUN_DICTIONARY(&Table_initial);
+    QS_FUN_DICTIONARY(&Table_active);
+    QS_FUN_DICTIONARY(&Table_serving);
+    QS_FUN_DICTIONARY(&Table_paused);
+
     for (n = 0U; n < N_PHILO; ++n) {
         me->fork[n] = FREE;
         me->isHungry[n] = 0U;
@@ -113,12 +119,9 @@ static QState Table_serving(Table * const me) {
                     && (me->fork[LEFT(n)] == FREE)
                     && (me->fork[n] == FREE))
                 {
-                    QActive *philo;
-
                     me->fork[LEFT(n)] = USED;
                     me->fork[n] = USED;
-                    philo = QF_ACTIVE_CAST(Q_ROM_PTR(QF_active[PHILO_0_PRIO + n].act));
-                    QACTIVE_POST(philo, EAT_SIG, n);
+                    QACTIVE_POST(&AO_Philo[n], EAT_SIG, n);
                     me->isHungry[n] = 0U;
                     BSP_displayPhilStat(n, "eating  ");
                 }
@@ -129,9 +132,8 @@ static QState Table_serving(Table * const me) {
         /* ${AOs::Table::SM::active::serving::HUNGRY} */
         case HUNGRY_SIG: {
             uint8_t n, m;
-            QActive *philo;
 
-            n = (uint8_t)(Q_PAR(me) - PHILO_0_PRIO);
+            n = (uint8_t)Q_PAR(me);
             /* phil ID must be in range and he must be not hungry */
             Q_ASSERT((n < N_PHILO) && (me->isHungry[n] == 0U));
 
@@ -141,8 +143,7 @@ static QState Table_serving(Table * const me) {
             if ((me->fork[m] == FREE) && (me->fork[n] == FREE)) {
                 me->fork[m] = USED;
                 me->fork[n] = USED;
-                philo = QF_ACTIVE_CAST(Q_ROM_PTR(QF_active[PHILO_0_PRIO + n].act));
-                QACTIVE_POST(philo, EAT_SIG, n);
+                QACTIVE_POST(&AO_Philo[n], EAT_SIG, n);
                 BSP_displayPhilStat(n, "eating  ");
                 status_ = Q_HANDLED();
             }
@@ -156,9 +157,8 @@ static QState Table_serving(Table * const me) {
         /* ${AOs::Table::SM::active::serving::DONE} */
         case DONE_SIG: {
             uint8_t n, m;
-            QActive *philo;
 
-            n = (uint8_t)(Q_PAR(me) - PHILO_0_PRIO);
+            n = (uint8_t)Q_PAR(me);
             /* phil ID must be in range and he must be not hungry */
             Q_ASSERT((n < N_PHILO) && (me->isHungry[n] == 0U));
 
@@ -175,8 +175,7 @@ static QState Table_serving(Table * const me) {
                 me->fork[n] = USED;
                 me->fork[m] = USED;
                 me->isHungry[m] = 0U;
-                philo = QF_ACTIVE_CAST(Q_ROM_PTR(QF_active[PHILO_0_PRIO + m].act));
-                QACTIVE_POST(philo, EAT_SIG, m);
+                QACTIVE_POST(&AO_Philo[m], EAT_SIG, m);
                 BSP_displayPhilStat(m, "eating  ");
             }
             m = LEFT(n); /* check the left neighbor */
@@ -185,8 +184,7 @@ static QState Table_serving(Table * const me) {
                 me->fork[m] = USED;
                 me->fork[n] = USED;
                 me->isHungry[m] = 0U;
-                philo = QF_ACTIVE_CAST(Q_ROM_PTR(QF_active[PHILO_0_PRIO + m].act));
-                QACTIVE_POST(philo, EAT_SIG, m);
+                QACTIVE_POST(&AO_Philo[m], EAT_SIG, m);
                 BSP_displayPhilStat(m, "eating  ");
             }
             status_ = Q_HANDLED();
@@ -233,7 +231,7 @@ static QState Table_paused(Table * const me) {
         }
         /* ${AOs::Table::SM::active::paused::HUNGRY} */
         case HUNGRY_SIG: {
-            uint8_t n = (uint8_t)(Q_PAR(me) - PHILO_0_PRIO);
+            uint8_t n = (uint8_t)Q_PAR(me);
             /* philo ID must be in range and he must be not hungry */
             Q_ASSERT((n < N_PHILO) && (me->isHungry[n] == 0U));
             me->isHungry[n] = 1U;
@@ -245,7 +243,7 @@ static QState Table_paused(Table * const me) {
         case DONE_SIG: {
             uint8_t n, m;
 
-            n = (uint8_t)(Q_PAR(me) - PHILO_0_PRIO);
+            n = (uint8_t)Q_PAR(me);
             /* phil ID must be in range and he must be not hungry */
             Q_ASSERT((n < N_PHILO) && (me->isHungry[n] == 0U));
 
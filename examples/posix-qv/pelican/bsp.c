@@ -47,6 +47,16 @@ Q_DEFINE_THIS_MODULE("bsp")
 /* Local-scope objects -----------------------------------------------------*/
 static struct termios l_tsav; /* structure with saved terminal attributes */
 
+#ifdef QF_VIRTUAL_TIME
+/* simulated scenario: a pedestrian arrives every PED_PERIOD ticks */
+#define PED_PERIOD   ((uint64_t)BSP_TICKS_PER_SEC * 60U)
+
+static uint64_t l_simEnd;  /* end of the simulation [ticks] */
+static uint64_t l_nextPed; /* arrival of the next pedestrian [ticks] */
+static uint32_t l_nPeds;   /* # pedestrians arrived so far */
+static bool     l_ending;  /* TERMINATE already posted */
+#endif /* QF_VIRTUAL_TIME */
+
 /*..........................................................................*/
 void BSP_init(void) {
     printf("Pedestrian LIght CONtrolled crossing example"
@@ -102,29 +112,67 @@ void BSP_signalPeds(enum BSP_PedsSignal sig) {
 
 /*--------------------------------------------------------------------------*/
 void QF_onStartup(void) {
+#ifndef QF_VIRTUAL_TIME
     struct termios tio; /* modified terminal attributes */
 
     tcgetattr(0, &l_tsav); /* save the current terminal attributes */
     tcgetattr(0, &tio); /* obtain the current terminal attributes */
     tio.c_lflag &= ~(ICANON | ECHO); /* disable the canonical mode & echo */
     tcsetattr(0, TCSANOW, &tio);     /* set the new attributes */
+#else
+    /* simulated duration in hours, e.g.: PELICAN_HOURS=168 sim/pelican */
+    char_t const *hours = getenv("PELICAN_HOURS");
+    l_simEnd = (uint64_t)((hours != (char_t *)0) ? atoi(hours) : 24)
+               * 3600U * BSP_TICKS_PER_SEC;
+    l_nextPed = PED_PERIOD;
+    (void)l_tsav;
+#endif /* QF_VIRTUAL_TIME */
 
     QF_setTickRate(BSP_TICKS_PER_SEC);
 }
 /*..........................................................................*/
 void QF_onCleanup(void) {
+#ifndef QF_VIRTUAL_TIME
     printf("\nBye! Bye!\n");
 
     /* restore the saved terminal attributes */
     tcsetattr(0, TCSANOW, &l_tsav);
+#else
+    printf("\nSimulated %llu s, %u pedestrians\n",
+           (unsigned long long)(QF_getVirtualTicks() / BSP_TICKS_PER_SEC),
+           (unsigned)l_nPeds);
+#endif /* QF_VIRTUAL_TIME */
 }
 /*..........................................................................*/
 void QF_onClockTickISR(void) {
+#ifndef QF_VIRTUAL_TIME
     struct timeval timeout = { 0U, 0U }; /* timeout for select() */
     fd_set con; /* FD set representing the console */
+#else
+    uint64_t now;
+#endif /* QF_VIRTUAL_TIME */
 
     QF_tickXISR(0U); /* perform the QF clock tick processing */
 
+#ifdef QF_VIRTUAL_TIME
+    /* the scripted inputs replace the keyboard in the simulation */
+    now = QF_getVirtualTicks();
+    if (now >= l_simEnd) {
+        if (!l_ending) {
+            l_ending = true;
+            QACTIVE_POST_ISR((QActive *)&AO_Pelican, TERMINATE_SIG, 0U);
+        }
+    }
+    else if (now >= l_nextPed) {
+        printf("-----> PEDS_WAITING\n");
+        QACTIVE_POST_ISR((QActive *)&AO_Pelican, PEDS_WAITING_SIG, 0U);
+        l_nextPed = now + PED_PERIOD;
+        ++l_nPeds;
+    }
+    else {
+        /* nothing happens */
+    }
+#else
     FD_ZERO(&con);
     FD_SET(0, &con);
     /* check if a console input is available, returns immediately */
@@ -155,6 +203,7 @@ void QF_onClockTickISR(void) {
                 break;
         }
     }
+#endif /* QF_VIRTUAL_TIME */
 }
 /*--------------------------------------------------------------------------*/
 void Q_onAssert(char const Q_ROM * const file, int line) {
@@ -0,0 +1,131 @@
+/*****************************************************************************
+* Product: QHsmTst example, POSIX
+* Last Updated for Version: 6.0.4
+* Date of the Last Update:  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. state-machine.com.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* Web  : http://www.state-machine.com
+* Email: info@state-machine.com
+*****************************************************************************/
+#include "qpn.h"
+#include "bsp.h"
+#include "qhsmtst.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+Q_DEFINE_THIS_FILE
+
+/* The output of the HSM is collected in memory rather than written to a
+* file, so that main() can compare it with the golden log, and so that
+* the timed dispatching can discard it (BSP_mute()) without any I/O.
+*/
+static struct {
+    char buf[4096];  /* the output collected so far (zero-terminated) */
+    uint_fast16_t len;
+    bool mute;
+} l_out;
+
+/*..........................................................................*/
+static void append(char const *str) {
+    uint_fast16_t n = (uint_fast16_t)strlen(str);
+    Q_ASSERT(l_out.len + n < sizeof(l_out.buf));
+    memcpy(&l_out.buf[l_out.len], str, n + 1U); /* with the terminator */
+    l_out.len += n;
+}
+
+/*..........................................................................*/
+void BSP_init(void) {
+    char hdr[64];
+    l_out.len  = 0U;
+    l_out.mute = false;
+    l_out.buf[0] = '\0';
+    snprintf(hdr, sizeof(hdr), "QHsmTst example, QP-nano %s\n",
+             QP_VERSION_STR);
+    append(hdr);
+
+    QHSM_INIT(the_hsm); /* the top-most initial tran. */
+}
+/*..........................................................................*/
+void BSP_exit(void) {
+    printf("\nBye! Bye!\n");
+    fflush(stdout);
+    _exit(0);
+}
+/*..........................................................................*/
+void BSP_display(char const *msg) {
+    if (!l_out.mute) {
+        append(msg);
+    }
+}
+/*..........................................................................*/
+void BSP_dispatch(QSignal sig) {
+    Q_REQUIRE((A_SIG <= sig) && (sig <= I_SIG));
+    if (!l_out.mute) {
+        char tag[4];
+        tag[0] = '\n';
+        tag[1] = (char)('A' + sig - A_SIG);
+        tag[2] = ':';
+        tag[3] = '\0';
+        append(tag);
+    }
+    Q_SIG(the_hsm) = sig;
+    QHSM_DISPATCH(the_hsm); /* dispatch the event */
+}
+/*..........................................................................*/
+void BSP_mute(bool mute) {
+    l_out.mute = mute;
+}
+/*..........................................................................*/
+char const *BSP_output(void) {
+    return l_out.buf;
+}
+
+/*--------------------------------------------------------------------------*/
+void QF_onStartup(void) {
+}
+/*..........................................................................*/
+void QF_onCleanup(void) {
+    /* NOTE:
+    * This application does not call QF_run(), so it cannot be terminated
+    * with the QF_stop() call. Instead, this example uses BSP_exit() to
+    * terminate.
+    */
+}
+/*..........................................................................*/
+void QF_onClockTickISR(void) {
+}
+
+/*..........................................................................*/
+/* this function is used by the QP embedded systems-friendly assertions */
+void Q_onAssert(char const * const file, int line) {
+    fprintf(stderr, "Assertion failed in %s, line %d\n", file, line);
+    fflush(stderr);
+    _exit(-1);
+}
@@ -0,0 +1,255 @@
+/*****************************************************************************
+* Product: QHsmTst example, POSIX
+* Last Updated for Version: 6.0.4
+* Date of the Last Update:  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. state-machine.com.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* Web  : http://www.state-machine.com
+* Email: info@state-machine.com
+*****************************************************************************/
+#include "qpn.h"
+#include "bsp.h"
+#include "qhsmtst.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+Q_DEFINE_THIS_FILE
+
+/* This POSIX version of the QHsmTst example runs in two phases:
+*
+* 1. conformance: dispatches the scripted events (the batch script of the
+*    Win32 version) and compares the output of the HSM with the golden log
+*    (log.txt by default). The first line of the log (the banner with the
+*    QP-nano version) and the CR characters are not compared.
+*
+* 2. performance: times the dispatching of every scripted event from the
+*    configuration in which the script dispatched it. Before every event
+*    the conformance phase saves a copy of the complete QHsmTst object
+*    (QHsmTst_size bytes, including the extended state and the history),
+*    so the timed loop restores the object, dispatches the event, and the
+*    cost of the restoring (timed separately) is subtracted. The results
+*    are printed in JSON Lines format:
+*
+*    {"bench":"qhsmtst","step":3,"sig":"D","n":1000000,"ns":42.1}
+*
+* usage: qhsmtst [-c] [-n reps] [-o output] [golden]
+*   -c         conformance check only
+*   -n reps    # dispatches of every event (default 1000000)
+*   -o output  save the output of the HSM to the given file
+*/
+
+static QSignal const l_script[] = {
+    A_SIG, B_SIG, D_SIG, E_SIG, I_SIG, F_SIG, I_SIG, I_SIG, F_SIG, A_SIG,
+    B_SIG, D_SIG, D_SIG, E_SIG, G_SIG, H_SIG, H_SIG, C_SIG, G_SIG, C_SIG,
+    C_SIG
+};
+
+#define MAX_HSM_SIZE 64U
+
+/* copies of the QHsmTst object before every step and after the last one */
+static uint8_t l_snap[Q_DIM(l_script) + 1U][MAX_HSM_SIZE];
+
+/*..........................................................................*/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+/*..........................................................................*/
+/* skips the first line and returns the rest without the CR characters */
+static char *normalize(char const *str) {
+    char *res = malloc(strlen(str) + 1U);
+    char *dst = res;
+    Q_ASSERT(res != (char *)0);
+    str = strchr(str, '\n');
+    if (str != (char const *)0) {
+        for (++str; *str != '\0'; ++str) {
+            if (*str != '\r') {
+                *dst++ = *str;
+            }
+        }
+    }
+    *dst = '\0';
+    return res;
+}
+/*..........................................................................*/
+static char *readFile(char const *fname) {
+    FILE *f = fopen(fname, "rb");
+    char *res;
+    long len;
+
+    if (f == (FILE *)0) {
+        return (char *)0;
+    }
+    fseek(f, 0L, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0L, SEEK_SET);
+    res = malloc((size_t)len + 1U);
+    Q_ASSERT(res != (char *)0);
+    len = (long)fread(res, 1U, (size_t)len, f);
+    res[len] = '\0';
+    fclose(f);
+    return res;
+}
+/*..........................................................................*/
+/* compares the output with the golden log, returns true if they match */
+static bool checkOutput(char const *golden, char const *out) {
+    char *exp = normalize(golden);
+    char *act = normalize(out);
+    bool ok = (strcmp(exp, act) == 0);
+
+    if (!ok) {
+        char const *e = exp;
+        char const *a = act;
+        uint_fast16_t line = 2U; /* the first line is not compared */
+        while ((*e == *a) && (*e != '\0')) {
+            if (*e == '\n') {
+                ++line;
+            }
+            ++e;
+            ++a;
+        }
+        /* back to the beginning of the differing line */
+        while ((e > exp) && (e[-1] != '\n')) {
+            --e;
+            --a;
+        }
+        fprintf(stderr, "output differs from the golden log at line %u\n"
+                "expected: %.*s\nactual:   %.*s\n", (unsigned)line,
+                (int)strcspn(e, "\n"), e, (int)strcspn(a, "\n"), a);
+    }
+    free(exp);
+    free(act);
+    return ok;
+}
+/*..........................................................................*/
+static double timeStep(uint_fast8_t const step, uint32_t const reps) {
+    uint8_t const *snap = &l_snap[step][0];
+    double t0;
+    double t1;
+    double t2;
+    uint32_t i;
+
+    t0 = now();
+    for (i = 0U; i < reps; ++i) {
+        memcpy(the_hsm, snap, QHsmTst_size);
+        Q_SIG(the_hsm) = l_script[step];
+        QHSM_DISPATCH(the_hsm);
+    }
+    t1 = now();
+    /* the next configuration must be the same as in the scripted run */
+    Q_ENSURE(memcmp(the_hsm, &l_snap[step + 1U][0], QHsmTst_size) == 0);
+
+    for (i = 0U; i < reps; ++i) { /* the cost of restoring the object */
+        memcpy(the_hsm, snap, QHsmTst_size);
+        Q_SIG(the_hsm) = l_script[step];
+        __asm__ volatile ("" : : : "memory"); /* don't optimize the copy */
+    }
+    t2 = now();
+
+    return (((t1 - t0) - (t2 - t1)) * 1e9) / (double)reps;
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    char const *golden = "log.txt";
+    char const *output = (char const *)0;
+    bool checkOnly = false;
+    uint32_t reps = 1000000U;
+    char *exp;
+    uint_fast8_t k;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if ((strcmp(argv[i], "-n") == 0) && ((i + 1) < argc)) {
+            reps = (uint32_t)strtoul(argv[++i], (char **)0, 0);
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && ((i + 1) < argc)) {
+            output = argv[++i];
+        }
+        else if (strcmp(argv[i], "-c") == 0) {
+            checkOnly = true;
+        }
+        else if (argv[i][0] != '-') {
+            golden = argv[i];
+        }
+        else {
+            fprintf(stderr,
+                    "usage: qhsmtst [-c] [-n reps] [-o output] [golden]\n");
+            return EXIT_FAILURE;
+        }
+    }
+    Q_REQUIRE((QHsmTst_size <= MAX_HSM_SIZE) && (reps > 0U));
+
+    /* conformance phase... */
+    QHsmTst_ctor(); /* instantiate the QHsmTst object */
+    BSP_init();     /* the top-most initial transition */
+    for (k = 0U; k < Q_DIM(l_script); ++k) {
+        memcpy(&l_snap[k][0], the_hsm, QHsmTst_size);
+        BSP_dispatch(l_script[k]);
+    }
+    memcpy(&l_snap[k][0], the_hsm, QHsmTst_size);
+
+    if (output != (char const *)0) {
+        FILE *f = fopen(output, "w");
+        if (f == (FILE *)0) {
+            perror(output);
+            return EXIT_FAILURE;
+        }
+        fputs(BSP_output(), f);
+        fclose(f);
+    }
+    exp = readFile(golden);
+    if (exp == (char *)0) {
+        perror(golden);
+        return EXIT_FAILURE;
+    }
+    if (!checkOutput(exp, BSP_output())) {
+        free(exp);
+        return EXIT_FAILURE;
+    }
+    free(exp);
+    fprintf(stderr, "QHsmTst: %u steps match %s\n",
+            (unsigned)Q_DIM(l_script), golden);
+    if (checkOnly) {
+        return EXIT_SUCCESS;
+    }
+
+    /* performance phase... */
+    BSP_mute(true);
+    for (k = 0U; k < Q_DIM(l_script); ++k) {
+        double ns = timeStep(k, reps);
+        printf("{\"bench\":\"qhsmtst\",\"step\":%u,\"sig\":\"%c\","
+               "\"n\":%u,\"ns\":%.2f}\n",
+               (unsigned)(k + 1U), (char)('A' + l_script[k] - A_SIG),
+               (unsigned)reps, ns);
+    }
+    return EXIT_SUCCESS;
+}
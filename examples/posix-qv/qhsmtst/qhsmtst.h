@@ -0,0 +1,43 @@
+/*****************************************************************************
+* Model: qhsmtst.qm
+* File:  ./qhsmtst.h
+*
+* This code has been generated by QM tool (see state-machine.com/qm).
+* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*****************************************************************************/
+/*${.::qhsmtst.h} ..........................................................*/
+#ifndef qhsmtst_h
+#define qhsmtst_h
+
+enum QHsmTstSignals {
+    A_SIG = Q_USER_SIG,
+    B_SIG,
+    C_SIG,
+    D_SIG,
+    E_SIG,
+    F_SIG,
+    G_SIG,
+    H_SIG,
+    I_SIG,
+    TERMINATE_SIG,
+    IGNORE_SIG,
+    MAX_SIG
+};
+
+extern QHsm * const the_hsm; /* opaque pointer to the test HSM */
+extern uint_fast16_t const QHsmTst_size; /* size of the test HSM object */
+
+/*${HSMs::QHsmTst_ctor} ....................................................*/
+void QHsmTst_ctor(void);
+
+
+#endif /* qhsmtst_h */
@@ -0,0 +1,224 @@
+/*****************************************************************************
+* Product: QMON-nano -- monitor of the QF-nano POSIX telemetry block
+* Last Updated for Version: 6.0.4
+* Date of the Last Update:  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* http://www.state-machine.com
+* mailto:info@state-machine.com
+*****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "qfn_telem.h" /* layout of the telemetry block */
+
+/*..........................................................................*/
+static void usage(void) {
+    fprintf(stderr,
+        "usage: qmonn [-i ms] [-n count] [-c] name\n"
+        "Monitors the telemetry block published by a QP-nano application\n"
+        "with QF_setTelemetry(name) in the POSIX port.\n"
+        "  -i ms     sampling interval in milliseconds (default 1000)\n"
+        "  -n count  stop after the given number of samples\n"
+        "  -c        print the samples as CSV, one line per active object:\n"
+        "            time,prio,depth,peak,posted,failed,dispatched,\n"
+        "            ready,ticks,tick_late_ns\n");
+}
+/*..........................................................................*/
+/* takes a consistent snapshot of the block (sequence lock reader) */
+static void snapshot(QFTelemetry const volatile * const blk,
+                     QFTelemetry * const snap)
+{
+    uint32_t seq1;
+    uint32_t seq2;
+    do {
+        seq1 = blk->seq;
+        __sync_synchronize(); /* read seq before the data */
+        memcpy(snap, (void const *)blk, sizeof(QFTelemetry));
+        __sync_synchronize(); /* read the data before seq */
+        seq2 = blk->seq;
+    } while (((seq1 & 1U) != 0U) || (seq1 != seq2));
+}
+/*..........................................................................*/
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+/*..........................................................................*/
+static void printSample(QFTelemetry const * const cur,
+                        QFTelemetry const * const prev,
+                        double const t, double const dt, bool const csv)
+{
+    unsigned p;
+    unsigned n;
+
+    if (csv) {
+        for (p = 1U; p <= cur->maxActive; ++p) {
+            QFTelemActive const * const a = &cur->active[p - 1U];
+            printf("%.6f,%u,%u,%u,%llu,%llu,%llu,%u,%llu,%llu\n",
+                   t, p, a->nUsed, a->nMax,
+                   (unsigned long long)a->nPosted,
+                   (unsigned long long)a->nPostFailed,
+                   (unsigned long long)a->nDispatched,
+                   (cur->readySet >> (p - 1U)) & 1U,
+                   (unsigned long long)cur->nTicks,
+                   (unsigned long long)cur->tickLate);
+        }
+        return;
+    }
+
+    printf("\n%.3fs pid=%u ready=0x%02X ticks=%llu (%.0f/s) "
+           "tick late=%lluus max=%lluus\n",
+           t, cur->pid, cur->readySet,
+           (unsigned long long)cur->nTicks,
+           (double)(cur->nTicks - prev->nTicks) / dt,
+           (unsigned long long)(cur->tickLate / 1000U),
+           (unsigned long long)(cur->tickLateMax / 1000U));
+    printf(" prio depth  peak   posted/s dispatch/s   failed  timers\n");
+    for (p = 1U; p <= cur->maxActive; ++p) {
+        QFTelemActive const * const a = &cur->active[p - 1U];
+        QFTelemActive const * const b = &prev->active[p - 1U];
+        printf(" %4u %5u %5u %10.0f %10.0f %8llu ",
+               p, a->nUsed, a->nMax,
+               (double)(a->nPosted - b->nPosted) / dt,
+               (double)(a->nDispatched - b->nDispatched) / dt,
+               (unsigned long long)a->nPostFailed);
+        for (n = 0U; (n < cur->maxTickRate)
+                     && (n < QF_TELEM_MAX_TICK_RATE); ++n)
+        {
+            if (a->interval[n] != 0U) {
+                printf(" %u/%u", a->nTicks[n], a->interval[n]);
+            }
+            else {
+                printf(" %u", a->nTicks[n]);
+            }
+        }
+        printf("\n");
+    }
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    char const *name = (char const *)0;
+    long interval = 1000; /* [ms] */
+    long count = -1;      /* forever */
+    bool csv = false;
+    QFTelemetry const volatile *blk;
+    QFTelemetry cur;
+    QFTelemetry prev;
+    struct timespec ts;
+    double t0;
+    double tPrev;
+    int fd;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if ((strcmp(argv[i], "-i") == 0) && ((i + 1) < argc)) {
+            interval = atol(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-n") == 0) && ((i + 1) < argc)) {
+            count = atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-c") == 0) {
+            csv = true;
+        }
+        else if ((argv[i][0] == '-') || (name != (char const *)0)) {
+            usage();
+            return EXIT_FAILURE;
+        }
+        else {
+            name = argv[i];
+        }
+    }
+    if ((name == (char const *)0) || (interval <= 0)) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        perror(name);
+        return EXIT_FAILURE;
+    }
+    /* map read-only, so the monitor cannot disturb the application */
+    blk = (QFTelemetry const volatile *)mmap((void *)0, sizeof(QFTelemetry),
+                                             PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if ((void const *)blk == MAP_FAILED) {
+        perror("mmap");
+        return EXIT_FAILURE;
+    }
+    if ((blk->magic != QF_TELEM_MAGIC) || (blk->version != QF_TELEM_VERSION)
+        || (blk->size != (uint32_t)sizeof(QFTelemetry)))
+    {
+        fprintf(stderr, "qmonn: %s is not a compatible telemetry block "
+                "(version %u, expected %u)\n", name,
+                (unsigned)blk->version, (unsigned)QF_TELEM_VERSION);
+        return EXIT_FAILURE;
+    }
+
+    if (csv) {
+        printf("time,prio,depth,peak,posted,failed,dispatched,"
+               "ready,ticks,tick_late_ns\n");
+    }
+    ts.tv_sec  = interval / 1000;
+    ts.tv_nsec = (interval % 1000) * 1000000L;
+
+    snapshot(blk, &prev);
+    t0 = now();
+    tPrev = t0;
+    while (count != 0) {
+        double t;
+        nanosleep(&ts, (struct timespec *)0);
+        snapshot(blk, &cur);
+        t = now();
+        printSample(&cur, &prev, t - t0, t - tPrev, csv);
+        fflush(stdout);
+        prev = cur;
+        tPrev = t;
+        if (count > 0) {
+            --count;
+        }
+        if ((kill((pid_t)cur.pid, 0) != 0) && (errno == ESRCH)) {
+            fprintf(stderr, "qmonn: process %u terminated\n",
+                    (unsigned)cur.pid);
+            break;
+        }
+    }
+    return EXIT_SUCCESS;
+}
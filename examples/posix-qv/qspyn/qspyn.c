@@ -0,0 +1,979 @@
+/*****************************************************************************
+* Product: QSPY-nano -- host-side decoder of the QS-nano binary trace
+* Last Updated for Version: 6.0.4
+* Date of the Last Update:  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* http://www.state-machine.com
+* mailto:info@state-machine.com
+*****************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "qsn.h"  /* QS-nano record types (Q_SPY not needed on the host) */
+
+/* configuration -----------------------------------------------------------*/
+enum {
+    MAX_PRIO  = 8,              /* maximum # active objects in QP-nano */
+    QUEUE_LEN = 0x10000,        /* > maximum depth of any event queue */
+    IN_BUF_SIZE = 4*1024*1024,  /* size of the input buffer */
+    MAX_REC_SIZE = 4096,        /* maximum size of a single trace record */
+    DICT_SIZE = 4096,           /* capacity of each dictionary (power of 2) */
+    HIST_SIZE = 976,            /* # buckets in the log-linear histogram */
+    RESERVED_SIGS = 8           /* # signals reserved by QEP-nano */
+};
+
+/* log-linear histogram of time intervals ----------------------------------*/
+typedef struct {
+    uint64_t cnt[HIST_SIZE];
+    uint64_t n;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+} Hist;
+
+/* dictionary of names keyed by two integers --------------------------------*/
+typedef struct {
+    int64_t key1;
+    int64_t key2;
+    char   *name;   /* NULL for empty slots */
+} DictEntry;
+
+typedef struct {
+    DictEntry slot[DICT_SIZE];
+    unsigned  n;
+} Dict;
+
+/* per-active object statistics ---------------------------------------------*/
+typedef struct {
+    bool     isAdded;   /* QS_QF_ACTIVE_ADD seen for this priority */
+    int64_t  obj;       /* the active object (offset as sent by QS-nano) */
+    uint64_t nPost;     /* # events posted from the task level */
+    uint64_t nPostISR;  /* # events posted from the ISR level */
+    uint64_t nPostLIFO; /* # events posted LIFO (task or ISR level) */
+    uint64_t nCoalesce; /* # posts coalesced with a waiting event */
+    uint64_t nFail;     /* # failed post attempts */
+    uint64_t nGet;      /* # events dispatched */
+    uint64_t nDefer;    /* # events deferred */
+    uint64_t nDeferFail; /* # failed attempts to defer an event */
+    uint64_t nRecall;   /* # events recalled */
+    unsigned maxDeferred; /* maximum observed # deferred events */
+    unsigned maxDepth;  /* maximum observed depth of the event queue */
+
+    uint64_t postTime[QUEUE_LEN]; /* FIFO of posting times */
+    uint32_t postSig[QUEUE_LEN];  /* signals of the queued events */
+    unsigned head;
+    unsigned tail;
+    unsigned nQueued;
+
+    bool     inRtc;     /* RTC step in progress */
+    uint64_t getTime;   /* time of the last QS_QF_ACTIVE_GET */
+
+    Hist     latency;   /* post -> dispatch */
+    Hist     rtc;       /* dispatch -> end of the RTC step */
+} AoStat;
+
+/* input cursor for decoding a single record --------------------------------*/
+typedef struct {
+    uint8_t const *p;
+    uint8_t const *end;
+    bool ok;
+} Cursor;
+
+/* local objects -----------------------------------------------------------*/
+static Dict l_objDict;
+static Dict l_funDict;
+static Dict l_sigObjDict; /* signals registered for a specific object */
+static Dict l_sigDict;    /* signals by value only (first registration) */
+
+static AoStat l_ao[MAX_PRIO + 1]; /* index 0 not used */
+
+static struct {
+    bool     isValid;
+    uint32_t version;
+    unsigned paramSize;
+    unsigned timeEvtCtrSize;
+    unsigned maxTickRate;
+    unsigned timeSize;
+    unsigned ptrSize;
+    unsigned eqCtrSize; /* size of the event queue counters */
+} l_target;
+
+static struct {
+    uint64_t nRec;
+    uint64_t nBytes;
+    uint64_t nLost;    /* # records lost (gaps in the sequence numbers) */
+    uint64_t nTicks;
+    uint64_t time;     /* current absolute time [time-stamp units] */
+    unsigned lastSeq;
+    bool     hasSeq;
+    uint64_t recCnt[QS_USER];
+} l_trace;
+
+static struct {
+    bool  timeline;
+    bool  stats;
+    unsigned prioMask; /* active objects shown in the timeline (0 == all) */
+    FILE *depthFile;   /* queue-depth curves in CSV, or NULL */
+} l_opt;
+
+static char const * const l_recName[QS_USER] = {
+    "EMPTY",    "TARGET",   "ENTRY",    "EXIT",
+    "INIT",     "INIT_TRAN","DISPATCH", "TRAN",
+    "INTERN",   "IGNORED",  "ADD",      "POST",
+    "POST_ISR", "POST_FAIL","GET",      "TICK",
+    "TIMEOUT",  "SIG_DICT", "OBJ_DICT", "FUN_DICT",
+    "DEFER",    "DEFER_FAIL","RECALL",  "POST_LIFO",
+    "COALESCE"
+};
+
+static char const * const l_reservedSig[RESERVED_SIGS] = {
+    "EMPTY_SIG",     "Q_ENTRY_SIG",    "Q_EXIT_SIG",     "Q_INIT_SIG",
+    "Q_TIMEOUT_SIG", "Q_TIMEOUT1_SIG", "Q_TIMEOUT2_SIG", "Q_TIMEOUT3_SIG"
+};
+
+/*..........................................................................*/
+static void usage(void) {
+    fprintf(stderr,
+        "usage: qspyn [-t] [-p prio]... [-q file] [-s] [file]\n"
+        "Decodes the binary QS-nano trace from the file (or the standard\n"
+        "input when the file is '-' or omitted).\n"
+        "  -t       print the decoded timeline\n"
+        "  -p prio  restrict the timeline to the active object of the given\n"
+        "           priority (can be repeated)\n"
+        "  -q file  write the queue-depth curves as CSV: time,prio,depth\n"
+        "  -s       print the statistics (default without -t and -q)\n"
+        "All times are in the time-stamp units of the target\n"
+        "(microseconds in the POSIX port).\n");
+}
+
+/* dictionaries ============================================================*/
+static char *dupStr(char const * const str) {
+    size_t const len = strlen(str) + 1U;
+    char * const dup = (char *)malloc(len);
+    if (dup == (char *)0) {
+        fprintf(stderr, "qspyn: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    return (char *)memcpy(dup, str, len);
+}
+/*..........................................................................*/
+static unsigned dictHash(int64_t const key1, int64_t const key2) {
+    uint64_t h = ((uint64_t)key1 * 0x9E3779B97F4A7C15ULL)
+                 ^ ((uint64_t)key2 * 0xC2B2AE3D27D4EB4FULL);
+    return (unsigned)(h >> 40) & (DICT_SIZE - 1U);
+}
+/*..........................................................................*/
+static char const *dictFind(Dict const * const dict,
+                            int64_t const key1, int64_t const key2)
+{
+    unsigned i = dictHash(key1, key2);
+    while (dict->slot[i].name != (char *)0) {
+        if ((dict->slot[i].key1 == key1) && (dict->slot[i].key2 == key2)) {
+            return dict->slot[i].name;
+        }
+        i = (i + 1U) & (DICT_SIZE - 1U);
+    }
+    return (char const *)0;
+}
+/*..........................................................................*/
+static void dictAdd(Dict * const dict, int64_t const key1, int64_t const key2,
+                    char const * const name, bool const replace)
+{
+    unsigned i = dictHash(key1, key2);
+    while (dict->slot[i].name != (char *)0) {
+        if ((dict->slot[i].key1 == key1) && (dict->slot[i].key2 == key2)) {
+            if (replace) {
+                free(dict->slot[i].name);
+                dict->slot[i].name = dupStr(name);
+            }
+            return;
+        }
+        i = (i + 1U) & (DICT_SIZE - 1U);
+    }
+    if (dict->n < (DICT_SIZE * 3U / 4U)) { /* keep the probing short */
+        dict->slot[i].key1 = key1;
+        dict->slot[i].key2 = key2;
+        dict->slot[i].name = dupStr(name);
+        ++dict->n;
+    }
+}
+/*..........................................................................*/
+static char const *objName(int64_t const obj) {
+    static char buf[4][32]; /* a few names can be used in one printf() */
+    static unsigned n;
+    char const *name = dictFind(&l_objDict, obj, 0);
+    if (name == (char const *)0) {
+        n = (n + 1U) & 3U;
+        snprintf(buf[n], sizeof(buf[n]), "obj%+lld", (long long)obj);
+        name = buf[n];
+    }
+    return name;
+}
+/*..........................................................................*/
+static char const *funName(int64_t const fun) {
+    static char buf[4][32];
+    static unsigned n;
+    char const *name = dictFind(&l_funDict, fun, 0);
+    if ((name == (char const *)0) && (fun == 0)) {
+        name = "QHsm_top"; /* the reference of all function offsets */
+    }
+    if (name == (char const *)0) {
+        n = (n + 1U) & 3U;
+        snprintf(buf[n], sizeof(buf[n]), "fun%+lld", (long long)fun);
+        name = buf[n];
+    }
+    return name;
+}
+/*..........................................................................*/
+static char const *sigName(uint32_t const sig, int64_t const obj) {
+    static char buf[32];
+    char const *name = dictFind(&l_sigObjDict, (int64_t)sig, obj);
+    if (name == (char const *)0) {
+        name = dictFind(&l_sigDict, (int64_t)sig, 0);
+    }
+    if (name == (char const *)0) {
+        if (sig < (uint32_t)RESERVED_SIGS) {
+            name = l_reservedSig[sig];
+        }
+        else {
+            snprintf(buf, sizeof(buf), "SIG%u", (unsigned)sig);
+            name = buf;
+        }
+    }
+    return name;
+}
+/*..........................................................................*/
+static char const *aoName(unsigned const prio) {
+    static char buf[16];
+    char const *name = (char const *)0;
+    if ((prio <= MAX_PRIO) && l_ao[prio].isAdded) {
+        name = dictFind(&l_objDict, l_ao[prio].obj, 0);
+    }
+    if (name == (char const *)0) {
+        snprintf(buf, sizeof(buf), "prio%u", prio);
+        name = buf;
+    }
+    return name;
+}
+/*..........................................................................*/
+static unsigned objPrio(int64_t const obj) { /* 0 if not an active object */
+    unsigned p;
+    for (p = 1U; p <= MAX_PRIO; ++p) {
+        if (l_ao[p].isAdded && (l_ao[p].obj == obj)) {
+            return p;
+        }
+    }
+    return 0U;
+}
+
+/* histograms ==============================================================*/
+static unsigned histIdx(uint64_t const v) {
+    unsigned msb;
+    if (v < 16U) {
+        return (unsigned)v;
+    }
+    msb = 63U - (unsigned)__builtin_clzll(v);
+    return ((msb - 3U) * 16U) + (unsigned)((v >> (msb - 4U)) & 15U);
+}
+/*..........................................................................*/
+static uint64_t histUpper(unsigned const idx) { /* upper bound of a bucket */
+    unsigned msb;
+    if (idx < 32U) {
+        return idx;
+    }
+    msb = (idx / 16U) + 3U;
+    return (((uint64_t)(16U + (idx % 16U)) + 1U) << (msb - 4U)) - 1U;
+}
+/*..........................................................................*/
+static void histAdd(Hist * const h, uint64_t const v) {
+    ++h->cnt[histIdx(v)];
+    if ((h->n == 0U) || (v < h->min)) {
+        h->min = v;
+    }
+    if (v > h->max) {
+        h->max = v;
+    }
+    ++h->n;
+    h->sum += v;
+}
+/*..........................................................................*/
+static uint64_t histPercentile(Hist const * const h, unsigned const pct) {
+    uint64_t const rank = ((h->n * pct) + 99U) / 100U; /* nearest rank */
+    uint64_t acc = 0U;
+    unsigned i;
+    for (i = 0U; i < HIST_SIZE; ++i) {
+        acc += h->cnt[i];
+        if (acc >= rank) {
+            uint64_t const v = histUpper(i);
+            return (v < h->max) ? v : h->max;
+        }
+    }
+    return h->max;
+}
+
+/* decoding primitives =====================================================*/
+static inline unsigned getU8(Cursor * const c) {
+    if (c->p < c->end) {
+        return *c->p++;
+    }
+    c->ok = false;
+    return 0U;
+}
+/*..........................................................................*/
+static inline uint64_t getUvar(Cursor * const c) {
+    uint64_t v = 0U;
+    unsigned shift = 0U;
+    while (c->p < c->end) {
+        uint8_t const b = *c->p++;
+        if (shift < 64U) {
+            v |= (uint64_t)(b & 0x7FU) << shift;
+        }
+        if ((b & 0x80U) == 0U) {
+            return v;
+        }
+        shift += 7U;
+    }
+    c->ok = false;
+    return 0U;
+}
+/*..........................................................................*/
+static inline unsigned getEqc(Cursor * const c) { /* event queue counter */
+    return (l_target.eqCtrSize == 2U) ? (unsigned)getUvar(c) : getU8(c);
+}
+/*..........................................................................*/
+static inline int64_t getPtr(Cursor * const c) { /* zig-zag decoding */
+    uint64_t const z = getUvar(c);
+    return (z & 1U) ? -(int64_t)(z >> 1) - 1 : (int64_t)(z >> 1);
+}
+/*..........................................................................*/
+static char const *getStr(Cursor * const c) {
+    char const *s = (char const *)c->p;
+    while (c->p < c->end) {
+        if (*c->p++ == 0U) {
+            return s;
+        }
+    }
+    c->ok = false;
+    return "";
+}
+
+/* trace analysis ==========================================================*/
+static bool isShown(unsigned const prio) {
+    return (l_opt.prioMask == 0U)
+           || ((prio <= MAX_PRIO) && ((l_opt.prioMask & (1U << prio)) != 0U));
+}
+/*..........................................................................*/
+static void depthPoint(unsigned const prio, unsigned const depth) {
+    if (l_opt.depthFile != (FILE *)0) {
+        fprintf(l_opt.depthFile, "%llu,%u,%u\n",
+                (unsigned long long)l_trace.time, prio, depth);
+    }
+}
+/*..........................................................................*/
+static void onPost(unsigned const rec, unsigned const prio,
+                   uint32_t const sig, uint64_t const par, unsigned const nUsed)
+{
+    if ((prio == 0U) || (prio > MAX_PRIO)) {
+        return;
+    }
+    AoStat * const ao = &l_ao[prio];
+    if (rec == QS_QF_ACTIVE_POST_ATTEMPT) {
+        ++ao->nFail;
+    }
+    else if (rec == QS_QF_ACTIVE_COALESCE) {
+        /* the waiting event was updated in place, the queue did not grow,
+        * and its queueing latency still counts from its original posting
+        */
+        ++ao->nCoalesce;
+    }
+    else {
+        if (rec == QS_QF_ACTIVE_POST) {
+            ++ao->nPost;
+        }
+        else if (rec == QS_QF_ACTIVE_POST_ISR) {
+            ++ao->nPostISR;
+        }
+        else {
+            ++ao->nPostLIFO;
+        }
+        if (nUsed > ao->maxDepth) {
+            ao->maxDepth = nUsed;
+        }
+        if (ao->nQueued >= QUEUE_LEN) {
+            /* too many queued events to track */
+        }
+        else if (rec == QS_QF_ACTIVE_POST_LIFO) { /* in front of the queue */
+            ao->tail = (ao->tail + QUEUE_LEN - 1U) % QUEUE_LEN;
+            ao->postTime[ao->tail] = l_trace.time;
+            ao->postSig[ao->tail] = sig;
+            ++ao->nQueued;
+        }
+        else {
+            ao->postTime[ao->head] = l_trace.time;
+            ao->postSig[ao->head] = sig;
+            ao->head = (ao->head + 1U) % QUEUE_LEN;
+            ++ao->nQueued;
+        }
+        depthPoint(prio, nUsed);
+    }
+    if (l_opt.timeline && isShown(prio)) {
+        printf("%12llu %-9s %s <- %s",
+               (unsigned long long)l_trace.time, l_recName[rec],
+               aoName(prio), sigName(sig, ao->obj));
+        if (l_target.paramSize != 0U) {
+            printf(" par=%llu", (unsigned long long)par);
+        }
+        printf(" depth=%u\n", nUsed);
+    }
+}
+/*..........................................................................*/
+static void onDefer(unsigned const rec, unsigned const prio,
+                    uint32_t const sig, uint64_t const par, unsigned const n)
+{
+    if ((prio == 0U) || (prio > MAX_PRIO)) {
+        return;
+    }
+    AoStat * const ao = &l_ao[prio];
+    if (rec == QS_QF_ACTIVE_DEFER) {
+        ++ao->nDefer;
+        if (n > ao->maxDeferred) {
+            ao->maxDeferred = n;
+        }
+    }
+    else if (rec == QS_QF_ACTIVE_DEFER_ATTEMPT) {
+        ++ao->nDeferFail;
+    }
+    else { /* QS_QF_ACTIVE_RECALL, n is the depth of the event queue */
+        ++ao->nRecall;
+        if (n > ao->maxDepth) {
+            ao->maxDepth = n;
+        }
+        /* the recalled event is inserted in front of the queue (LIFO) */
+        if (ao->nQueued < QUEUE_LEN) {
+            ao->tail = (ao->tail + QUEUE_LEN - 1U) % QUEUE_LEN;
+            ao->postTime[ao->tail] = l_trace.time;
+            ao->postSig[ao->tail] = sig;
+            ++ao->nQueued;
+        }
+        depthPoint(prio, n);
+    }
+    if (l_opt.timeline && isShown(prio)) {
+        printf("%12llu %-9s %s: %s",
+               (unsigned long long)l_trace.time, l_recName[rec],
+               aoName(prio), sigName(sig, ao->obj));
+        if (l_target.paramSize != 0U) {
+            printf(" par=%llu", (unsigned long long)par);
+        }
+        printf((rec == QS_QF_ACTIVE_RECALL) ? " depth=%u\n"
+                                            : " deferred=%u\n", n);
+    }
+}
+/*..........................................................................*/
+static void onGet(unsigned const prio, uint32_t const sig,
+                  unsigned const nUsed)
+{
+    if ((prio == 0U) || (prio > MAX_PRIO)) {
+        return;
+    }
+    AoStat * const ao = &l_ao[prio];
+    ++ao->nGet;
+
+    /* find the oldest queued posting of this signal. Usually it is at the
+    * tail, but with the urgent ring buffer (QF_URGENT_QUEUE) the urgent
+    * events overtake the normal ones. The urgency depends only on the
+    * signal, so the events of the same signal are never reordered.
+    */
+    unsigned n = 0U;
+    unsigned i = ao->tail;
+    while ((n < ao->nQueued) && (ao->postSig[i] != sig)) {
+        i = (i + 1U) % QUEUE_LEN;
+        ++n;
+    }
+    if (n < ao->nQueued) { /* the posting of this event was traced? */
+        histAdd(&ao->latency, l_trace.time - ao->postTime[i]);
+        while (i != ao->tail) { /* close the gap towards the tail */
+            unsigned const prev = (i + QUEUE_LEN - 1U) % QUEUE_LEN;
+            ao->postTime[i] = ao->postTime[prev];
+            ao->postSig[i]  = ao->postSig[prev];
+            i = prev;
+        }
+        ao->tail = (ao->tail + 1U) % QUEUE_LEN;
+        --ao->nQueued;
+    }
+    if (ao->nQueued > nUsed) { /* some traced events were lost? */
+        ao->nQueued = 0U;     /* resynchronize with the target */
+        ao->tail = ao->head;
+    }
+    ao->inRtc = true;
+    ao->getTime = l_trace.time;
+    depthPoint(prio, nUsed);
+
+    if (l_opt.timeline && isShown(prio)) {
+        printf("%12llu %-9s %s: %s depth=%u\n",
+               (unsigned long long)l_trace.time, "GET",
+               aoName(prio), sigName(sig, ao->obj), nUsed);
+    }
+}
+/*..........................................................................*/
+static void onRtcEnd(int64_t const obj) {
+    unsigned const prio = objPrio(obj);
+    if ((prio != 0U) && l_ao[prio].inRtc) {
+        histAdd(&l_ao[prio].rtc, l_trace.time - l_ao[prio].getTime);
+        l_ao[prio].inRtc = false;
+    }
+}
+/*..........................................................................*/
+static void printQep(unsigned const rec, int64_t const obj,
+                     char const * const detail)
+{
+    if (l_opt.timeline && isShown(objPrio(obj))) {
+        printf("%12llu %-9s %s: %s\n",
+               (unsigned long long)l_trace.time, l_recName[rec],
+               objName(obj), detail);
+    }
+}
+/*..........................................................................*/
+/* decodes one record, returns the # bytes consumed or 0 on incomplete data */
+static size_t decodeRecord(uint8_t const * const buf, size_t const len) {
+    Cursor c = { buf, buf + len, true };
+    unsigned rec;
+    unsigned seq;
+    char detail[256];
+    int64_t obj;
+    int64_t fun;
+    int64_t fun2;
+    unsigned prio;
+    uint32_t sig;
+    uint64_t par = 0U;
+    unsigned nUsed;
+    char const *name;
+    uint64_t const time0 = l_trace.time;
+
+    rec = getU8(&c);
+    seq = getU8(&c);
+    l_trace.time += getUvar(&c);
+    if (!c.ok) {
+        l_trace.time = time0;
+        return 0U;
+    }
+
+    switch (rec) {
+        case QS_TARGET_INFO: {
+            l_target.version        = (uint32_t)getUvar(&c);
+            l_target.paramSize      = getU8(&c);
+            l_target.timeEvtCtrSize = getU8(&c);
+            l_target.maxTickRate    = getU8(&c);
+            l_target.timeSize       = getU8(&c);
+            l_target.ptrSize        = getU8(&c);
+            l_target.eqCtrSize      = (c.p < c.end) ? getU8(&c) : 1U;
+            l_target.isValid        = true;
+            l_trace.hasSeq = false; /* the target (re)started the trace */
+            if (c.ok && l_opt.timeline) {
+                printf("%12llu %-9s QP-nano %u.%u.%u\n",
+                       (unsigned long long)l_trace.time, l_recName[rec],
+                       l_target.version / 100U,
+                       (l_target.version / 10U) % 10U,
+                       l_target.version % 10U);
+            }
+            break;
+        }
+        case QS_QEP_STATE_ENTRY:   /* intentionally fall through */
+        case QS_QEP_STATE_EXIT:
+        case QS_QEP_INIT_TRAN: {
+            obj = getPtr(&c);
+            fun = getPtr(&c);
+            if (c.ok) {
+                printQep(rec, obj, funName(fun));
+            }
+            break;
+        }
+        case QS_QEP_INTERN_TRAN:   /* intentionally fall through */
+        case QS_QEP_IGNORED: {
+            obj = getPtr(&c);
+            fun = getPtr(&c);
+            if (c.ok) {
+                printQep(rec, obj, funName(fun));
+                onRtcEnd(obj);
+            }
+            break;
+        }
+        case QS_QEP_STATE_INIT:    /* intentionally fall through */
+        case QS_QEP_TRAN: {
+            obj  = getPtr(&c);
+            fun  = getPtr(&c);
+            fun2 = getPtr(&c);
+            if (c.ok) {
+                if (l_opt.timeline) {
+                    snprintf(detail, sizeof(detail), "%s -> %s",
+                             funName(fun), funName(fun2));
+                    printQep(rec, obj, detail);
+                }
+                if (rec == QS_QEP_TRAN) {
+                    onRtcEnd(obj);
+                }
+            }
+            break;
+        }
+        case QS_QEP_DISPATCH: {
+            obj = getPtr(&c);
+            sig = (uint32_t)getUvar(&c);
+            fun = getPtr(&c);
+            if (c.ok && l_opt.timeline) {
+                snprintf(detail, sizeof(detail), "%s in %s",
+                         sigName(sig, obj), funName(fun));
+                printQep(rec, obj, detail);
+            }
+            break;
+        }
+        case QS_QF_ACTIVE_ADD: {
+            prio = getU8(&c);
+            obj  = getPtr(&c);
+            if (c.ok && (prio != 0U) && (prio <= MAX_PRIO)) {
+                l_ao[prio].isAdded = true;
+                l_ao[prio].obj = obj;
+                if (l_opt.timeline && isShown(prio)) {
+                    printf("%12llu %-9s %s prio=%u\n",
+                           (unsigned long long)l_trace.time, l_recName[rec],
+                           objName(obj), prio);
+                }
+            }
+            break;
+        }
+        case QS_QF_ACTIVE_POST:    /* intentionally fall through */
+        case QS_QF_ACTIVE_POST_ISR:
+        case QS_QF_ACTIVE_POST_LIFO:
+        case QS_QF_ACTIVE_COALESCE:
+        case QS_QF_ACTIVE_POST_ATTEMPT: {
+            if (!l_target.isValid) {
+                fprintf(stderr, "qspyn: event posted before the target "
+                        "info record, cannot decode the trace\n");
+                exit(EXIT_FAILURE);
+            }
+            prio = getU8(&c);
+            sig  = (uint32_t)getUvar(&c);
+            if (l_target.paramSize != 0U) {
+                par = getUvar(&c);
+            }
+            nUsed = getEqc(&c);
+            if (c.ok) {
+                onPost(rec, prio, sig, par, nUsed);
+            }
+            break;
+        }
+        case QS_QF_ACTIVE_DEFER:   /* intentionally fall through */
+        case QS_QF_ACTIVE_DEFER_ATTEMPT:
+        case QS_QF_ACTIVE_RECALL: {
+            if (!l_target.isValid) {
+                fprintf(stderr, "qspyn: event deferred before the target "
+                        "info record, cannot decode the trace\n");
+                exit(EXIT_FAILURE);
+            }
+            prio = getU8(&c);
+            sig  = (uint32_t)getUvar(&c);
+            if (l_target.paramSize != 0U) {
+                par = getUvar(&c);
+            }
+            nUsed = getEqc(&c);
+            if (c.ok) {
+                onDefer(rec, prio, sig, par, nUsed);
+            }
+            break;
+        }
+        case QS_QF_ACTIVE_GET: {
+            prio  = getU8(&c);
+            sig   = (uint32_t)getUvar(&c);
+            nUsed = getEqc(&c);
+            if (c.ok) {
+                onGet(prio, sig, nUsed);
+            }
+            break;
+        }
+        case QS_QF_TICK: {
+            unsigned const rate = getU8(&c);
+            if (c.ok) {
+                ++l_trace.nTicks;
+                if (l_opt.timeline && (l_opt.prioMask == 0U)) {
+                    printf("%12llu %-9s rate=%u\n",
+                           (unsigned long long)l_trace.time, l_recName[rec],
+                           rate);
+                }
+            }
+            break;
+        }
+        case QS_QF_TIMEEVT_POST: {
+            unsigned rate;
+            prio = getU8(&c);
+            rate = getU8(&c);
+            if (c.ok && l_opt.timeline && isShown(prio)) {
+                printf("%12llu %-9s %s rate=%u\n",
+                       (unsigned long long)l_trace.time, l_recName[rec],
+                       aoName(prio), rate);
+            }
+            break;
+        }
+        case QS_SIG_DICT: {
+            sig  = (uint32_t)getUvar(&c);
+            obj  = getPtr(&c);
+            name = getStr(&c);
+            if (c.ok) {
+                dictAdd(&l_sigObjDict, (int64_t)sig, obj, name, true);
+                dictAdd(&l_sigDict, (int64_t)sig, 0, name, false);
+            }
+            break;
+        }
+        case QS_OBJ_DICT: {
+            obj  = getPtr(&c);
+            name = getStr(&c);
+            if (c.ok) {
+                dictAdd(&l_objDict, obj, 0, name, true);
+            }
+            break;
+        }
+        case QS_FUN_DICT: {
+            fun  = getPtr(&c);
+            name = getStr(&c);
+            if (c.ok) {
+                dictAdd(&l_funDict, fun, 0, name, true);
+            }
+            break;
+        }
+        default: {
+            fprintf(stderr, "qspyn: unknown record type %u at byte %llu\n",
+                    rec, (unsigned long long)l_trace.nBytes);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (!c.ok) {
+        l_trace.time = time0;
+        return 0U; /* incomplete record */
+    }
+
+    if (l_trace.hasSeq) {
+        l_trace.nLost += (seq - (l_trace.lastSeq + 1U)) & 0xFFU;
+    }
+    l_trace.hasSeq  = true;
+    l_trace.lastSeq = seq;
+    ++l_trace.recCnt[rec];
+    ++l_trace.nRec;
+    return (size_t)(c.p - buf);
+}
+
+/* reports =================================================================*/
+static void printHist(char const * const title, size_t const offset) {
+    unsigned p;
+    printf("\n%s:\n"
+           " prio  name              count        min        avg"
+           "        p50        p99        max\n", title);
+    for (p = 1U; p <= MAX_PRIO; ++p) {
+        Hist const * const h =
+            (Hist const *)((uint8_t const *)&l_ao[p] + offset);
+        if (h->n != 0U) {
+            printf(" %4u  %-14s %8llu %10llu %10llu %10llu %10llu %10llu\n",
+                   p, aoName(p),
+                   (unsigned long long)h->n,
+                   (unsigned long long)h->min,
+                   (unsigned long long)(h->sum / h->n),
+                   (unsigned long long)histPercentile(h, 50U),
+                   (unsigned long long)histPercentile(h, 99U),
+                   (unsigned long long)h->max);
+        }
+    }
+}
+/*..........................................................................*/
+static void printStats(double const secs) {
+    unsigned p;
+
+    printf("\nTrace: %llu records, %llu bytes, %llu lost, "
+           "duration %llu\n",
+           (unsigned long long)l_trace.nRec,
+           (unsigned long long)l_trace.nBytes,
+           (unsigned long long)l_trace.nLost,
+           (unsigned long long)l_trace.time);
+    if (l_target.isValid) {
+        printf("Target: QP-nano %u.%u.%u, Q_PARAM_SIZE=%u, "
+               "QF_TIMEEVT_CTR_SIZE=%u, QF_MAX_TICK_RATE=%u, "
+               "QS_TIME_SIZE=%u, QF_EQUEUE_CTR_SIZE=%u, pointer size=%u\n",
+               l_target.version / 100U, (l_target.version / 10U) % 10U,
+               l_target.version % 10U, l_target.paramSize,
+               l_target.timeEvtCtrSize, l_target.maxTickRate,
+               l_target.timeSize, l_target.eqCtrSize, l_target.ptrSize);
+    }
+    printf("Clock ticks: %llu\n", (unsigned long long)l_trace.nTicks);
+
+    printf("\nEvent queues:\n"
+           " prio  name             posted        ISR       LIFO  coalesced"
+           "     failed dispatched  max-depth\n");
+    for (p = 1U; p <= MAX_PRIO; ++p) {
+        AoStat const * const ao = &l_ao[p];
+        if (ao->isAdded || (ao->nGet != 0U)) {
+            printf(" %4u  %-14s %8llu %10llu %10llu %10llu %10llu %10llu"
+                   " %10u\n",
+                   p, aoName(p),
+                   (unsigned long long)ao->nPost,
+                   (unsigned long long)ao->nPostISR,
+                   (unsigned long long)ao->nPostLIFO,
+                   (unsigned long long)ao->nCoalesce,
+                   (unsigned long long)ao->nFail,
+                   (unsigned long long)ao->nGet,
+                   ao->maxDepth);
+        }
+    }
+    for (p = 1U; p <= MAX_PRIO; ++p) {
+        if ((l_ao[p].nDefer | l_ao[p].nDeferFail) != 0U) {
+            break;
+        }
+    }
+    if (p <= MAX_PRIO) { /* any active object deferred events? */
+        printf("\nEvent deferral:\n"
+               " prio  name           deferred     failed   recalled"
+               " max-deferred\n");
+        for (p = 1U; p <= MAX_PRIO; ++p) {
+            AoStat const * const ao = &l_ao[p];
+            if ((ao->nDefer | ao->nDeferFail) != 0U) {
+                printf(" %4u  %-14s %8llu %10llu %10llu %12u\n",
+                       p, aoName(p),
+                       (unsigned long long)ao->nDefer,
+                       (unsigned long long)ao->nDeferFail,
+                       (unsigned long long)ao->nRecall,
+                       ao->maxDeferred);
+            }
+        }
+    }
+    printHist("Queueing latency (post or recall -> dispatch)",
+              offsetof(AoStat, latency));
+    printHist("RTC steps (dispatch -> end of RTC step)",
+              offsetof(AoStat, rtc));
+
+    fprintf(stderr, "qspyn: decoded %llu records in %.3f s "
+            "(%.1f million records/s)\n",
+            (unsigned long long)l_trace.nRec, secs,
+            (secs > 0.0) ? ((double)l_trace.nRec / secs / 1e6) : 0.0);
+}
+
+/*..........................................................................*/
+int main(int argc, char *argv[]) {
+    FILE *in = stdin;
+    uint8_t *buf;
+    size_t len = 0U;
+    size_t pos = 0U;
+    bool eof = false;
+    clock_t start;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-t") == 0) {
+            l_opt.timeline = true;
+        }
+        else if (strcmp(argv[i], "-s") == 0) {
+            l_opt.stats = true;
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && ((i + 1) < argc)) {
+            unsigned const p = (unsigned)atoi(argv[++i]);
+            if ((p == 0U) || (p > MAX_PRIO)) {
+                fprintf(stderr, "qspyn: invalid priority %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+            l_opt.prioMask |= (1U << p);
+        }
+        else if ((strcmp(argv[i], "-q") == 0) && ((i + 1) < argc)) {
+            l_opt.depthFile = fopen(argv[++i], "w");
+            if (l_opt.depthFile == (FILE *)0) {
+                perror(argv[i]);
+                return EXIT_FAILURE;
+            }
+            fprintf(l_opt.depthFile, "time,prio,depth\n");
+        }
+        else if ((argv[i][0] == '-') && (argv[i][1] != '\0')) {
+            usage();
+            return EXIT_FAILURE;
+        }
+        else if (strcmp(argv[i], "-") != 0) {
+            in = fopen(argv[i], "rb");
+            if (in == (FILE *)0) {
+                perror(argv[i]);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    if (!l_opt.timeline && (l_opt.depthFile == (FILE *)0)) {
+        l_opt.stats = true;
+    }
+
+    buf = (uint8_t *)malloc(IN_BUF_SIZE);
+    if (buf == (uint8_t *)0) {
+        fprintf(stderr, "qspyn: out of memory\n");
+        return EXIT_FAILURE;
+    }
+    setvbuf(stdout, (char *)0, _IOFBF, 1024U*1024U);
+
+    start = clock();
+    for (;;) {
+        size_t n;
+        if (!eof && ((len - pos) < MAX_REC_SIZE)) { /* refill the buffer */
+            memmove(buf, &buf[pos], len - pos);
+            len -= pos;
+            pos = 0U;
+            len += fread(&buf[len], 1U, IN_BUF_SIZE - len, in);
+            eof = (len < IN_BUF_SIZE) && (feof(in) || ferror(in));
+        }
+        if (pos == len) {
+            break; /* all data processed */
+        }
+        n = decodeRecord(&buf[pos], len - pos);
+        if (n == 0U) {
+            if (eof) {
+                fprintf(stderr, "qspyn: incomplete record at the end "
+                        "of the trace (%llu bytes ignored)\n",
+                        (unsigned long long)(len - pos));
+                break;
+            }
+            if ((len - pos) >= MAX_REC_SIZE) {
+                fprintf(stderr, "qspyn: record too long at byte %llu\n",
+                        (unsigned long long)l_trace.nBytes);
+                return EXIT_FAILURE;
+            }
+            continue; /* read more data */
+        }
+        pos += n;
+        l_trace.nBytes += n;
+    }
+
+    if (l_opt.stats) {
+        printStats((double)(clock() - start) / CLOCKS_PER_SEC);
+    }
+    if (l_opt.depthFile != (FILE *)0) {
+        fclose(l_opt.depthFile);
+    }
+    free(buf);
+    return EXIT_SUCCESS;
+}
@@ -53,6 +53,12 @@ static QState AlarmClock_final      (AlarmClock * const me);
 /* Global objects ----------------------------------------------------------*/
 AlarmClock AO_AlarmClock; /* the single instance of the AlarmClock AO */
 
+/* Local objects -----------------------------------------------------------*/
+/* routing of the AlarmClock signals to the orthogonal components */
+static QHsmRoute const Q_ROM l_alarmClockRoute[] = {
+    { &AO_AlarmClock.alarm.super, ALARM_SET_SIG, ALARM_OFF_SIG }
+};
+
 /*..........................................................................*/
 void AlarmClock_ctor(void) {
     QActive_ctor((QActive *)&AO_AlarmClock,
@@ -119,10 +125,8 @@ QState AlarmClock_timekeeping(AlarmClock * const me) {
         case ALARM_SET_SIG:
         case ALARM_ON_SIG:
         case ALARM_OFF_SIG: {
-            /* synchronously dispatch to the orthogonal component */
-            Q_SIG(&me->alarm) = Q_SIG(me);
-            Q_PAR(&me->alarm) = Q_PAR(me);
-            QHSM_DISPATCH(&me->alarm.super);
+            /* synchronously dispatch to the orthogonal component(s) */
+            (void)QHSM_FORWARD(me, l_alarmClockRoute);
             status = Q_HANDLED();
             break;
         }
@@ -72,8 +72,9 @@ void QF_onClockTickISR(void) {
                 break;
             }
             case '\33': { /* ESC pressed? */
-                QACTIVE_POST_ISR((QActive *)&AO_TServer,
-                                 TERMINATE_SIG, 0U);
+                /* post LIFO, ahead of any requests waiting in the queue */
+                QACTIVE_POST_LIFO_ISR((QActive *)&AO_TServer,
+                                      TERMINATE_SIG, 0U);
                 break;
             }
         }
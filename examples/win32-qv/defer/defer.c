@@ -41,8 +41,9 @@
 typedef struct TServerTag { /* Transaction Server active object */
     QActive super;          /* inherit QActive */
 
-    QEvt deferredRequest;   /* deferred request event */
-    /* optionally other storage for deferring other event types... */
+    /* the deferred requests are stored by QF-nano in the deferral buffer
+    * of this AO, see QF_active[] in main.c
+    */
 } TServer;
 
 /* hierarchical state machine ... */
@@ -66,7 +67,7 @@ void TServer_ctor(void) {
 }
 /* HSM definition ----------------------------------------------------------*/
 QState TServer_initial(TServer * const me) {
-    me->deferredRequest.sig = 0U; /* no deferred requests */
+    (void)me; /* unused parameter */
     return Q_TRAN(&TServer_operational);
 }
 /*..........................................................................*/
@@ -175,24 +176,26 @@ QState TServer_authorizing(TServer * const me) {
 
 /* helper functions ........................................................*/
 void TServer_deferRequest(TServer * const me) {
-    if (me->deferredRequest.sig == 0U) { /* the request NOT deferred yet? */
-        me->deferredRequest.sig = Q_SIG(me);
-        me->deferredRequest.par = Q_PAR(me);
-        printf("deferring request #%d\n", (int)me->deferredRequest.par);
+    if (QActive_defer(&me->super)) { /* could the request be deferred? */
+        printf("deferring request #%d (%d deferred)\n", (int)Q_PAR(me),
+               (int)QActive_getDeferred(&me->super));
     }
     else {
         printf("!!! cannot defer request #%d\n", (int)Q_PAR(me));
     }
 }
 void TServer_recallRequest(TServer * const me) {
-    if (me->deferredRequest.sig != 0U) { /* the request already deferred? */
-        printf("recalling request #%d\n", (int)me->deferredRequest.par);
-        QACTIVE_POST(&me->super,
-                     me->deferredRequest.sig, me->deferredRequest.par);
-
-        me->deferredRequest.sig = 0U; /* request no longer deferred */
+    if (QActive_getDeferred(&me->super) == 0U) {
+        printf("No requests to recall\n");
+    }
+    /* the recalled request goes to the front of the queue (LIFO), so it
+    * is processed next, before any requests posted in the meantime
+    */
+    else if (QActive_recall(&me->super)) {
+        printf("recalling a request (%d still deferred)\n",
+               (int)QActive_getDeferred(&me->super));
     }
     else {
-        printf("No requests to recall\n");
+        printf("!!! cannot recall a request, the queue is full\n");
     }
 }
@@ -37,11 +37,14 @@
 
 /* Local-scope objects -----------------------------------------------------*/
 static QEvt l_serverQueue[2];
+static QEvt l_serverDefer[3]; /* deferral buffer for the TServer AO */
 
 /* QF_active[] array defines all active object control blocks --------------*/
 QActiveCB const Q_ROM QF_active[] = {
-    { (QActive *)0,           (QEvt *)0,     0U                   },
-    { (QActive *)&AO_TServer, l_serverQueue, Q_DIM(l_serverQueue) }
+    { (QActive *)0,           (QEvt *)0,     0U,
+      (QEvt *)0,     0U                   },
+    { (QActive *)&AO_TServer, l_serverQueue, Q_DIM(l_serverQueue),
+      l_serverDefer, Q_DIM(l_serverDefer) }
 };
 
 /*..........................................................................*/
@@ -37,5 +37,6 @@
 #define Q_PARAM_SIZE            4
 #define QF_TIMEEVT_CTR_SIZE     2
 #define QF_TIMEEVT_PERIODIC
+#define QF_DEFER
 
 #endif  /* qpn_conf_h */
@@ -89,8 +89,28 @@ typedef float float32_t;
 */
 typedef double float64_t;
 
-/*! Scalar type describing the signal of an event. */
-typedef uint8_t QSignal;
+#ifndef Q_SIGNAL_SIZE
+    /*! The size of event signal. Valid values 1, 2, or 4; default 1 */
+    #define Q_SIGNAL_SIZE 1
+#endif
+#if (Q_SIGNAL_SIZE == 1)
+    typedef uint8_t QSignal;
+#elif (Q_SIGNAL_SIZE == 2)
+    typedef uint16_t QSignal;
+#elif (Q_SIGNAL_SIZE == 4)
+    /*! Scalar type describing the signal of an event. */
+    /**
+    * @description
+    * This typedef is configurable via the preprocessor switch #Q_SIGNAL_SIZE.
+    * The other possible values of this type are as follows: @n
+    * uint8_t when (Q_SIGNAL_SIZE == 1); @n
+    * uint16_t when (Q_SIGNAL_SIZE == 2); and @n
+    * uint32_t when (Q_SIGNAL_SIZE == 4).
+    */
+    typedef uint32_t QSignal;
+#else
+    #error "Q_SIGNAL_SIZE defined incorrectly, expected 1, 2, or 4"
+#endif
 
 #ifndef Q_PARAM_SIZE
     /*! The size of event parameter Valid values 0, 1, 2, or 4; default 0 */
@@ -117,6 +137,148 @@ typedef uint8_t QSignal;
     #error "Q_PARAM_SIZE defined incorrectly, expected 0, 1, 2, or 4"
 #endif
 
+#ifndef QHSM_SIG_MASK_SIZE
+    /*! macro to override the default ::QSigMask size.
+    * Valid values 0, 1, 2, or 4; default 0 (no masks of handled signals)
+    */
+    #define QHSM_SIG_MASK_SIZE 0
+#endif
+#if (QHSM_SIG_MASK_SIZE == 0)
+    /* no masks of handled signals */
+#elif (QHSM_SIG_MASK_SIZE == 1)
+    typedef uint8_t QSigMask;
+#elif (QHSM_SIG_MASK_SIZE == 2)
+    typedef uint16_t QSigMask;
+#elif (QHSM_SIG_MASK_SIZE == 4)
+    /*! type of the mask of signals handled by a state */
+    /**
+    * @description
+    * Every bit of this mask corresponds to one signal, starting with
+    * ::Q_TIMEOUT_SIG, so the size of this type determines how many signals
+    * can be filtered before dispatching (see ::QHsmMask). This typedef is
+    * configurable via the preprocessor switch #QHSM_SIG_MASK_SIZE. The other
+    * possible values of this type are as follows: @n
+    * none when (QHSM_SIG_MASK_SIZE not defined or == 0), @n
+    * uint8_t  when (QHSM_SIG_MASK_SIZE == 1); @n
+    * uint16_t when (QHSM_SIG_MASK_SIZE == 2); and @n
+    * uint32_t when (QHSM_SIG_MASK_SIZE == 4).
+    */
+    typedef uint32_t QSigMask;
+#else
+    #error "QHSM_SIG_MASK_SIZE defined incorrectly, expected 1, 2, or 4"
+#endif
+
+/****************************************************************************/
+/* macros for accessing data in ROM */
+#ifndef Q_ROM /* if NOT defined, provide the default definition */
+
+    /*! Macro to specify compiler-specific directive for placing a
+    * constant object in ROM. */
+    /**
+    * @description
+    * Many compilers for 8-bit Harvard-architecture MCUs provide non-standard
+    * extensions to support placement of objects in different memories.
+    * In order to conserve the precious RAM, QP-nano uses the Q_ROM macro for
+    * all constant objects that can be allocated in ROM.
+    *
+    * @note
+    * To override the following empty definition, you need to define the
+    * Q_ROM macro in the qpn_port.h header file. Some examples of valid
+    * Q_ROM macro definitions are: __code (IAR 8051 compiler), code (Keil
+    * 8051 compiler), PROGMEM (gcc for AVR), __flash (IAR for AVR).
+    */
+    #define Q_ROM
+#endif
+
+#ifndef Q_ROM_BYTE
+    /*! Macro to access a byte allocated in ROM */
+    /**
+    * Some compilers for Harvard-architecture MCUs, such as gcc for AVR, do
+    * not generate correct code for accessing data allocated in the program
+    * space (ROM). The workaround for such compilers is to explicitly add
+    * assembly code to access each data element allocated in the program
+    * space. The macro Q_ROM_BYTE() retrieves a byte from the given ROM
+    * address.
+    *
+    * @note
+    * The Q_ROM_BYTE() macro should be defined in the qpn_port.h header file
+    * for each compiler that cannot handle correctly data allocated in ROM
+    * (such as the gcc). If the macro is left undefined, the default
+    * definition simply returns the parameter and lets the compiler
+    * synthesize the correct code.
+    */
+    #define Q_ROM_BYTE(rom_var_)   (rom_var_)
+#endif
+
+#ifndef Q_ROM_PTR
+    /*! Macro to access a pointer allocated in ROM */
+    /**
+    * Some compilers for Harvard-architecture MCUs, such as gcc for AVR, do
+    * not generate correct code for accessing data allocated in the program
+    * space (ROM). The workaround for such compilers is to explicitly add
+    * assembly code to access each data element allocated in the program
+    * space. The macro Q_ROM_PTR() retrieves an object-pointer from the given
+    * ROM address. Please note that the pointer can be pointing to the object
+    * in RAM or ROM.
+    *
+    * @note
+    * The Q_ROM_PTR() macro should be defined in the qpn_port.h header file
+    * for each compiler that cannot handle correctly data allocated in ROM
+    * (such as the gcc). If the macro is left undefined, the default
+    * definition simply returns the parameter and lets the compiler
+    * synthesize the correct code.
+    */
+    #define Q_ROM_PTR(rom_var_)    (rom_var_)
+#endif
+
+#ifndef Q_ROM_SIG
+    #if (Q_SIGNAL_SIZE == 1)
+        #define Q_ROM_SIG(rom_var_) Q_ROM_BYTE(rom_var_)
+    #else
+        /*! Macro to access a signal allocated in ROM */
+        /**
+        * The macro Q_ROM_SIG() retrieves a ::QSignal from the given ROM
+        * address. For the default single-byte signals it is Q_ROM_BYTE().
+        *
+        * @note
+        * Ports for compilers that cannot handle correctly data allocated in
+        * ROM (such as the gcc for AVR) must define Q_ROM_SIG() in the
+        * qpn_port.h header file when #Q_SIGNAL_SIZE is 2 or 4.
+        */
+        #define Q_ROM_SIG(rom_var_) (rom_var_)
+    #endif
+#endif
+
+#if (QHSM_SIG_MASK_SIZE != 0)
+/*! The bit of the signal @p sig_ in ::QSigMask */
+/**
+* @description
+* The signal must be in the range ::Q_TIMEOUT_SIG ..
+* ::Q_TIMEOUT_SIG + 8*#QHSM_SIG_MASK_SIZE - 1. The signals above this range
+* are never filtered, so they need not be declared in ::QHsmMask.
+*/
+#define Q_SIG_BIT(sig_) \
+    ((QSigMask)((QSigMask)1U << ((QSignal)(sig_) - (QSignal)Q_TIMEOUT_SIG)))
+
+#ifndef Q_ROM_SIG_MASK
+    #if (QHSM_SIG_MASK_SIZE == 1)
+        #define Q_ROM_SIG_MASK(rom_var_) Q_ROM_BYTE(rom_var_)
+    #else
+        /*! Macro to access a signal mask allocated in ROM */
+        /**
+        * The macro Q_ROM_SIG_MASK() retrieves a ::QSigMask from the given
+        * ROM address. For the single-byte masks it is Q_ROM_BYTE().
+        *
+        * @note
+        * Ports for compilers that cannot handle correctly data allocated in
+        * ROM (such as the gcc for AVR) must define Q_ROM_SIG_MASK() in the
+        * qpn_port.h header file when #QHSM_SIG_MASK_SIZE is 2 or 4.
+        */
+        #define Q_ROM_SIG_MASK(rom_var_) (rom_var_)
+    #endif
+#endif
+#endif /* (QHSM_SIG_MASK_SIZE != 0) */
+
 /****************************************************************************/
 /*! Event structure. */
 /**
@@ -158,6 +320,35 @@ typedef QState (*QStateHandler)(void * const me);
 /*! virtual table for the ::QHsm class. */
 typedef struct QHsmVtbl QHsmVtbl;
 
+#ifdef QHSM_HISTORY
+/*! history slot of a composite state (see ::QHsmHist) */
+typedef struct QHsmHist QHsmHist;
+#endif /* QHSM_HISTORY */
+
+#if (QHSM_SIG_MASK_SIZE != 0)
+/*! Mask of the signals handled by one state */
+/**
+* @description
+* QHsmMask is one entry of a table, typically placed in ROM right after
+* the declarations of the state handlers, which declares all the signals
+* that the state @c state handles in any way (including the handling
+* with a guard, a transition, or with Q_TRAN_XP()). QEP-nano combines the
+* masks of all states in the active configuration after every transition
+* and discards the events that no active state handles, without calling
+* any state handler. The states missing in the table are assumed to handle
+* all signals, and so are the signals not covered by ::QSigMask.
+*
+* @usage
+* @include qepn_qmask.c
+*
+* @sa QHSM_SET_MASKS(), Q_SIG_BIT()
+*/
+typedef struct {
+    QStateHandler state; /*!< the state handler */
+    QSigMask      sigs;  /*!< the signals handled by the state */
+} QHsmMask;
+#endif /* (QHSM_SIG_MASK_SIZE != 0) */
+
 /*! Hierarchical State Machine */
 /**
 * @description
@@ -178,12 +369,65 @@ typedef struct QHsmVtbl QHsmVtbl;
 * @sa @ref oop
 */
 typedef struct {
+#ifndef QF_NO_VIRTUAL
     QHsmVtbl const *vptr; /*!< virtual pointer */
+#endif /* QF_NO_VIRTUAL */
     QStateHandler state;  /*!< current active state (state-variable) */
     QStateHandler temp;   /*!< temporary: tran. chain, target state, etc. */
     QEvt evt;  /*!< currently processed event in the HSM (protected) */
+#ifdef QHSM_HISTORY
+    QHsmHist *hist; /*!< list of the history slots (or NULL) */
+#endif /* QHSM_HISTORY */
+#ifdef QHSM_SUBMACHINE
+    QStateHandler host; /*!< the submachine state of the active submachine */
+    QStateHandler ep;   /*!< the entry point of a pending transition */
+#endif /* QHSM_SUBMACHINE */
+#if (QHSM_SIG_MASK_SIZE != 0)
+    QHsmMask const Q_ROM *masks; /*!< table of the handled signals (or NULL) */
+    QSigMask sigs;  /*!< the signals handled in the active configuration */
+    uint8_t nMasks; /*!< the number of entries in the table masks[] */
+#endif /* (QHSM_SIG_MASK_SIZE != 0) */
 } QHsm;
 
+/*! maximum depth of state nesting in HSMs (including the top level),
+* must be >= 2
+*/
+#define QHSM_MAX_NEST_DEPTH_  ((int_fast8_t)5)
+
+#ifdef QHSM_HISTORY
+/*! History slot of a composite state */
+/**
+* @description
+* QHsmHist keeps the shallow and deep history of one composite state.
+* QEP-nano updates the slot automatically whenever the composite state is
+* exited, by storing the path of the substates that were active at that
+* time (from the leaf state up to the direct substate of the composite).
+* A transition to history then re-enters the stored path directly,
+* instead of discovering it through the superstates of the target.
+*
+* @note
+* The slots are registered with QHsm_addHist() and are typically
+* allocated as members of the derived state machine.
+* With #QHSM_SUBMACHINE, the slot also keeps the active submachine state,
+* so the composite state with history must not be a submachine state.
+*
+* @usage
+* @include qepn_qhist_native.c
+*
+* @sa Q_TRAN_HIST_SHALLOW(), Q_TRAN_HIST_DEEP()
+*/
+struct QHsmHist {
+    QHsmHist     *next;  /*!< the next history slot of the same HSM */
+    QStateHandler state; /*!< the composite state with the history */
+    /*! the substates active at the last exit, the leaf state first */
+    QStateHandler path[QHSM_MAX_NEST_DEPTH_ - 2];
+    uint8_t       depth; /*!< the number of valid entries in path[] */
+#ifdef QHSM_SUBMACHINE
+    QStateHandler host;  /*!< the submachine state active at the last exit */
+#endif /* QHSM_SUBMACHINE */
+};
+#endif /* QHSM_HISTORY */
+
 /*! Virtual table for the QHsm class */
 struct QHsmVtbl {
     /*! Triggers the top-most initial transition in a HSM. */
@@ -203,8 +447,15 @@ struct QHsmVtbl {
 * The following example illustrates how to initialize a SM, and dispatch
 * events to it:
 * @include qepn_qhsm_use.c
+*
+* @note When the macro #QF_NO_VIRTUAL is defined, this macro calls
+* QHsm_init_() directly.
 */
+#ifndef QF_NO_VIRTUAL
 #define QHSM_INIT(me_) ((*(me_)->vptr->init)((me_)))
+#else
+#define QHSM_INIT(me_) (QHsm_init_((me_)))
+#endif /* QF_NO_VIRTUAL */
 
 /*! Polymorphically dispatches an event to a HSM. */
 /**
@@ -214,8 +465,15 @@ struct QHsmVtbl {
 * @param[in,out] me_ pointer (see @ref oop)
 *
 * @note Must be called after the "constructor" and after QHSM_INIT().
+*
+* @note When the macro #QF_NO_VIRTUAL is defined, this macro calls
+* QHsm_dispatch_() directly.
 */
+#ifndef QF_NO_VIRTUAL
 #define QHSM_DISPATCH(me_) ((*(me_)->vptr->dispatch)((me_)))
+#else
+#define QHSM_DISPATCH(me_) (QHsm_dispatch_((me_)))
+#endif /* QF_NO_VIRTUAL */
 
 /* public methods */
 /*! protected "constructor" of a HSM. */
@@ -243,6 +501,31 @@ void QHsm_ctor(QHsm * const me, QStateHandler initial);
 QStateHandler QHsm_childState_(QHsm * const me,
                                QStateHandler const parent);
 
+#ifdef QHSM_HISTORY
+/*! Registers the history slot of a composite state in a HSM */
+void QHsm_addHist(QHsm * const me, QHsmHist * const hist,
+                  QStateHandler const state);
+#endif /* QHSM_HISTORY */
+
+#if (QHSM_SIG_MASK_SIZE != 0)
+/*! Registers the table of the handled signals of a HSM */
+/**
+* @param[in,out] me_    pointer (see @ref oop)
+* @param[in]     masks_ the table of the handled signals (array of
+*                       ::QHsmMask, typically in ROM)
+*
+* @note Must be called in the "constructor" of the derived state machine,
+* after QHsm_ctor() (or QActive_ctor()) and before QHSM_INIT().
+*/
+#define QHSM_SET_MASKS(me_, masks_) \
+    (QHsm_setMasks(Q_HSM_UPCAST(me_), &(masks_)[0], \
+                   (uint_fast8_t)Q_DIM(masks_)))
+
+/*! Registers the table of the handled signals of a HSM */
+void QHsm_setMasks(QHsm * const me, QHsmMask const Q_ROM * const masks,
+                   uint_fast8_t const n);
+#endif /* (QHSM_SIG_MASK_SIZE != 0) */
+
 /*! Implementation of the top-most initial transition in QHsm. */
 void QHsm_init_(QHsm * const me);
 
@@ -275,7 +558,10 @@ enum {
     /* transitions need to execute transition-action table in QHsm */
     Q_RET_TRAN,      /*!< event handled (regular transition) */
     Q_RET_TRAN_INIT, /*!< initial transition in a state or submachine */
-    Q_RET_TRAN_HIST  /*!< event handled (transition to history) */
+    Q_RET_TRAN_EP,   /*!< transition to a submachine entry point */
+    Q_RET_TRAN_HIST, /*!< event handled (transition to history) */
+    Q_RET_TRAN_HIST_SHALLOW, /*!< transition to native shallow history */
+    Q_RET_TRAN_HIST_DEEP /*!< transition to native deep history */
 };
 
 /*! Perform upcast from a subclass of ::QHsm to the base class ::QHsm */
@@ -321,6 +607,39 @@ enum {
 #define Q_TRAN_HIST(hist_)  \
     ((Q_HSM_UPCAST(me))->temp = (hist_), (QState)Q_RET_TRAN_HIST)
 
+#ifdef QHSM_HISTORY
+/*! Macro to call in a state-handler when it executes a transition
+* to the shallow history of the composite state @p state_, which has
+* a history slot registered with QHsm_addHist(). Applicable only to HSMs.
+*
+* @description
+* The transition enters the composite state and then the direct substate
+* that was active when the composite state was last exited, which in turn
+* performs its initial transition. Before the first exit, the transition
+* enters the composite state and performs its initial transition.
+*/
+#define Q_TRAN_HIST_SHALLOW(state_)  \
+    ((Q_HSM_UPCAST(me))->temp = Q_STATE_CAST(state_), \
+     (QState)Q_RET_TRAN_HIST_SHALLOW)
+
+/*! Macro to call in a state-handler when it executes a transition
+* to the deep history of the composite state @p state_, which has
+* a history slot registered with QHsm_addHist(). Applicable only to HSMs.
+*
+* @description
+* The transition enters the composite state and then all the substates,
+* down to the leaf state, that were active when the composite state was
+* last exited. Before the first exit, the transition enters the composite
+* state and performs its initial transition.
+*
+* @usage
+* @include qepn_qhist_native.c
+*/
+#define Q_TRAN_HIST_DEEP(state_)  \
+    ((Q_HSM_UPCAST(me))->temp = Q_STATE_CAST(state_), \
+     (QState)Q_RET_TRAN_HIST_DEEP)
+#endif /* QHSM_HISTORY */
+
 /*! Macro to call in a state-handler when it designates the
 * superstate of a given state. Applicable only to HSMs.
 *
@@ -330,6 +649,55 @@ enum {
 #define Q_SUPER(super_)  \
     ((Q_HSM_UPCAST(me))->temp = Q_STATE_CAST(super_), (QState)Q_RET_SUPER)
 
+#ifdef QHSM_SUBMACHINE
+/*! Macro to call in the top-level states of a submachine to designate
+* the submachine state that currently hosts the submachine as the
+* superstate. Applicable only to HSMs.
+*
+* @description
+* A submachine is a set of state handlers that can be reused in several
+* places of the state hierarchy of the same HSM. Each such place is a
+* _submachine state_ of the host HSM, which is entered through one of the
+* entry points of the submachine with Q_TRAN_EP() and which handles the
+* exit points of the submachine raised with Q_TRAN_XP(). QEP-nano keeps
+* the currently active submachine state in the ::QHsm, so only one
+* submachine can be active at a time (submachines cannot nest).
+*
+* @usage
+* @include qepn_qsub.c
+*/
+#define Q_SUPER_SUB()  \
+    ((Q_HSM_UPCAST(me))->temp = (Q_HSM_UPCAST(me))->host, \
+     (QState)Q_RET_SUPER_SUB)
+
+/*! Macro to call in a state-handler when it executes a transition to the
+* submachine state @p host_ through the entry point @p ep_ (a state of
+* the submachine). Applicable only to HSMs.
+*
+* @description
+* The transition enters the submachine state @p host_ as its target, so
+* the transition path is calculated only within the host HSM, and then
+* drills into the submachine down to @p ep_. The same macro specifies
+* the initial transition of the submachine state (with @p host_ being
+* the submachine state itself).
+*/
+#define Q_TRAN_EP(host_, ep_) \
+    ((Q_HSM_UPCAST(me))->ep = Q_STATE_CAST(ep_), \
+     (Q_HSM_UPCAST(me))->temp = Q_STATE_CAST(host_), \
+     (QState)Q_RET_TRAN_EP)
+
+/*! Macro to call in a state-handler of a submachine when it leaves the
+* submachine through the exit point @p xp_. Applicable only to HSMs.
+*
+* @description
+* The event continues to be processed in the submachine state that hosts
+* the submachine, but with the signal @p xp_ of the exit point, which the
+* submachine state handles, typically with a transition.
+*/
+#define Q_TRAN_XP(xp_) \
+    (Q_SIG(me) = (QSignal)(xp_), Q_SUPER_SUB())
+#endif /* QHSM_SUBMACHINE */
+
 /*! Macro to call in a state-handler when it handles an event.
 *  Applicable to both HSMs and FSMs.
 */
@@ -364,68 +732,6 @@ enum {
 */
 #define Q_UINT2PTR_CAST(type_, uint_)  ((type_ *)(uint_))
 
-/****************************************************************************/
-/* macros for accessing data in ROM */
-#ifndef Q_ROM /* if NOT defined, provide the default definition */
-
-    /*! Macro to specify compiler-specific directive for placing a
-    * constant object in ROM. */
-    /**
-    * @description
-    * Many compilers for 8-bit Harvard-architecture MCUs provide non-standard
-    * extensions to support placement of objects in different memories.
-    * In order to conserve the precious RAM, QP-nano uses the Q_ROM macro for
-    * all constant objects that can be allocated in ROM.
-    *
-    * @note
-    * To override the following empty definition, you need to define the
-    * Q_ROM macro in the qpn_port.h header file. Some examples of valid
-    * Q_ROM macro definitions are: __code (IAR 8051 compiler), code (Keil
-    * 8051 compiler), PROGMEM (gcc for AVR), __flash (IAR for AVR).
-    */
-    #define Q_ROM
-#endif
-
-#ifndef Q_ROM_BYTE
-    /*! Macro to access a byte allocated in ROM */
-    /**
-    * Some compilers for Harvard-architecture MCUs, such as gcc for AVR, do
-    * not generate correct code for accessing data allocated in the program
-    * space (ROM). The workaround for such compilers is to explicitly add
-    * assembly code to access each data element allocated in the program
-    * space. The macro Q_ROM_BYTE() retrieves a byte from the given ROM
-    * address.
-    *
-    * @note
-    * The Q_ROM_BYTE() macro should be defined in the qpn_port.h header file
-    * for each compiler that cannot handle correctly data allocated in ROM
-    * (such as the gcc). If the macro is left undefined, the default
-    * definition simply returns the parameter and lets the compiler
-    * synthesize the correct code.
-    */
-    #define Q_ROM_BYTE(rom_var_)   (rom_var_)
-#endif
-
-#ifndef Q_ROM_PTR
-    /*! Macro to access a pointer allocated in ROM */
-    /**
-    * Some compilers for Harvard-architecture MCUs, such as gcc for AVR, do
-    * not generate correct code for accessing data allocated in the program
-    * space (ROM). The workaround for such compilers is to explicitly add
-    * assembly code to access each data element allocated in the program
-    * space. The macro Q_ROM_PTR() retrieves an object-pointer from the given
-    * ROM address. Please note that the pointer can be pointing to the object
-    * in RAM or ROM.
-    *
-    * @note
-    * The Q_ROM_PTR() macro should be defined in the qpn_port.h header file
-    * for each compiler that cannot handle correctly data allocated in ROM
-    * (such as the gcc). If the macro is left undefined, the default
-    * definition simply returns the parameter and lets the compiler
-    * synthesize the correct code.
-    */
-    #define Q_ROM_PTR(rom_var_)    (rom_var_)
-#endif
 
 
 /****************************************************************************/
@@ -440,5 +746,47 @@ extern char_t const Q_ROM QP_versionStr[6];
 /*! Helper macro to calculate static dimension of a 1-dim array @a array_ */
 #define Q_DIM(array_) (sizeof(array_) / sizeof((array_)[0]))
 
+
+/****************************************************************************/
+/*! Routing of a range of signals to an orthogonal component */
+/**
+* @description
+* QHsmRoute is one entry of a routing table, typically placed in ROM,
+* which maps the signals @c first .. @c last (inclusive) of the container
+* state machine to one of its orthogonal components. The ranges of
+* different entries can overlap, in which case one event is dispatched
+* to all matching components in the order of the table.
+*
+* @sa QHSM_FORWARD()
+*/
+typedef struct {
+    QHsm   *comp;  /*!< the orthogonal component (derived from QHsm) */
+    QSignal first; /*!< the first signal routed to the component */
+    QSignal last;  /*!< the last signal routed to the component */
+} QHsmRoute;
+
+/*! Forwards the current event of a container HSM to its components. */
+/**
+* @description
+* Dispatches the currently processed event of the container @p me_
+* synchronously to every orthogonal component in the routing table
+* @p route_ (an array of ::QHsmRoute) that covers the signal of the event.
+* This macro is intended to be called from a state handler of the
+* container, for example in the case for the routed signals.
+*
+* @param[in,out] me_    pointer to the container (see @ref oop)
+* @param[in]     route_ the routing table (array of ::QHsmRoute)
+*
+* @returns the number of components that received the event
+*/
+#define QHSM_FORWARD(me_, route_) \
+    (QHsm_forward(Q_HSM_UPCAST(me_), &(route_)[0], \
+                  (uint_fast8_t)Q_DIM(route_)))
+
+/*! Forwards the current event of a container HSM to its components. */
+uint_fast8_t QHsm_forward(QHsm * const me,
+                          QHsmRoute const Q_ROM * const route,
+                          uint_fast8_t const n);
+
 #endif /* qepn_h */
 
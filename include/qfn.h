@@ -89,6 +89,84 @@
     } QTimer;
 #endif /* (QF_TIMEEVT_CTR_SIZE != 0) */
 
+#ifndef QF_COALESCE_SIZE
+    /*! macro to override the default QPendSet size.
+    * Valid values 0, 1, 2, or 4; default 0 (no coalescing posts)
+    */
+    #define QF_COALESCE_SIZE 0
+#endif
+#if (QF_COALESCE_SIZE == 0)
+    /* no coalescing posts */
+#elif (QF_COALESCE_SIZE == 1)
+    typedef uint8_t QPendSet;
+#elif (QF_COALESCE_SIZE == 2)
+    /*! type of the set of the pending coalescing signals of an AO */
+    /**
+    * @description
+    * Every bit of this set corresponds to one coalescing signal, starting
+    * with ::Q_USER_SIG, so the size of this type determines how many
+    * signals can be posted with QACTIVE_POST_LATEST(). This typedef is
+    * configurable via the preprocessor switch #QF_COALESCE_SIZE. The other
+    * possible values of this type are as follows: @n
+    * none when (QF_COALESCE_SIZE not defined or == 0), @n
+    * uint8_t  when (QF_COALESCE_SIZE == 1); @n
+    * uint16_t when (QF_COALESCE_SIZE == 2); and @n
+    * uint32_t when (QF_COALESCE_SIZE == 4).
+    */
+    typedef uint16_t QPendSet;
+#elif (QF_COALESCE_SIZE == 4)
+    typedef uint32_t QPendSet;
+#else
+    #error "QF_COALESCE_SIZE defined incorrectly, expected 1, 2, or 4"
+#endif
+
+#ifndef QF_EQUEUE_CTR_SIZE
+    /*! macro to override the default ::QEQueueCtr size.
+    * Valid values 1 or 2; default 1
+    */
+    #define QF_EQUEUE_CTR_SIZE 1
+#endif
+#if (QF_EQUEUE_CTR_SIZE == 1)
+    typedef uint8_t QEQueueCtr;
+    typedef uint_fast8_t QEQueueIdx;
+#elif (QF_EQUEUE_CTR_SIZE == 2)
+    /*! type of the indexes and counters of the event queues of AOs */
+    /**
+    * @description
+    * This typedef determines the maximum length of the ring buffers of an
+    * active object and is configurable via the preprocessor switch
+    * #QF_EQUEUE_CTR_SIZE. The other possible value of this type is
+    * uint8_t when (QF_EQUEUE_CTR_SIZE not defined or == 1).
+    */
+    typedef uint16_t QEQueueCtr;
+
+    /*! fast type for the queue lengths, counts and margins in the APIs */
+    /**
+    * @description
+    * The "fast" counterpart of ::QEQueueCtr: uint_fast8_t when
+    * (QF_EQUEUE_CTR_SIZE not defined or == 1) and uint_fast16_t when
+    * (QF_EQUEUE_CTR_SIZE == 2).
+    */
+    typedef uint_fast16_t QEQueueIdx;
+#else
+    #error "QF_EQUEUE_CTR_SIZE defined incorrectly, expected 1 or 2"
+#endif
+
+#ifndef Q_ROM_EQUEUE_CTR
+    #if (QF_EQUEUE_CTR_SIZE == 1)
+        #define Q_ROM_EQUEUE_CTR(rom_var_) Q_ROM_BYTE(rom_var_)
+    #else
+        /*! Macro to access a ::QEQueueCtr allocated in ROM */
+        /**
+        * @note
+        * Ports for compilers that cannot handle correctly data allocated in
+        * ROM (such as the gcc for AVR) must define Q_ROM_EQUEUE_CTR() in the
+        * qpn_port.h header file when #QF_EQUEUE_CTR_SIZE is 2.
+        */
+        #define Q_ROM_EQUEUE_CTR(rom_var_) (rom_var_)
+    #endif
+#endif
+
 #ifndef QF_MAX_TICK_RATE
     /*! Default value of the macro configurable value in qpn_port.h */
     #define QF_MAX_TICK_RATE     1
@@ -129,15 +207,72 @@ typedef struct {
     uint8_t prio;
 
     /*! offset to where next event will be inserted into the buffer */
-    uint8_t volatile head;
+    QEQueueCtr volatile head;
 
     /*! offset of where next event will be extracted from the buffer */
-    uint8_t volatile tail;
+    QEQueueCtr volatile tail;
 
     /*! number of events currently present in the queue
     * (events in the ring buffer + 1 event in the state machine)
     */
-    uint8_t volatile nUsed;
+    QEQueueCtr volatile nUsed;
+
+#ifdef QF_EQUEUE_USAGE
+    /*! maximum number of events ever present in the queue ring buffer
+    * (high-water mark) since QF_init() or the last QActive_resetQueueMax().
+    * The events in the urgent ring buffer are not counted (see uMax).
+    */
+    QEQueueCtr volatile nMax;
+#endif /* QF_EQUEUE_USAGE */
+
+#ifdef QF_DEFER
+    /*! offset to where the next deferred event will be inserted into
+    * the deferral ring buffer
+    */
+    QEQueueCtr dHead;
+
+    /*! offset of where the next recalled event will be extracted from
+    * the deferral ring buffer
+    */
+    QEQueueCtr dTail;
+
+    /*! number of events currently deferred */
+    QEQueueCtr dUsed;
+#endif /* QF_DEFER */
+
+#ifdef QF_URGENT_QUEUE
+    /*! offset to where the next urgent event will be inserted into
+    * the urgent ring buffer
+    */
+    QEQueueCtr volatile uHead;
+
+    /*! offset of where the next urgent event will be extracted from
+    * the urgent ring buffer
+    */
+    QEQueueCtr volatile uTail;
+
+    /*! number of events currently in the urgent ring buffer
+    * (also counted in nUsed)
+    */
+    QEQueueCtr volatile uUsed;
+
+#ifdef QF_EQUEUE_USAGE
+    /*! maximum number of events ever present in the urgent ring buffer
+    * (high-water mark) since QF_init() or the last QActive_resetQueueMax()
+    */
+    QEQueueCtr volatile uMax;
+#endif /* QF_EQUEUE_USAGE */
+#endif /* QF_URGENT_QUEUE */
+
+#if (QF_COALESCE_SIZE != 0)
+    /*! set of the coalescing signals with an event waiting in the queue */
+    QPendSet volatile pend;
+
+    /*! ring-buffer slot of the waiting event of every coalescing signal
+    * (valid only while the bit of the signal is set in the pend set)
+    */
+    QEQueueCtr pendAt[8U * QF_COALESCE_SIZE];
+#endif /* (QF_COALESCE_SIZE != 0) */
 
 } QActive;
 
@@ -150,19 +285,19 @@ typedef struct {
     * (task context).
     */
     /** @sa QACTIVE_POST() and QACTIVE_POST_X() */
-    bool (*post)(QActive * const me, uint_fast8_t const margin,
+    bool (*post)(QActive * const me, QEQueueIdx const margin,
                  enum_t const sig, QParam const par);
 
     /*! virtual function to asynchronously post (FIFO) an event to an AO
     * (ISR context).
     */
     /** @sa QACTIVE_POST_ISR() and QACTIVE_POST_X_ISR() */
-    bool (*postISR)(QActive * const me, uint_fast8_t const margin,
+    bool (*postISR)(QActive * const me, QEQueueIdx const margin,
                     enum_t const sig, QParam const par);
 #else
-    bool (*post)   (QActive * const me, uint_fast8_t const margin,
+    bool (*post)   (QActive * const me, QEQueueIdx const margin,
                     enum_t const sig);
-    bool (*postISR)(QActive * const me, uint_fast8_t const margin,
+    bool (*postISR)(QActive * const me, QEQueueIdx const margin,
                     enum_t const sig);
 #endif
 } QActiveVtbl;
@@ -174,7 +309,28 @@ void QActive_ctor(QActive * const me, QStateHandler initial);
 /*! special value of margin that causes asserting failure in case
 * event posting fails.
 */
-#define QF_NO_MARGIN ((uint_fast8_t)0xFF)
+#define QF_NO_MARGIN ((QEQueueIdx)(QEQueueCtr)~(QEQueueCtr)0)
+
+#ifndef QF_NO_VIRTUAL
+    /*! the post() operation of an active object (internal use only) */
+    /**
+    * @description
+    * Selects the post() operation from the virtual table of the active
+    * object @p me_. When the macro #QF_NO_VIRTUAL is defined, the
+    * active objects have no virtual pointer, and QActive_postX_() is
+    * called directly instead.
+    */
+    #define QACTIVE_POST_OP_(me_) \
+        (*((QActiveVtbl const *)(QF_ACTIVE_CAST((me_))->super.vptr))->post)
+
+    /*! the postISR() operation of an active object (internal use only) */
+    #define QACTIVE_POST_ISR_OP_(me_) \
+        (*((QActiveVtbl const *)( \
+            QF_ACTIVE_CAST((me_))->super.vptr))->postISR)
+#else
+    #define QACTIVE_POST_OP_(me_)     QActive_postX_
+    #define QACTIVE_POST_ISR_OP_(me_) QActive_postXISR_
+#endif /* QF_NO_VIRTUAL */
 
 #if (Q_PARAM_SIZE != 0)
     /*! Polymorphically posts an event to an active object (FIFO)
@@ -195,9 +351,7 @@ void QActive_ctor(QActive * const me, QStateHandler initial);
     * @include qfn_post.c
     */
     #define QACTIVE_POST(me_, sig_, par_) \
-        ((void)(*((QActiveVtbl const *)( \
-            QF_ACTIVE_CAST((me_))->super.vptr))->post)( \
-                QF_ACTIVE_CAST((me_)), QF_NO_MARGIN, \
+        ((void)QACTIVE_POST_OP_((me_))(QF_ACTIVE_CAST((me_)), QF_NO_MARGIN, \
                 (enum_t)(sig_), (QParam)(par_)))
 
     /*! Polymorphically posts an event to an active object (FIFO)
@@ -224,9 +378,7 @@ void QActive_ctor(QActive * const me, QStateHandler initial);
     * @include qfn_postx.c
     */
     #define QACTIVE_POST_X(me_, margin_, sig_, par_) \
-        ((*((QActiveVtbl const *)( \
-            QF_ACTIVE_CAST((me_))->super.vptr))->post)( \
-                QF_ACTIVE_CAST((me_)), \
+        (QACTIVE_POST_OP_((me_))(QF_ACTIVE_CAST((me_)), \
                 (margin_), (enum_t)(sig_), (QParam)(par_)))
 
     /*! Polymorphically posts an event to an active object (FIFO)
@@ -246,10 +398,8 @@ void QActive_ctor(QActive * const me, QStateHandler initial);
     * @include qfn_post.c
     */
     #define QACTIVE_POST_ISR(me_, sig_, par_) \
-        ((void)(*((QActiveVtbl const *)( \
-            QF_ACTIVE_CAST((me_))->super.vptr))->postISR)( \
-                QF_ACTIVE_CAST((me_)), QF_NO_MARGIN, \
-                (enum_t)(sig_), (QParam)(par_)))
+        ((void)QACTIVE_POST_ISR_OP_((me_))(QF_ACTIVE_CAST((me_)), \
+                QF_NO_MARGIN, (enum_t)(sig_), (QParam)(par_)))
 
     /*! Polymorphically posts an event to an active object (FIFO)
     * without delivery guarantee (ISR context).
@@ -275,46 +425,292 @@ void QActive_ctor(QActive * const me, QStateHandler initial);
     * @include qfn_postx.c
     */
     #define QACTIVE_POST_X_ISR(me_, margin_, sig_, par_) \
-        ((*((QActiveVtbl const *)( \
-            QF_ACTIVE_CAST((me_))->super.vptr))->postISR)( \
-                QF_ACTIVE_CAST((me_)), (margin_), \
+        (QACTIVE_POST_ISR_OP_((me_))(QF_ACTIVE_CAST((me_)), (margin_), \
                 (enum_t)(sig_), (QParam)(par_)))
 
     /*! Implementation of the task-level event posting */
-    bool QActive_postX_(QActive * const me, uint_fast8_t margin,
+    bool QActive_postX_(QActive * const me, QEQueueIdx margin,
                         enum_t const sig, QParam const par);
 
     /*! Implementation of the ISR-level event posting */
-    bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
+    bool QActive_postXISR_(QActive * const me, QEQueueIdx margin,
                            enum_t const sig, QParam const par);
 
 #else /* no event parameter */
     #define QACTIVE_POST(me_, sig_) \
-        ((void)(*((QActiveVtbl const *)( \
-            QF_ACTIVE_CAST((me_))->super.vptr))->post)( \
-                QF_ACTIVE_CAST((me_)), (uint_fast8_t)0, (enum_t)(sig_)))
+        ((void)QACTIVE_POST_OP_((me_))(QF_ACTIVE_CAST((me_)), \
+                (uint_fast8_t)0, (enum_t)(sig_)))
 
     #define QACTIVE_POST_X(me_, margin_, sig_) \
-        ((*((QActiveVtbl const *)((me_)->super.vptr))->post)((me_), \
-                                   (margin_), (sig_)))
+        (QACTIVE_POST_OP_((me_))(QF_ACTIVE_CAST((me_)), \
+                (margin_), (enum_t)(sig_)))
 
-    bool QActive_postX_(QActive * const me, uint_fast8_t margin,
+    bool QActive_postX_(QActive * const me, QEQueueIdx margin,
                         enum_t const sig);
 
     #define QACTIVE_POST_ISR(me_, sig_) \
-        ((void)(*((QActiveVtbl const*)( \
-            QF_ACTIVE_CAST((me_))->super.vptr))->postISR)( \
-                 QF_ACTIVE_CAST((me_)), (uint_fast8_t)0, (enum_t)(sig_)))
+        ((void)QACTIVE_POST_ISR_OP_((me_))(QF_ACTIVE_CAST((me_)), \
+                (uint_fast8_t)0, (enum_t)(sig_)))
 
     #define QACTIVE_POST_X_ISR(me_, margin_, sig_) \
-        ((*((QActiveVtbl const *)( \
-            QF_ACTIVE_CAST((me_))->super.vptr))->postISR)( \
-                QF_ACTIVE_CAST((me_)), (margin_), (enum_t)(sig_)))
+        (QACTIVE_POST_ISR_OP_((me_))(QF_ACTIVE_CAST((me_)), \
+                (margin_), (enum_t)(sig_)))
 
-    bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
+    bool QActive_postXISR_(QActive * const me, QEQueueIdx margin,
                            enum_t const sig);
 #endif
 
+#if (Q_PARAM_SIZE != 0)
+    /*! Posts an event to the front of the queue of an active object
+    * (LIFO) with delivery guarantee (task context).
+    */
+    /**
+    * @description
+    * The event is inserted at the front of the event queue, so it is
+    * dispatched next, ahead of all the events already waiting in the queue.
+    * This is intended for urgent control events (such as shutdown or error)
+    * that must not wait behind a backlog of data events. This macro asserts
+    * if the queue overflows and cannot accept the event.
+    *
+    * @param[in,out] me_   pointer (see @ref oop)
+    * @param[in]     sig_  signal of the event to post
+    * @param[in]     par_  parameter of the event to post.
+    *
+    * @note
+    * Unlike QACTIVE_POST(), the LIFO posting is not polymorphic and always
+    * calls QActive_postLIFOX_().
+    *
+    * @sa QACTIVE_POST_LIFO_X(), QACTIVE_POST_LIFO_ISR()
+    */
+    #define QACTIVE_POST_LIFO(me_, sig_, par_) \
+        ((void)QActive_postLIFOX_(QF_ACTIVE_CAST((me_)), QF_NO_MARGIN, \
+                (enum_t)(sig_), (QParam)(par_)))
+
+    /*! Posts an event to the front of the queue of an active object
+    * (LIFO) without delivery guarantee (task context).
+    */
+    /**
+    * @description
+    * The same as QACTIVE_POST_LIFO(), but does not assert if the queue
+    * cannot accept the event with the specified margin of free slots
+    * remaining, exactly as QACTIVE_POST_X().
+    *
+    * @returns
+    * 'true' if the posting succeeded, and 'false' if the posting failed
+    * due to insufficient margin of free slots available in the queue.
+    */
+    #define QACTIVE_POST_LIFO_X(me_, margin_, sig_, par_) \
+        (QActive_postLIFOX_(QF_ACTIVE_CAST((me_)), \
+                (margin_), (enum_t)(sig_), (QParam)(par_)))
+
+    /*! Posts an event to the front of the queue of an active object
+    * (LIFO) with delivery guarantee (ISR context).
+    */
+    #define QACTIVE_POST_LIFO_ISR(me_, sig_, par_) \
+        ((void)QActive_postLIFOXISR_(QF_ACTIVE_CAST((me_)), \
+                QF_NO_MARGIN, (enum_t)(sig_), (QParam)(par_)))
+
+    /*! Posts an event to the front of the queue of an active object
+    * (LIFO) without delivery guarantee (ISR context).
+    */
+    #define QACTIVE_POST_LIFO_X_ISR(me_, margin_, sig_, par_) \
+        (QActive_postLIFOXISR_(QF_ACTIVE_CAST((me_)), (margin_), \
+                (enum_t)(sig_), (QParam)(par_)))
+
+    /*! Implementation of the task-level LIFO event posting */
+    bool QActive_postLIFOX_(QActive * const me, QEQueueIdx margin,
+                            enum_t const sig, QParam const par);
+
+    /*! Implementation of the ISR-level LIFO event posting */
+    bool QActive_postLIFOXISR_(QActive * const me, QEQueueIdx margin,
+                               enum_t const sig, QParam const par);
+
+#else /* no event parameter */
+    #define QACTIVE_POST_LIFO(me_, sig_) \
+        ((void)QActive_postLIFOX_(QF_ACTIVE_CAST((me_)), \
+                (uint_fast8_t)0, (enum_t)(sig_)))
+
+    #define QACTIVE_POST_LIFO_X(me_, margin_, sig_) \
+        (QActive_postLIFOX_(QF_ACTIVE_CAST((me_)), \
+                (margin_), (enum_t)(sig_)))
+
+    bool QActive_postLIFOX_(QActive * const me, QEQueueIdx margin,
+                            enum_t const sig);
+
+    #define QACTIVE_POST_LIFO_ISR(me_, sig_) \
+        ((void)QActive_postLIFOXISR_(QF_ACTIVE_CAST((me_)), \
+                (uint_fast8_t)0, (enum_t)(sig_)))
+
+    #define QACTIVE_POST_LIFO_X_ISR(me_, margin_, sig_) \
+        (QActive_postLIFOXISR_(QF_ACTIVE_CAST((me_)), \
+                (margin_), (enum_t)(sig_)))
+
+    bool QActive_postLIFOXISR_(QActive * const me, QEQueueIdx margin,
+                               enum_t const sig);
+#endif
+
+#if (QF_COALESCE_SIZE != 0)
+#if (Q_PARAM_SIZE != 0)
+    /*! Posts the latest value of a signal to an active object, replacing
+    * the event of the same signal still waiting in the queue (task context).
+    */
+    /**
+    * @description
+    * If an event with the signal @p sig_ posted by this macro is still
+    * waiting in the queue, only its parameter is updated in place and the
+    * queue does not grow. Otherwise the event is posted (FIFO) exactly as
+    * by QACTIVE_POST(). This "latest-value" posting is intended for
+    * periodic inputs (such as sensor samples) that can arrive faster than
+    * the active object processes them, where only the most recent value
+    * matters. The coalescing signals must be in the range ::Q_USER_SIG ..
+    * ::Q_USER_SIG + 8*#QF_COALESCE_SIZE - 1. The coalescing signals can
+    * be posted also with QACTIVE_POST(), QACTIVE_POST_LIFO() or recalled,
+    * but such events are queued separately and are never updated.
+    *
+    * @param[in,out] me_   pointer (see @ref oop)
+    * @param[in]     sig_  signal of the event to post
+    * @param[in]     par_  parameter of the event to post.
+    *
+    * @note
+    * Whether an event of the signal is pending is tracked in the ::QPendSet
+    * of the active object together with the ring-buffer slot of that event,
+    * so both the post and the update of a pending event take constant time.
+    *
+    * @sa QACTIVE_POST_LATEST_X(), QACTIVE_POST_LATEST_ISR()
+    */
+    #define QACTIVE_POST_LATEST(me_, sig_, par_) \
+        ((void)QActive_postLatestX_(QF_ACTIVE_CAST((me_)), QF_NO_MARGIN, \
+                (enum_t)(sig_), (QParam)(par_)))
+
+    /*! Posts the latest value of a signal to an active object without
+    * delivery guarantee (task context).
+    */
+    /**
+    * @description
+    * The same as QACTIVE_POST_LATEST(), but does not assert if the queue
+    * cannot accept a new event with the specified margin of free slots
+    * remaining. The update of a pending event always succeeds.
+    *
+    * @returns
+    * 'true' if the posting (or update) succeeded, and 'false' if the posting
+    * failed due to insufficient margin of free slots available in the queue.
+    */
+    #define QACTIVE_POST_LATEST_X(me_, margin_, sig_, par_) \
+        (QActive_postLatestX_(QF_ACTIVE_CAST((me_)), \
+                (margin_), (enum_t)(sig_), (QParam)(par_)))
+
+    /*! Posts the latest value of a signal to an active object
+    * (ISR context).
+    */
+    #define QACTIVE_POST_LATEST_ISR(me_, sig_, par_) \
+        ((void)QActive_postLatestXISR_(QF_ACTIVE_CAST((me_)), \
+                QF_NO_MARGIN, (enum_t)(sig_), (QParam)(par_)))
+
+    /*! Posts the latest value of a signal to an active object without
+    * delivery guarantee (ISR context).
+    */
+    #define QACTIVE_POST_LATEST_X_ISR(me_, margin_, sig_, par_) \
+        (QActive_postLatestXISR_(QF_ACTIVE_CAST((me_)), (margin_), \
+                (enum_t)(sig_), (QParam)(par_)))
+
+    /*! Implementation of the task-level latest-value event posting */
+    bool QActive_postLatestX_(QActive * const me, QEQueueIdx margin,
+                              enum_t const sig, QParam const par);
+
+    /*! Implementation of the ISR-level latest-value event posting */
+    bool QActive_postLatestXISR_(QActive * const me, QEQueueIdx margin,
+                                 enum_t const sig, QParam const par);
+
+#else /* no event parameter */
+    #define QACTIVE_POST_LATEST(me_, sig_) \
+        ((void)QActive_postLatestX_(QF_ACTIVE_CAST((me_)), \
+                QF_NO_MARGIN, (enum_t)(sig_)))
+
+    #define QACTIVE_POST_LATEST_X(me_, margin_, sig_) \
+        (QActive_postLatestX_(QF_ACTIVE_CAST((me_)), \
+                (margin_), (enum_t)(sig_)))
+
+    bool QActive_postLatestX_(QActive * const me, QEQueueIdx margin,
+                              enum_t const sig);
+
+    #define QACTIVE_POST_LATEST_ISR(me_, sig_) \
+        ((void)QActive_postLatestXISR_(QF_ACTIVE_CAST((me_)), \
+                QF_NO_MARGIN, (enum_t)(sig_)))
+
+    #define QACTIVE_POST_LATEST_X_ISR(me_, margin_, sig_) \
+        (QActive_postLatestXISR_(QF_ACTIVE_CAST((me_)), \
+                (margin_), (enum_t)(sig_)))
+
+    bool QActive_postLatestXISR_(QActive * const me, QEQueueIdx margin,
+                                 enum_t const sig);
+#endif
+#endif /* (QF_COALESCE_SIZE != 0) */
+
+/*! Posts a batch of events to an active object (FIFO) with delivery
+* guarantee (task context).
+*/
+/**
+* @description
+* The @p n_ events in the array @p evts_ (of type ::QEvt, with the signals
+* and parameters) are posted in the order of the array under a single
+* critical section. The margin check and the scheduling are performed only
+* once for the whole batch, which is cheaper than posting the events one
+* by one with QACTIVE_POST(). This macro asserts if the queue cannot accept
+* all the events.
+*
+* @param[in,out] me_   pointer (see @ref oop)
+* @param[in]     evts_ array of events to post
+* @param[in]     n_    number of events in the array
+*
+* @note
+* Like QACTIVE_POST_LIFO(), the batch posting is not polymorphic and always
+* calls QActive_postManyX_().
+*
+* @sa QACTIVE_POST_MANY_X(), QACTIVE_POST_MANY_ISR()
+*/
+#define QACTIVE_POST_MANY(me_, evts_, n_) \
+    ((void)QActive_postManyX_(QF_ACTIVE_CAST((me_)), QF_NO_MARGIN, \
+            (evts_), (QEQueueIdx)(n_)))
+
+/*! Posts a batch of events to an active object (FIFO) without delivery
+* guarantee (task context).
+*/
+/**
+* @description
+* The same as QACTIVE_POST_MANY(), but does not assert if the queue cannot
+* accept all the events with the specified margin of free slots remaining.
+* The batch is posted completely or not at all.
+*
+* @returns
+* 'true' if all the events were posted, and 'false' if none was posted due
+* to insufficient margin of free slots available in the queue.
+*/
+#define QACTIVE_POST_MANY_X(me_, margin_, evts_, n_) \
+    (QActive_postManyX_(QF_ACTIVE_CAST((me_)), (margin_), \
+            (evts_), (QEQueueIdx)(n_)))
+
+/*! Posts a batch of events to an active object (FIFO) with delivery
+* guarantee (ISR context).
+*/
+#define QACTIVE_POST_MANY_ISR(me_, evts_, n_) \
+    ((void)QActive_postManyXISR_(QF_ACTIVE_CAST((me_)), QF_NO_MARGIN, \
+            (evts_), (QEQueueIdx)(n_)))
+
+/*! Posts a batch of events to an active object (FIFO) without delivery
+* guarantee (ISR context).
+*/
+#define QACTIVE_POST_MANY_X_ISR(me_, margin_, evts_, n_) \
+    (QActive_postManyXISR_(QF_ACTIVE_CAST((me_)), (margin_), \
+            (evts_), (QEQueueIdx)(n_)))
+
+/*! Implementation of the task-level batch event posting */
+bool QActive_postManyX_(QActive * const me, QEQueueIdx margin,
+                        QEvt const * const evts, QEQueueIdx const n);
+
+/*! Implementation of the ISR-level batch event posting */
+bool QActive_postManyXISR_(QActive * const me, QEQueueIdx margin,
+                           QEvt const * const evts, QEQueueIdx const n);
+
 #if (QF_TIMEEVT_CTR_SIZE != 0)
 
     /*! Processes all armed time events at every clock tick. */
@@ -335,6 +731,85 @@ void QActive_ctor(QActive * const me, QStateHandler initial);
 
 #endif /* (QF_TIMEEVT_CTR_SIZE != 0) */
 
+#ifdef QF_EQUEUE_USAGE
+
+    /*! Obtain the high-water mark of the event queue of an active object */
+    /**
+    * @param[in] me_ pointer (see @ref oop)
+    *
+    * @returns the maximum number of events ever present in the queue ring
+    * buffer of the active object since QF_init() or the last
+    * QActive_resetQueueMax(), not counting the urgent ring buffer.
+    */
+    #define QActive_getQueueMax(me_) \
+        ((QEQueueIdx)QF_ACTIVE_CAST((me_))->nMax)
+
+#ifdef QF_URGENT_QUEUE
+    /*! Obtain the high-water mark of the urgent ring buffer of an AO */
+    /**
+    * @param[in] me_ pointer (see @ref oop)
+    *
+    * @returns the maximum number of events ever present in the urgent ring
+    * buffer of the active object since QF_init() or the last
+    * QActive_resetQueueMax().
+    */
+    #define QActive_getUrgentQueueMax(me_) \
+        ((QEQueueIdx)QF_ACTIVE_CAST((me_))->uMax)
+#endif /* QF_URGENT_QUEUE */
+
+    /*! Reset the high-water mark of the event queue of an active object. */
+    void QActive_resetQueueMax(QActive * const me);
+
+    /*! Report the event queue usage of all active objects. */
+    void QF_reportQueueUsage(void);
+
+    /*! Callback invoked by QF_reportQueueUsage() for every active object. */
+    /**
+    * @description
+    * The callback is invoked once for every entry of QF_active[], in the
+    * order of increasing priority. The application can use the reported
+    * high-water mark @p nMax to size the queue length @p qlen of the
+    * corresponding ::QActiveCB to the measured need.
+    *
+    * @param[in] prio  priority of the active object (1..8)
+    * @param[in] qlen  length of the queue ring buffer from ::QActiveCB
+    * @param[in] nMax  maximum number of events ever present in the queue
+    *                  ring buffer (never more than @p qlen)
+    * @param[in] uqlen length of the urgent ring buffer from ::QActiveCB
+    *                  (only with #QF_URGENT_QUEUE)
+    * @param[in] uMax  maximum number of events ever present in the urgent
+    *                  ring buffer (only with #QF_URGENT_QUEUE)
+    */
+#ifdef QF_URGENT_QUEUE
+    void QF_onQueueUsage(uint_fast8_t const prio, QEQueueIdx const qlen,
+                         QEQueueIdx const nMax, QEQueueIdx const uqlen,
+                         QEQueueIdx const uMax);
+#else
+    void QF_onQueueUsage(uint_fast8_t const prio, QEQueueIdx const qlen,
+                         QEQueueIdx const nMax);
+#endif /* QF_URGENT_QUEUE */
+
+#endif /* QF_EQUEUE_USAGE */
+
+#ifdef QF_DEFER
+
+    /*! Defers the current event of an active object for later recall. */
+    bool QActive_defer(QActive * const me);
+
+    /*! Recalls the oldest deferred event to the front of the queue. */
+    bool QActive_recall(QActive * const me);
+
+    /*! Obtain the number of events currently deferred by an active object */
+    /**
+    * @param[in] me_ pointer (see @ref oop)
+    *
+    * @returns the number of events in the deferral ring buffer
+    */
+    #define QActive_getDeferred(me_) \
+        ((QEQueueIdx)QF_ACTIVE_CAST((me_))->dUsed)
+
+#endif /* QF_DEFER */
+
 
 /****************************************************************************/
 /* QF-nano protected methods ...*/
@@ -380,9 +855,23 @@ int_t QF_run(void);
 * @include qfn_main.c
 */
 typedef struct {
-    QActive  *act;   /*!< pointer to the active object structure */
-    QEvt     *queue; /*!< pointer to the event queue buffer */
-    uint8_t   qlen;  /*!< the length of the queue ring buffer */
+    QActive    *act;   /*!< pointer to the active object structure */
+#ifndef QF_SPLIT_QUEUE
+    QEvt       *queue; /*!< pointer to the event queue buffer */
+#else
+    QSignal    *qsig;  /*!< pointer to the signals of the queue buffer */
+    QParam     *qpar;  /*!< pointer to the parameters of the queue buffer */
+#endif /* QF_SPLIT_QUEUE */
+    QEQueueCtr  qlen;  /*!< the length of the queue ring buffer */
+#ifdef QF_DEFER
+    QEvt       *defer; /*!< pointer to the deferral buffer (or NULL) */
+    QEQueueCtr  dlen;  /*!< the length of the deferral ring buffer (or 0) */
+#endif /* QF_DEFER */
+#ifdef QF_URGENT_QUEUE
+    QEvt       *uqueue; /*!< pointer to the urgent queue buffer (or NULL) */
+    QEQueueCtr  uqlen; /*!< the length of the urgent ring buffer (or 0) */
+    QSignal     usig;  /*!< signals below usig are urgent (0 for none) */
+#endif /* QF_URGENT_QUEUE */
 } QActiveCB;
 
 /** active object control blocks */
@@ -390,6 +879,80 @@ typedef struct {
 extern QActiveCB const Q_ROM QF_active[];
 /*lint -restore */
 
+#ifndef QF_SPLIT_QUEUE
+
+/*! Initializers of the ::QActiveCB entries of an array of active objects */
+/**
+* @description
+* QF_ACTIVE_ARRAY() expands to @p n_ consecutive initializers of
+* ::QActiveCB, one for every active object @p aos_[0] .. @p aos_[n_ - 1]
+* with its own event queue @p queues_[0] .. @p queues_[n_ - 1]. All
+* instances of the array share the same state-handler functions and get
+* consecutive priorities, so that each instance can find its index in
+* the array with QACTIVE_INDEX(). The deferral and urgent ring buffers
+* (if configured) of the instances are not used.
+*
+* @param[in] n_      the number of instances (integer literal 1..8, or
+*                    a macro expanding to such a literal)
+* @param[in] aos_    the array of the active objects
+* @param[in] queues_ the two-dimensional array of the event queue buffers
+*
+* @usage
+* @code
+* static QEvt l_philoQueue[N_PHILO][N_PHILO];
+*
+* QActiveCB const Q_ROM QF_active[] = {
+*     { (QActive *)0,        (QEvt *)0,    0U                  },
+*     QF_ACTIVE_ARRAY(N_PHILO, AO_Philo, l_philoQueue),
+*     { (QActive *)&AO_Table, l_tableQueue, Q_DIM(l_tableQueue) }
+* };
+* @endcode
+*/
+#define QF_ACTIVE_ARRAY(n_, aos_, queues_) \
+    QF_ACTIVE_ARRAY_X_(n_, aos_, queues_)
+
+/*! helper macro to expand @p n_ before it is pasted */
+#define QF_ACTIVE_ARRAY_X_(n_, aos_, queues_) \
+    QF_ACTIVE_ARRAY_##n_##_((aos_), (queues_))
+
+/*! initializer of the ::QActiveCB of the instance @p i_ of an array */
+#define QF_ACTIVE_ARRAY_CB_(aos_, queues_, i_) \
+    { QF_ACTIVE_CAST(&(aos_)[(i_)]), &(queues_)[(i_)][0], \
+      (QEQueueCtr)Q_DIM((queues_)[(i_)]) }
+
+#define QF_ACTIVE_ARRAY_1_(a_, q_) QF_ACTIVE_ARRAY_CB_(a_, q_, 0)
+#define QF_ACTIVE_ARRAY_2_(a_, q_) \
+    QF_ACTIVE_ARRAY_1_(a_, q_), QF_ACTIVE_ARRAY_CB_(a_, q_, 1)
+#define QF_ACTIVE_ARRAY_3_(a_, q_) \
+    QF_ACTIVE_ARRAY_2_(a_, q_), QF_ACTIVE_ARRAY_CB_(a_, q_, 2)
+#define QF_ACTIVE_ARRAY_4_(a_, q_) \
+    QF_ACTIVE_ARRAY_3_(a_, q_), QF_ACTIVE_ARRAY_CB_(a_, q_, 3)
+#define QF_ACTIVE_ARRAY_5_(a_, q_) \
+    QF_ACTIVE_ARRAY_4_(a_, q_), QF_ACTIVE_ARRAY_CB_(a_, q_, 4)
+#define QF_ACTIVE_ARRAY_6_(a_, q_) \
+    QF_ACTIVE_ARRAY_5_(a_, q_), QF_ACTIVE_ARRAY_CB_(a_, q_, 5)
+#define QF_ACTIVE_ARRAY_7_(a_, q_) \
+    QF_ACTIVE_ARRAY_6_(a_, q_), QF_ACTIVE_ARRAY_CB_(a_, q_, 6)
+#define QF_ACTIVE_ARRAY_8_(a_, q_) \
+    QF_ACTIVE_ARRAY_7_(a_, q_), QF_ACTIVE_ARRAY_CB_(a_, q_, 7)
+
+#endif /* QF_SPLIT_QUEUE */
+
+/*! The index of the active object @p me_ in the array @p aos_ */
+/**
+* @description
+* The instances of an array of active objects registered with
+* QF_ACTIVE_ARRAY() have consecutive priorities, so the index of an
+* instance is its priority relative to the first element of the array.
+* The index is available after QF_init() (which assigns the priorities
+* of all active objects in QF_active[]) and can be used, for example,
+* as the event parameter that identifies the instance to the other
+* active objects, which then address the instance as @p aos_[index].
+*/
+#define QACTIVE_INDEX(me_, aos_) \
+    ((uint_fast8_t)(QF_ACTIVE_CAST((me_))->prio \
+                    - QF_ACTIVE_CAST(&(aos_)[0])->prio))
+
 /*! number of active objects in the application (# elements in QF_active[]) */
 extern uint_fast8_t QF_maxActive_;
 
@@ -424,8 +987,93 @@ extern uint8_t const Q_ROM QF_invPow2Lkup[9];
 * given index, which violates MISRA-C 2004 rules 17.4(req) and 11.4(adv).
 * This macro helps to localize this deviation.
 */
+#ifndef QF_SPLIT_QUEUE
 #define QF_ROM_QUEUE_AT_(ao_, i_) (((QEvt *)Q_ROM_PTR((ao_)->queue))[(i_)])
 
+/*! the signal of the event in the active object queue at a given index */
+#define QF_ROM_QSIG_AT_(ao_, i_)  (QF_ROM_QUEUE_AT_((ao_), (i_)).sig)
+
+/*! the parameter of the event in the active object queue at a given index */
+#define QF_ROM_QPAR_AT_(ao_, i_)  (QF_ROM_QUEUE_AT_((ao_), (i_)).par)
+
+/*! copies the event @p e_ into the active object queue at a given index */
+#define QF_ROM_QUEUE_PUT_(ao_, i_, e_) \
+    (QF_ROM_QUEUE_AT_((ao_), (i_)) = (e_))
+
+#else /* separate signal and parameter arrays of the queue */
+
+#if (Q_PARAM_SIZE == 0)
+    #error "QF_SPLIT_QUEUE requires event parameters (Q_PARAM_SIZE != 0)"
+#endif
+
+#define QF_ROM_QSIG_AT_(ao_, i_) \
+    (((QSignal *)Q_ROM_PTR((ao_)->qsig))[(i_)])
+#define QF_ROM_QPAR_AT_(ao_, i_) \
+    (((QParam *)Q_ROM_PTR((ao_)->qpar))[(i_)])
+#define QF_ROM_QUEUE_PUT_(ao_, i_, e_) do { \
+    QF_ROM_QSIG_AT_((ao_), (i_)) = (e_).sig; \
+    QF_ROM_QPAR_AT_((ao_), (i_)) = (e_).par; \
+} while (false)
+
+#endif /* QF_SPLIT_QUEUE */
+
+#ifdef QF_DEFER
+/*! This macro encapsulates accessing the deferral ring buffer of an active
+* object at a given index, the same deviation as QF_ROM_QUEUE_AT_().
+*/
+#define QF_ROM_DEFER_AT_(ao_, i_) (((QEvt *)Q_ROM_PTR((ao_)->defer))[(i_)])
+#endif /* QF_DEFER */
+
+#ifdef QF_URGENT_QUEUE
+/*! This macro encapsulates accessing the urgent ring buffer of an active
+* object at a given index, the same deviation as QF_ROM_QUEUE_AT_().
+*/
+#define QF_ROM_UQUEUE_AT_(ao_, i_) \
+    (((QEvt *)Q_ROM_PTR((ao_)->uqueue))[(i_)])
+
+/*! This macro tests whether the signal @p sig_ is urgent for the active
+* object of the control block @p ao_ (internal use only)
+*/
+#define QF_IS_URGENT_SIG_(ao_, sig_) \
+    ((QSignal)(sig_) < Q_ROM_SIG((ao_)->usig))
+
+/*! number of events in the normal ring buffer of an active object */
+#define QF_NORMAL_USED_(me_) \
+    ((QEQueueIdx)((QEQueueIdx)(me_)->nUsed - (QEQueueIdx)(me_)->uUsed))
+#else
+#define QF_NORMAL_USED_(me_) ((QEQueueIdx)(me_)->nUsed)
+#endif /* QF_URGENT_QUEUE */
+
+#if (QF_COALESCE_SIZE != 0)
+/*! This macro tests whether the signal @p sig_ has a bit in ::QPendSet
+* (internal use only)
+*/
+#define QF_IS_COALESCE_SIG_(sig_) \
+    ((QSignal)((QSignal)(sig_) - (QSignal)Q_USER_SIG) \
+     < (QSignal)(8U * QF_COALESCE_SIZE))
+
+/*! the bit number of the coalescing signal @p sig_ in ::QPendSet */
+#define QF_COALESCE_POS_(sig_) \
+    ((uint_fast8_t)((QSignal)(sig_) - (QSignal)Q_USER_SIG))
+
+/*! the bit of the coalescing signal @p sig_ in ::QPendSet */
+#define QF_COALESCE_BIT_(sig_) \
+    ((QPendSet)((QPendSet)1U << QF_COALESCE_POS_(sig_)))
+
+/*! This macro clears the pending bit of the signal @p sig_ taken from the
+* ring-buffer slot @p at_ of the active object @p me_, but only if it is
+* the event waiting there since QActive_postLatestX_(). Must be called
+* inside a critical section, before the slot is released.
+*/
+#define QF_COALESCE_CLR_(me_, sig_, at_) do { \
+    if (QF_IS_COALESCE_SIG_(sig_) \
+        && ((me_)->pendAt[QF_COALESCE_POS_(sig_)] == (at_))) \
+    { \
+        (me_)->pend &= (QPendSet)~QF_COALESCE_BIT_(sig_); \
+    } \
+} while (false)
+#endif /* (QF_COALESCE_SIZE != 0) */
+
 /*! This macro encapsulates accessing the active object control block,
 * which violates MISRA-C 2004 rule 11.4(adv). This macro helps to localize
 * this deviation.
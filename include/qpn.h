@@ -51,6 +51,7 @@ extern "C" {
 
 #include "qpn_conf.h" /* QP-nano configuration file (from the application) */
 #include "qfn_port.h" /* QF-nano port from the port directory */
+#include "qsn.h"      /* QS-nano software tracing interface */
 #include "qassert.h"  /* embedded systems-friendly assertions */
 
 
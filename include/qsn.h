@@ -0,0 +1,371 @@
+/**
+* @file
+* @brief Public QS-nano interface (binary software tracing).
+* @ingroup qsn
+* @cond
+******************************************************************************
+* Last updated for version 6.0.4
+* Last updated on  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* https://state-machine.com
+* mailto:info@state-machine.com
+******************************************************************************
+* @endcond
+*/
+#ifndef qsn_h
+#define qsn_h
+
+/**
+* @description
+* QS-nano is a small binary software tracing facility for QP-nano. When the
+* macro #Q_SPY is defined, the QP-nano sources produce compact binary trace
+* records into a ring buffer, from which the application drains the data
+* (e.g., in the idle callback) and sends it to the host. When the macro
+* #Q_SPY is __not__ defined, all QS-nano instrumentation compiles away to
+* nothing.
+*
+* Every trace record has the following format:
+*
+* @verbatim
+* +--------+--------+----------------+---------------------------------+
+* | rec ID | seq #  | time delta     | record-specific payload ...     |
+* | 1 byte | 1 byte | var-len (1..5) | (var-len integers, bytes, str)  |
+* +--------+--------+----------------+---------------------------------+
+* @endverbatim
+*
+* All multi-byte integers are encoded as variable-length quantities with
+* 7 bits per byte, least-significant group first, where the most
+* significant bit of every byte indicates that more bytes follow. State
+* handlers and objects are encoded as zig-zag variable-length offsets
+* from a fixed reference address (::QHsm_top for functions and
+* ::QS_priv_ for objects), which keeps them short and unique within
+* a given executable.
+*/
+
+#ifndef QS_TIME_SIZE
+    /*! The size (in bytes) of the QS-nano time stamp. Valid values: 2, 4;
+    * default 4.
+    */
+    #define QS_TIME_SIZE 4
+#endif
+#if (QS_TIME_SIZE == 2)
+    typedef uint16_t QSTimeCtr;
+#elif (QS_TIME_SIZE == 4)
+    /*! The type of the QS-nano time stamp. */
+    /**
+    * @description
+    * This typedef is configurable via the preprocessor switch #QS_TIME_SIZE.
+    * The other possible values of this type are as follows: @n
+    * uint16_t when (QS_TIME_SIZE == 2); and @n
+    * uint32_t when (QS_TIME_SIZE == 4).
+    */
+    typedef uint32_t QSTimeCtr;
+#else
+    #error "QS_TIME_SIZE defined incorrectly, expected 2 or 4"
+#endif
+
+/****************************************************************************/
+/*! QS-nano pre-defined record types */
+/**
+* @description
+* The record type is the first byte of every trace record. The payload
+* of each record is listed next to the record type.
+*/
+enum QSpyRecords {
+    /* [0] QS-nano session (not maskable) */
+    QS_EMPTY,            /*!< empty record (never produced) */
+    QS_TARGET_INFO,      /*!< configuration of the target */
+
+    /* [2] QEP-nano records */
+    QS_QEP_STATE_ENTRY,  /*!< a state was entered: obj, state */
+    QS_QEP_STATE_EXIT,   /*!< a state was exited: obj, state */
+    QS_QEP_STATE_INIT,   /*!< nested initial transition: obj, src, trg */
+    QS_QEP_INIT_TRAN,    /*!< top-most initial transition: obj, trg */
+    QS_QEP_DISPATCH,     /*!< begin of an RTC step: obj, sig, state */
+    QS_QEP_TRAN,         /*!< end of RTC step, transition: obj, src, trg */
+    QS_QEP_INTERN_TRAN,  /*!< end of RTC step, internal tran: obj, state */
+    QS_QEP_IGNORED,      /*!< end of RTC step, event ignored: obj, state */
+
+    /* [10] QF-nano records */
+    QS_QF_ACTIVE_ADD,    /*!< AO registered: prio, obj */
+    QS_QF_ACTIVE_POST,   /*!< post (task): prio, sig, [par], nUsed */
+    QS_QF_ACTIVE_POST_ISR, /*!< post (ISR): prio, sig, [par], nUsed */
+    QS_QF_ACTIVE_POST_ATTEMPT, /*!< failed post: prio, sig, [par], nUsed */
+    QS_QF_ACTIVE_GET,    /*!< event taken from a queue: prio, sig, nUsed */
+    QS_QF_TICK,          /*!< QF_tickXISR() called: tickRate */
+    QS_QF_TIMEEVT_POST,  /*!< time event expired: prio, tickRate */
+
+    /* [17] dictionaries (not maskable) */
+    QS_SIG_DICT,         /*!< signal dictionary: sig, obj, name */
+    QS_OBJ_DICT,         /*!< object dictionary: obj, name */
+    QS_FUN_DICT,         /*!< function dictionary: fun, name */
+
+    /* [20] QF-nano event deferral records */
+    QS_QF_ACTIVE_DEFER,  /*!< event deferred: prio, sig, [par], dUsed */
+    QS_QF_ACTIVE_DEFER_ATTEMPT, /*!< failed defer: prio, sig, [par], dUsed */
+    QS_QF_ACTIVE_RECALL, /*!< event recalled: prio, sig, [par], nUsed */
+
+    /* [23] QF-nano LIFO posting */
+    QS_QF_ACTIVE_POST_LIFO, /*!< LIFO post: prio, sig, [par], nUsed */
+
+    /* [24] QF-nano coalescing posts */
+    QS_QF_ACTIVE_COALESCE, /*!< coalesced post: prio, sig, [par], nUsed */
+
+    /* [25] user records */
+    QS_USER = 25         /*!< the first record available to QS users */
+};
+
+#ifndef QS_FILTER
+    /*! The compile-time global filter of QS-nano records. */
+    /**
+    * @description
+    * Each bit in QS_FILTER corresponds to one record type from
+    * ::QSpyRecords. The records with cleared bits are eliminated from the
+    * code at compile time. The session and dictionary records cannot be
+    * filtered out. The default is to produce all records.
+    *
+    * @usage
+    * The following QS_FILTER produces only the records needed to measure
+    * the RTC steps of the active objects:
+    * @code
+    * #define QS_FILTER  ((1UL << QS_QEP_DISPATCH) \
+    *                     | (1UL << QS_QEP_TRAN) \
+    *                     | (1UL << QS_QEP_INTERN_TRAN) \
+    *                     | (1UL << QS_QEP_IGNORED))
+    * @endcode
+    */
+    #define QS_FILTER 0xFFFFFFFFUL
+#endif
+
+/*! The value returned from QS_getByte() when the buffer is empty */
+#define QS_EOD ((uint16_t)0xFFFFU)
+
+
+/****************************************************************************/
+#ifdef Q_SPY
+
+/*! The type of the index into the QS-nano ring buffer */
+typedef uint16_t QSCtr;
+
+/*! Private QS-nano attributes */
+/**
+* @description
+* The ring buffer is lock-free between the single producer (the QP-nano
+* code running inside critical sections) and the single consumer (the
+* application code draining the buffer). The producer is the only writer
+* of @c head and the consumer is the only writer of @c tail and @c rd.
+* Records are first written at the tentative position @c wr, and become
+* visible to the consumer only when @c head is advanced after the complete
+* record has been written. Records that do not fit into the buffer are dropped as
+* a whole and counted in @c dropped.
+*/
+typedef struct {
+    uint8_t *buf;         /*!< pointer to the start of the ring buffer */
+    QSCtr end;            /*!< size of the ring buffer */
+    QSCtr volatile head;  /*!< end of the last committed record */
+    QSCtr volatile tail;  /*!< start of the data not yet freed */
+    QSCtr rd;             /*!< offset of the next byte to extract */
+    QSCtr wr;             /*!< write position within the current record */
+    uint8_t seq;          /*!< sequence number of the next record */
+    uint8_t ovf;          /*!< the current record overflowed the buffer */
+    QSTimeCtr lastTime;   /*!< time stamp of the last committed record */
+    QSTimeCtr time;       /*!< time stamp of the current record */
+    uint16_t dropped;     /*!< number of records dropped due to overflow */
+} QSPriv;
+
+/*! the only instance of the QS-nano private attributes */
+extern QSPriv QS_priv_;
+
+/*! Initialize the QS-nano ring buffer. */
+void QS_initBuf(uint8_t sto[], uint_fast16_t const stoSize);
+
+/*! Obtain one byte from the QS-nano ring buffer. */
+uint16_t QS_getByte(void);
+
+/*! Obtain a contiguous block of data from the QS-nano ring buffer. */
+uint8_t const *QS_getBlock(uint16_t * const pNbytes);
+
+/*! Callback to obtain the time stamp for the QS-nano records. */
+/**
+* @description
+* The application must provide this callback when #Q_SPY is defined.
+* The callback is invoked inside critical sections and must be fast.
+* The time stamps only need to be monotonic; the unit is up to the
+* application (e.g., CPU cycles, microseconds, or clock ticks).
+*/
+QSTimeCtr QS_onGetTime(void);
+
+/* internal QS-nano functions for producing trace records */
+void QS_beginRec_(uint_fast8_t const rec);
+void QS_endRec_(void);
+void QS_u8_(uint8_t const d);
+void QS_uvar_(uint32_t d);
+void QS_fun_(QStateHandler const fun);
+void QS_obj_(void const * const obj);
+void QS_str_(char_t const *s);
+void QS_sigDict_(enum_t const sig, void const * const obj,
+                 char_t const *name);
+void QS_objDict_(void const * const obj, char_t const *name);
+void QS_objArrDict_(void const * const obj, uint_fast16_t const idx,
+                    char_t const *name);
+void QS_funDict_(QStateHandler const fun, char_t const *name);
+
+#ifndef QS_MEM_BARRIER
+    /*! Memory barrier between writing the data and publishing the index */
+    /**
+    * @description
+    * On single-core MCUs the barrier is not needed. Ports where the
+    * producer and the consumer can run on different CPU cores must define
+    * QS_MEM_BARRIER() in the qfn_port.h header file.
+    */
+    #define QS_MEM_BARRIER() ((void)0)
+#endif
+
+/*! Check the compile-time filter for a given record type */
+#define QS_FILTER_ON_(rec_) \
+    ((QS_FILTER & ((uint32_t)1 << (uint_fast8_t)(rec_))) != (uint32_t)0)
+
+/*! Begin a QS-nano record without entering a critical section. */
+#define QS_BEGIN_NOCRIT_(rec_) \
+    if (QS_FILTER_ON_(rec_)) { \
+        QS_beginRec_((uint_fast8_t)(rec_));
+
+/*! End a QS-nano record without exiting a critical section. */
+#define QS_END_NOCRIT_() \
+        QS_endRec_(); \
+    }
+
+/*! Begin a QS-nano record inside a critical section. */
+#define QS_BEGIN_(rec_) \
+    if (QS_FILTER_ON_(rec_)) { \
+        QF_INT_DISABLE(); \
+        QS_beginRec_((uint_fast8_t)(rec_));
+
+/*! End a QS-nano record and exit the critical section. */
+#define QS_END_() \
+        QS_endRec_(); \
+        QF_INT_ENABLE(); \
+    }
+
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    /*! Begin a QS-nano record at the ISR level (nesting of ISRs allowed) */
+    #define QS_BEGIN_ISR_(rec_) \
+        if (QS_FILTER_ON_(rec_)) { \
+            QF_ISR_STAT_TYPE qs_stat_; \
+            QF_ISR_DISABLE(qs_stat_); \
+            QS_beginRec_((uint_fast8_t)(rec_));
+
+    /*! End a QS-nano record at the ISR level (nesting of ISRs allowed) */
+    #define QS_END_ISR_() \
+            QS_endRec_(); \
+            QF_ISR_RESTORE(qs_stat_); \
+        }
+#else
+    #define QS_BEGIN_ISR_(rec_) QS_BEGIN_(rec_)
+    #define QS_END_ISR_()       QS_END_()
+#endif /* QF_ISR_STAT_TYPE */
+#else /* ISRs cannot nest, so they already run in a critical section */
+    #define QS_BEGIN_ISR_(rec_) QS_BEGIN_NOCRIT_(rec_)
+    #define QS_END_ISR_()       QS_END_NOCRIT_()
+#endif /* QF_ISR_NEST */
+
+/*! Output a byte to the current QS-nano record */
+#define QS_U8_(d_)     (QS_u8_((uint8_t)(d_)))
+
+/*! Output an unsigned variable-length integer to the current record */
+#define QS_UVAR_(d_)   (QS_uvar_((uint32_t)(d_)))
+
+/*! Output an event queue counter to the current QS-nano record */
+#if (QF_EQUEUE_CTR_SIZE == 1)
+    #define QS_EQC_(ctr_) (QS_u8_((uint8_t)(ctr_)))
+#else
+    #define QS_EQC_(ctr_) (QS_uvar_((uint32_t)(ctr_)))
+#endif
+
+/*! Output an event signal to the current QS-nano record */
+#define QS_SIG_(sig_)  (QS_uvar_((uint32_t)(sig_)))
+
+/*! Output an event parameter to the current QS-nano record */
+#define QS_PAR_(par_)  (QS_uvar_((uint32_t)(par_)))
+
+/*! Output a state-handler function to the current QS-nano record */
+#define QS_FUN_(fun_)  (QS_fun_(Q_STATE_CAST(fun_)))
+
+/*! Output an object pointer to the current QS-nano record */
+#define QS_OBJ_(obj_)  (QS_obj_((obj_)))
+
+/*! Produce a signal dictionary record */
+/**
+* @param[in] sig_  signal (enumerated constant)
+* @param[in] obj_  pointer to the object associated with the signal, or
+*                  zero for signals that are global in the application
+*/
+#define QS_SIG_DICTIONARY(sig_, obj_) \
+    (QS_sigDict_((enum_t)(sig_), (obj_), #sig_))
+
+/*! Produce an object dictionary record */
+#define QS_OBJ_DICTIONARY(obj_) \
+    (QS_objDict_((obj_), #obj_))
+
+/*! Produce an object dictionary record for an element of an array */
+/**
+* @param[in] arr_  array of objects, such as an array of active objects
+* @param[in] idx_  index of the element, which becomes part of the name,
+*                  so the dictionary can be produced in a loop
+*/
+#define QS_OBJ_ARR_DICTIONARY(arr_, idx_) \
+    (QS_objArrDict_(&(arr_)[(idx_)], (uint_fast16_t)(idx_), #arr_))
+
+/*! Produce a function (state-handler) dictionary record */
+#define QS_FUN_DICTIONARY(fun_) \
+    (QS_funDict_(Q_STATE_CAST(fun_), #fun_))
+
+#else /* Q_SPY not defined, all QS-nano instrumentation compiles away */
+
+#define QS_BEGIN_NOCRIT_(rec_)        if (false) {
+#define QS_END_NOCRIT_()              }
+#define QS_BEGIN_(rec_)               if (false) {
+#define QS_END_()                     }
+#define QS_BEGIN_ISR_(rec_)           if (false) {
+#define QS_END_ISR_()                 }
+#define QS_U8_(d_)                    ((void)0)
+#define QS_UVAR_(d_)                  ((void)0)
+#define QS_EQC_(ctr_)                 ((void)0)
+#define QS_SIG_(sig_)                 ((void)0)
+#define QS_PAR_(par_)                 ((void)0)
+#define QS_FUN_(fun_)                 ((void)0)
+#define QS_OBJ_(obj_)                 ((void)0)
+#define QS_SIG_DICTIONARY(sig_, obj_) ((void)0)
+#define QS_OBJ_DICTIONARY(obj_)       ((void)0)
+#define QS_OBJ_ARR_DICTIONARY(arr_, idx_) ((void)0)
+#define QS_FUN_DICTIONARY(fun_)       ((void)0)
+
+#endif /* Q_SPY */
+
+#endif /* qsn_h */
@@ -54,6 +54,21 @@
 */
 #define Q_PARAM_SIZE            4
 
+/*! The size (in bytes) of the signal representation in the QEvent struct.
+* Valid values: 1, 2, or 4; default 1.
+*/
+/**
+* \description
+* This macro can be defined in the QP-nano port header file qpn_port.h to
+* configure the signal of Events. If the macro is not defined, the default
+* of 1 byte (up to 256 signals) will be chosen. The valid Q_SIGNAL_SIZE
+* values of 1, 2, or 4, correspond to signals of uint8_t, uint16_t, and
+* uint32_t, respectively.
+*
+* \sa ::QSignal, #Q_SIG()
+*/
+#define Q_SIGNAL_SIZE           2
+
 /*! The size (in bytes) of the time event-counter representation in
 * the QActive struct. Valid values: none (0), 1, 2, or 4; default none (0).
 */
@@ -71,6 +86,22 @@
 */
 #define QF_TIMEEVT_CTR_SIZE     2
 
+/*! The size (in bytes) of the event queue indexes and counters in the
+* QActive struct and the queue lengths in QActiveCB. Valid values: 1 or 2;
+* default 1.
+*/
+/**
+* \description
+* This macro can be defined in the QP-nano port header file qpn_port.h to
+* configure the event queue counters. If the macro is not defined, the
+* default of 1 byte will be chosen, which limits every ring buffer of an
+* active object to 255 events. The value of 2 selects uint16_t counters for
+* ring buffers of up to 65535 events.
+*
+* \sa ::QEQueueCtr, #QF_NO_MARGIN
+*/
+#define QF_EQUEUE_CTR_SIZE      1
+
 /*! Configuration switch to enable/disable periodic time events. */
 /**
 * \description
@@ -100,6 +131,154 @@ usage. */
 */
 #define QF_TIMEEVT_USAGE
 
+/*! Configuration switch to enable/disable keeping track of the QF event
+queue usage. */
+/**
+* \description
+* When the macro QF_EQUEUE_USAGE is defined, every ::QActive keeps the
+* high-water mark of its event queue, which is updated in every
+* QActive_postX_() and QActive_postXISR_(). The high-water mark can be
+* obtained with QActive_getQueueMax(), reset with QActive_resetQueueMax(),
+* and reported for all active objects in QF_active[] with
+* QF_reportQueueUsage(). This allows sizing of the queue buffers in
+* ::QActiveCB to the measured need.
+*/
+#define QF_EQUEUE_USAGE
+
+/*! Configuration switch to disable the virtual functions of QHsm and
+QActive. */
+/**
+* \description
+* When the macro QF_NO_VIRTUAL is defined, ::QHsm has no virtual pointer,
+* and QHSM_INIT(), QHSM_DISPATCH(), QACTIVE_POST() and its variants call
+* QHsm_init_(), QHsm_dispatch_(), QActive_postX_() and QActive_postXISR_()
+* directly instead of through the virtual tables. This saves the virtual
+* pointer in every state machine and active object, and an indirect call
+* for every event, but the application cannot override these operations.@n
+* @n
+* The switch is not defined here, so that the virtual calls are checked.
+*/
+/* #define QF_NO_VIRTUAL */
+
+/*! Configuration switch to enable the native state history of QEP-nano. */
+/**
+* \description
+* When the macro QHSM_HISTORY is defined, every ::QHsm has a list of
+* history slots (::QHsmHist) registered with QHsm_addHist(). QEP-nano
+* updates the slot of a composite state automatically whenever the state
+* is exited, and Q_TRAN_HIST_SHALLOW() and Q_TRAN_HIST_DEEP() restore the
+* stored substates directly. This costs one pointer in every ::QHsm.
+*/
+#define QHSM_HISTORY
+
+/*! Configuration switch to enable the submachines of QEP-nano. */
+/**
+* \description
+* When the macro QHSM_SUBMACHINE is defined, the state handlers of a
+* submachine can be reused in several submachine states of the same HSM.
+* The top-level states of the submachine designate their superstate with
+* Q_SUPER_SUB(), the submachine states are entered through the entry points
+* with Q_TRAN_EP(), and the submachine leaves through the exit points with
+* Q_TRAN_XP(). This costs two state-handler pointers in every ::QHsm.
+*/
+#define QHSM_SUBMACHINE
+
+/*! The size (in bytes) of the masks of signals handled by the states of
+* QEP-nano. Valid values: none (0), 1, 2, or 4; default none (0).
+*/
+/**
+* \description
+* This macro can be defined in the QP-nano port header file qpn_port.h to
+* enable the tables of handled signals registered with QHSM_SET_MASKS().
+* The valid QHSM_SIG_MASK_SIZE values of 1, 2, or 4, allow to filter 8, 16,
+* or 32 signals starting with ::Q_TIMEOUT_SIG, respectively. QEP-nano then
+* discards the events that no state of the active configuration handles
+* without calling any state handler, which costs one table pointer and one
+* mask in every ::QHsm.
+*
+* \sa ::QSigMask, ::QHsmMask
+*/
+#define QHSM_SIG_MASK_SIZE      4
+
+/*! Configuration switch to enable the native event deferral of QF-nano. */
+/**
+* \description
+* When the macro QF_DEFER is defined, every active object can defer the
+* current event with QActive_defer() and later recall it with
+* QActive_recall(). The deferred events are copied into the deferral ring
+* buffer specified by the @c defer and @c dlen members of ::QActiveCB
+* (an active object that never defers can specify a NULL buffer of length
+* 0). A recalled event is inserted at the front of the event queue, so it
+* is processed before any other events already waiting in the queue.
+*/
+#define QF_DEFER
+
+/*! Configuration switch to enable the urgent event queues of QF-nano. */
+/**
+* \description
+* When the macro QF_URGENT_QUEUE is defined, every active object has a
+* second (urgent) ring buffer specified by the @c uqueue and @c uqlen
+* members of ::QActiveCB. The events with signals below the @c usig member
+* of ::QActiveCB are posted to the urgent ring buffer and the QF-nano
+* kernels always dispatch them before the events in the normal queue.
+* The margin and #QF_NO_MARGIN rules apply to each ring buffer separately.
+* An active object without urgent events specifies a NULL buffer of
+* length 0 and @c usig of 0.
+*/
+#define QF_URGENT_QUEUE
+
+/*! Configuration switch to split the event queues into separate arrays
+* of signals and parameters.
+*/
+/**
+* \description
+* When the macro QF_SPLIT_QUEUE is defined, the event queue of every active
+* object is specified by the @c qsig and @c qpar members of ::QActiveCB
+* (two arrays of @c qlen signals and parameters) instead of the @c queue
+* array of ::QEvt. This avoids the padding of ::QEvt, which is significant
+* for a small ::QSignal with a large ::QParam, for example 3 bytes of every
+* 8-byte event with Q_PARAM_SIZE of 4. The urgent and deferral ring buffers
+* still hold ::QEvt. QF_SPLIT_QUEUE requires Q_PARAM_SIZE other than 0.
+*/
+/* #define QF_SPLIT_QUEUE */
+
+/*! The size (in bytes) of the set of pending coalescing signals in
+* the QActive struct. Valid values: none (0), 1, 2, or 4; default none (0).
+*/
+/**
+* \description
+* This macro can be defined in the QP-nano port header file qpn_port.h to
+* enable the latest-value posting with QACTIVE_POST_LATEST(). The valid
+* QF_COALESCE_SIZE values of 1, 2, or 4, allow 8, 16, or 32 coalescing
+* signals starting with ::Q_USER_SIG, respectively. An event posted this
+* way replaces the event of the same signal still waiting in the queue
+* instead of being appended to the queue.
+*
+* \sa #QPendSet
+*/
+#define QF_COALESCE_SIZE        1
+
+/*! The size (in bytes) of the QS-nano time stamp. Valid values: 2 or 4;
+* default 4.
+*/
+/**
+* \description
+* This macro can be defined in the QP-nano port file (qpn_port.h) to
+* configure the ::QSTimeCtr type. The time stamps are transmitted as
+* variable-length deltas, so the larger size does not increase the
+* size of the trace records significantly.
+*/
+#define QS_TIME_SIZE 4
+
+/*! The compile-time filter of QS-nano trace records. */
+/**
+* \description
+* Each bit in QS_FILTER corresponds to one record type from
+* ::QSpyRecords. Records filtered out at compile time do not generate
+* any code. The default is to produce all records.
+*/
+#define QS_FILTER 0xFFFFFFFFUL
+
 /*! The preprocessor switch to enable the QK-nano scheduler locking. */
 /**
 * \description
@@ -65,6 +65,35 @@ void QF_onClockTickISR(void);
 /* application-level callback to cleanup the application */
 void QF_onCleanup(void);
 
+#ifdef Q_SPY
+/* QS-nano ring buffer is accessed concurrently from two threads, NOTE2 */
+#define QS_MEM_BARRIER()     __sync_synchronize()
+
+/* set the file or pipe for the QS-nano trace output */
+bool QF_setTraceOutput(char_t const * const fileName);
+
+/* write all available QS-nano trace data to the output */
+void QS_flush(void);
+#endif /* Q_SPY */
+
+#ifdef QF_REPLAY
+/* record the event postings, ticks, and dispatching into a log file */
+bool QF_setRecording(char_t const * const fileName);
+
+/* replay the log recorded with QF_setRecording() instead of QF_run() */
+int_t QF_replay(char_t const * const fileName);
+#endif /* QF_REPLAY */
+
+#ifdef QF_VIRTUAL_TIME
+/* virtual time [clock ticks] of the faster-than-real-time simulation */
+uint64_t QF_getVirtualTicks(void);
+#endif /* QF_VIRTUAL_TIME */
+
+#ifdef QF_TELEMETRY
+/* publish the telemetry block in POSIX shared memory, see qfn_telem.h */
+bool QF_setTelemetry(char_t const * const shmName);
+#endif /* QF_TELEMETRY */
+
 /* NOTES: ********************************************************************
 *
 * NOTE1:
@@ -84,6 +113,13 @@ void QF_onCleanup(void);
 * approach might be subject to priority inversions. However, most p-thread
 * mutex implementations, such as Linux p-threads, should support the
 * priority-inheritance protocol.
+*
+* NOTE2:
+* In the Spy configuration (Q_SPY defined), the trace records are produced
+* inside the critical sections of all threads, but are written to the output
+* by the QF-nano event loop and the ticker thread outside the critical
+* section. The QS-nano ring buffer is lock-free for the consumer, so the
+* memory barriers are needed to order the accesses on multi-core hosts.
 */
 
 #endif /* qfn_port_h */
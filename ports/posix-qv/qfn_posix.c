@@ -42,6 +42,25 @@
 
 #include <pthread.h>    /* POSIX-thread API */
 
+#ifdef Q_SPY
+    #include <stdio.h>  /* for fopen()/fwrite() */
+    #include <time.h>   /* for clock_gettime() */
+#endif /* Q_SPY */
+
+#ifdef QF_TELEMETRY
+    #include <string.h>   /* for memcpy() */
+    #include <time.h>     /* for clock_gettime() */
+    #include <fcntl.h>    /* for O_CREAT, O_RDWR */
+    #include <sys/mman.h> /* for shm_open(), mmap() */
+    #include <unistd.h>   /* for ftruncate(), getpid() */
+    #include "qfn_telem.h" /* layout of the telemetry block */
+#endif /* QF_TELEMETRY */
+
+#ifdef QF_REPLAY
+    #include <stdio.h>  /* for fopen()/fwrite()/fread() */
+    #include <string.h> /* for memcpy() */
+#endif /* QF_REPLAY */
+
 #ifdef QK_PREEMPTIVE
     #error "This QP-nano port does not support QK_PREEMPTIVE configuration"
 #endif
@@ -74,49 +93,565 @@ static struct timespec l_tick;
 enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; /* see NOTE1 */
 
 /* "fudged" event queues for AOs, see NOTE2 */
+#if (QF_EQUEUE_CTR_SIZE == 1)
 #define QF_FUDGED_QUEUE_LEN  0xFFU
+#else
+#define QF_FUDGED_QUEUE_LEN  0xFFFFU
+#endif
 static QEvt l_fudgedQueue[8][QF_FUDGED_QUEUE_LEN];
 #define QF_FUDGED_QUEUE_AT_(ao_, i_) (l_fudgedQueue[(ao_)->prio - 1U][(i_)])
 
+#ifdef Q_SPY
+static uint8_t l_qsBuf[0xFFFF]; /* QS-nano ring buffer, see NOTE4 */
+static FILE *l_qsFile;  /* the QS-nano trace output (file or pipe) */
+static pthread_mutex_t l_qsMutex = PTHREAD_MUTEX_INITIALIZER; /* consumer */
+
+static void QS_output_(bool const sync);
+#endif /* Q_SPY */
+
+#ifdef QF_TELEMETRY
+static QFTelemetry l_telemLocal; /* used until QF_setTelemetry() */
+static QFTelemetry *l_telem = &l_telemLocal; /* the published block */
+static char_t const *l_telemName; /* name of the shared-memory object */
+
+static void QF_telemPost_(QActive const * const me, bool const posted);
+static void QF_telemDone_(QActive const * const a);
+static void QF_telemTick_(uint64_t const late);
+#endif /* QF_TELEMETRY */
+
+#ifdef QF_REPLAY
+/* record-and-replay log, see NOTE6 */
+enum QF_RRMode { QF_RR_OFF, QF_RR_RECORD, QF_RR_REPLAY };
+enum QF_RRKind {
+    QF_RR_POST = 1,     /* internal post: prio, sig, par */
+    QF_RR_POST_FAIL,    /* internal post attempt that failed: prio, sig, par */
+    QF_RR_EXT_POST,     /* external post from the task level: prio, sig, par */
+    QF_RR_EXT_POST_ISR, /* external post from the ISR level: prio, sig, par */
+    QF_RR_TICK,         /* QF_tickXISR() called: tick rate */
+    QF_RR_DISPATCH,     /* event taken for dispatching: prio, sig, par */
+    QF_RR_EXT_LIFO,     /* external LIFO post (task level): prio, sig, par */
+    QF_RR_EXT_LIFO_ISR, /* external LIFO post (ISR level): prio, sig, par */
+    QF_RR_EXT_LATEST,   /* external latest-value post (task): prio, sig, par */
+    QF_RR_EXT_LATEST_ISR /* external latest-value post (ISR): prio, sig, par */
+};
+#define QF_RR_VERSION   1U
+
+static struct {
+    uint8_t mode;        /* enum QF_RRMode */
+    bool inTick;         /* inside QF_tickXISR() */
+    bool injecting;      /* replay of an external post in progress */
+    bool diverged;       /* replay diverged from the log */
+    pthread_t mainThread; /* the thread executing QF_run()/QF_replay() */
+    FILE *file;
+    uint8_t buf[4096];   /* buffered input/output of the log */
+    size_t len;
+    size_t pos;
+    struct {             /* next record in the replay */
+        bool valid;
+        uint8_t kind;
+        uint8_t arg;     /* priority or tick rate */
+        uint32_t sig;
+        uint32_t par;
+    } next;
+} l_rr;
+
+#if (Q_PARAM_SIZE != 0)
+    #define QF_RR_PAR_(par_) ((uint32_t)(par_))
+#else
+    #define QF_RR_PAR_(par_) ((uint32_t)0)
+#endif
+
+static void QF_rrWrite_(uint_fast8_t const kind, uint_fast8_t const arg,
+                        uint32_t const sig, uint32_t const par);
+static void QF_rrPost_(QActive const * const me, uint_fast8_t const extKind,
+                       uint32_t const sig, uint32_t const par,
+                       bool const posted);
+static void QF_rrSync_(void);
+static void QF_rrFlush_(void);
+#endif /* QF_REPLAY */
+
+#ifdef QF_VIRTUAL_TIME
+#ifdef QF_REPLAY
+    #error "QF_VIRTUAL_TIME skips clock ticks and cannot be used with QF_REPLAY"
+#endif
+static uint64_t l_virtTicks; /* virtual time [clock ticks], see NOTE7 */
+static void QF_advanceTime_(void);
+#endif /* QF_VIRTUAL_TIME */
+
+static void QF_startActives_(void);
+#ifndef QF_VIRTUAL_TIME
 static void *tickerThread(void *par); /* the expected P-Thread signature */
+#endif /* QF_VIRTUAL_TIME */
 
 /****************************************************************************/
 void QActive_ctor(QActive * const me, QStateHandler initial) {
+#ifndef QF_NO_VIRTUAL
     static QActiveVtbl const vtbl = { /* QActive virtual table */
         { &QHsm_init_,
           &QHsm_dispatch_ },
         &QActive_postX_,
         &QActive_postXISR_
     };
+#endif /* QF_NO_VIRTUAL */
     QHsm_ctor(&me->super, initial);
+#ifndef QF_NO_VIRTUAL
     me->super.vptr = &vtbl.super; /* hook the vptr to QActive virtual table */
+#endif /* QF_NO_VIRTUAL */
+}
+
+#ifdef QF_URGENT_QUEUE
+
+/* options of QF_postUrgent_() */
+#define QF_URGENT_LIFO_   ((uint_fast8_t)1) /* insert in front (LIFO) */
+#define QF_URGENT_ISR_    ((uint_fast8_t)2) /* posting from the ISR level */
+#define QF_URGENT_RECALL_ ((uint_fast8_t)4) /* recalling a deferred event */
+#define QF_URGENT_LATEST_ ((uint_fast8_t)8) /* latest-value posting */
+
+/****************************************************************************/
+/* must be called inside a critical section */
+#if (Q_PARAM_SIZE != 0)
+static bool QF_postUrgent_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par,
+                           uint_fast8_t const opt)
+#else
+static bool QF_postUrgent_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, uint_fast8_t const opt)
+#endif
+{
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx uqlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->uqlen);
+    QEQueueIdx nFree = uqlen - me->uUsed;
+
+    /* the fudged normal queue shares nUsed with the urgent ring buffer */
+    if (nFree > ((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed)) {
+        nFree = (QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed;
+    }
+
+    if (margin == QF_NO_MARGIN) {
+        if (nFree > (QEQueueIdx)0) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(330); /* must be able to post the urgent event */
+        }
+    }
+    else if (nFree > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        if ((opt & (QF_URGENT_LIFO_ | QF_URGENT_RECALL_)) != (uint_fast8_t)0) {
+            /* insert event in front of the urgent ring buffer (LIFO) */
+            ++me->uTail;
+            if (me->uTail == (QEQueueCtr)uqlen) {
+                me->uTail = (QEQueueCtr)0; /* wrap the tail */
+            }
+            QF_ROM_UQUEUE_AT_(acb, me->uTail).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+            QF_ROM_UQUEUE_AT_(acb, me->uTail).par = par;
+#endif
+        }
+        else {
+            /* insert event into the urgent ring buffer (FIFO) */
+            QF_ROM_UQUEUE_AT_(acb, me->uHead).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+            QF_ROM_UQUEUE_AT_(acb, me->uHead).par = par;
+#endif
+            if (me->uHead == (QEQueueCtr)0) {
+                me->uHead = (QEQueueCtr)uqlen; /* wrap the head */
+            }
+            --me->uHead;
+        }
+        ++me->uUsed;
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if (me->uMax < me->uUsed) {
+            me->uMax = me->uUsed; /* update the urgent high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(((opt & QF_URGENT_RECALL_) != (uint_fast8_t)0)
+                         ? QS_QF_ACTIVE_RECALL
+                         : (((opt & QF_URGENT_LIFO_) != (uint_fast8_t)0)
+                            ? QS_QF_ACTIVE_POST_LIFO
+                            : (((opt & QF_URGENT_ISR_) != (uint_fast8_t)0)
+                               ? QS_QF_ACTIVE_POST_ISR
+                               : QS_QF_ACTIVE_POST)))
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+            pthread_cond_signal(&l_condVar); /* unblock the event loop */
+        }
+    }
+    else if ((opt & QF_URGENT_RECALL_) == (uint_fast8_t)0) {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+    else {
+        /* the event stays deferred */
+    }
+
+    if ((opt & QF_URGENT_RECALL_) == (uint_fast8_t)0) {
+#ifdef QF_TELEMETRY
+        QF_telemPost_(me, (bool)margin);
+#endif /* QF_TELEMETRY */
+#ifdef QF_REPLAY
+        QF_rrPost_(me, (uint_fast8_t)(((opt & QF_URGENT_LIFO_) != 0U)
+                       ? (((opt & QF_URGENT_ISR_) != 0U)
+                          ? QF_RR_EXT_LIFO_ISR : QF_RR_EXT_LIFO)
+                       : (((opt & QF_URGENT_LATEST_) != 0U)
+                          ? (((opt & QF_URGENT_ISR_) != 0U)
+                             ? QF_RR_EXT_LATEST_ISR : QF_RR_EXT_LATEST)
+                          : (((opt & QF_URGENT_ISR_) != 0U)
+                             ? QF_RR_EXT_POST_ISR : QF_RR_EXT_POST))),
+                   (uint32_t)sig, QF_RR_PAR_(par), (bool)margin);
+#endif /* QF_REPLAY */
+    }
+
+    return (bool)margin;
+}
+/****************************************************************************/
+/* takes the oldest event of the urgent ring buffer into the AO's current
+* event, must be called inside a critical section with uUsed != 0
+*/
+static void QF_getUrgent_(QActive * const a) {
+    QActiveCB const Q_ROM *acb = &QF_active[a->prio];
+
+    --a->uUsed;
+    Q_SIG(a) = QF_ROM_UQUEUE_AT_(acb, a->uTail).sig;
+#if (Q_PARAM_SIZE != 0)
+    Q_PAR(a) = QF_ROM_UQUEUE_AT_(acb, a->uTail).par;
+#endif
+#if (QF_COALESCE_SIZE != 0)
+    QF_COALESCE_CLR_(a, Q_SIG(a), a->uTail); /* no longer waiting */
+#endif /* (QF_COALESCE_SIZE != 0) */
+    if (a->uTail == (QEQueueCtr)0) { /* wrap around? */
+        a->uTail = Q_ROM_EQUEUE_CTR(acb->uqlen);
+    }
+    --a->uTail;
+}
+
+#endif /* QF_URGENT_QUEUE */
+
+/****************************************************************************/
+/* batch posting, must be called inside a critical section */
+static bool QF_postMany_(QActive * const me, QEQueueIdx margin,
+                         QEvt const * const evts, QEQueueIdx const n,
+                         bool const isr)
+{
+    QEQueueIdx nFree = (QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed;
+    bool const guaranteed = (margin == QF_NO_MARGIN);
+    bool post;
+    QEQueueIdx i;
+#ifdef QF_URGENT_QUEUE
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx uqlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->uqlen);
+    QEQueueIdx nUrgent = (QEQueueIdx)0;
+
+    for (i = (QEQueueIdx)0; i < n; ++i) {
+        if (QF_IS_URGENT_SIG_(acb, evts[i].sig)) {
+            ++nUrgent;
+        }
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (guaranteed) {
+        margin = (QEQueueIdx)0; /* all events must fit */
+    }
+
+    /* the fudged queue shares nUsed with the urgent ring buffer */
+    post = (nFree >= n) && ((nFree - n) >= margin);
+#ifdef QF_URGENT_QUEUE
+    nFree = uqlen - me->uUsed;
+    post = post && ((nUrgent == (QEQueueIdx)0)
+           || ((nFree >= nUrgent) && ((nFree - nUrgent) >= margin)));
+#endif /* QF_URGENT_QUEUE */
+
+    if (guaranteed && (!post)) {
+        Q_ERROR_ID(360); /* must be able to post all the events */
+    }
+
+    for (i = (QEQueueIdx)0; i < n; ++i) {
+        if (post) {
+#ifdef QF_URGENT_QUEUE
+            if (QF_IS_URGENT_SIG_(acb, evts[i].sig)) {
+                /* insert event into the urgent ring buffer (FIFO) */
+                QF_ROM_UQUEUE_AT_(acb, me->uHead) = evts[i];
+                if (me->uHead == (QEQueueCtr)0) {
+                    me->uHead = (QEQueueCtr)uqlen; /* wrap the head */
+                }
+                --me->uHead;
+                ++me->uUsed;
+            }
+            else
+#endif /* QF_URGENT_QUEUE */
+            {
+                /* insert event into the ring buffer (FIFO) */
+                QF_FUDGED_QUEUE_AT_(me, me->head) = evts[i];
+                if (me->head == (QEQueueCtr)0) {
+                    me->head = (QEQueueIdx)QF_FUDGED_QUEUE_LEN; /* wrap */
+                }
+                --me->head;
+            }
+            ++me->nUsed;
+        }
+
+        QS_BEGIN_NOCRIT_(post ? (isr ? QS_QF_ACTIVE_POST_ISR
+                                     : QS_QF_ACTIVE_POST)
+                              : QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);     /* the priority of the active object */
+            QS_SIG_(evts[i].sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(evts[i].par); /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed);   /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* every event of the batch is reported as a separate post */
+#ifdef QF_TELEMETRY
+        QF_telemPost_(me, post);
+#endif /* QF_TELEMETRY */
+#ifdef QF_REPLAY
+        QF_rrPost_(me, (uint_fast8_t)(isr ? QF_RR_EXT_POST_ISR
+                                          : QF_RR_EXT_POST),
+                   (uint32_t)evts[i].sig, QF_RR_PAR_(evts[i].par), post);
+#endif /* QF_REPLAY */
+    }
+
+    if (post && (n != (QEQueueIdx)0)) {
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#ifdef QF_URGENT_QUEUE
+        if (me->uMax < me->uUsed) {
+            me->uMax = me->uUsed; /* update the urgent high-water mark */
+        }
+#endif /* QF_URGENT_QUEUE */
+#endif /* QF_EQUEUE_USAGE */
+
+        /* was the queue empty before the batch? */
+        if (me->nUsed == (QEQueueCtr)n) {
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+            pthread_cond_signal(&l_condVar); /* unblock the event loop */
+        }
+    }
+
+    (void)isr; /* unused parameter in some configurations */
+
+    return post;
+}
+
+#if (QF_COALESCE_SIZE != 0)
+
+/****************************************************************************/
+/* latest-value posting, must be called inside a critical section */
+#if (Q_PARAM_SIZE != 0)
+static bool QF_postLatest_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par,
+                           bool const isr)
+#else
+static bool QF_postLatest_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, bool const isr)
+#endif
+{
+    QPendSet const bit = QF_COALESCE_BIT_(sig);
+
+    (void)isr; /* unused parameter in some configurations */
+
+    if ((me->pend & bit) != (QPendSet)0) { /* event already waiting? */
+#if (Q_PARAM_SIZE != 0)
+        QEQueueCtr const at = me->pendAt[QF_COALESCE_POS_(sig)];
+
+#ifdef QF_URGENT_QUEUE
+        QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+        if (QF_IS_URGENT_SIG_(acb, sig)) { /* in the urgent ring buffer? */
+            QF_ROM_UQUEUE_AT_(acb, at).par = par; /* update it in place */
+        }
+        else
+#endif /* QF_URGENT_QUEUE */
+        {
+            QF_FUDGED_QUEUE_AT_(me, at).par = par; /* update it in place */
+        }
+#endif /* (Q_PARAM_SIZE != 0) */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_COALESCE)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        margin = (QEQueueIdx)true;
+    }
+#ifdef QF_URGENT_QUEUE
+    else if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+        QEQueueCtr const at = me->uHead; /* the FIFO slot of the event */
+
+        /* QF_postUrgent_() also reports the post to telemetry and replay */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+            (uint_fast8_t)(QF_URGENT_LATEST_
+                           | (isr ? QF_URGENT_ISR_ : (uint_fast8_t)0)));
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+            (uint_fast8_t)(QF_URGENT_LATEST_
+                           | (isr ? QF_URGENT_ISR_ : (uint_fast8_t)0)));
+#endif
+        if (margin) {
+            me->pendAt[QF_COALESCE_POS_(sig)] = at;
+            me->pend |= bit; /* the event is now waiting in the queue */
+        }
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+    else {
+        if (margin == QF_NO_MARGIN) {
+            if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+                margin = (QEQueueIdx)true; /* can post */
+            }
+            else {
+                margin = (QEQueueIdx)false; /* cannot post */
+                Q_ERROR_ID(310); /* must be able to post the event */
+            }
+        }
+        else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+        }
+
+        if (margin) { /* can post the event? */
+            /* insert event into the ring buffer (FIFO) */
+            QF_FUDGED_QUEUE_AT_(me, me->head).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+            QF_FUDGED_QUEUE_AT_(me, me->head).par = par;
+#endif
+            me->pendAt[QF_COALESCE_POS_(sig)] = me->head;
+            if (me->head == (QEQueueCtr)0) {
+                me->head = (QEQueueIdx)QF_FUDGED_QUEUE_LEN; /* wrap */
+            }
+            --me->head;
+            ++me->nUsed;
+            me->pend |= bit; /* the event is now waiting in the queue */
+#ifdef QF_EQUEUE_USAGE
+            if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+                me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me);
+            }
+#endif /* QF_EQUEUE_USAGE */
+
+            QS_BEGIN_NOCRIT_(isr ? QS_QF_ACTIVE_POST_ISR : QS_QF_ACTIVE_POST)
+                QS_U8_(me->prio);   /* the priority of the active object */
+                QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(par);       /* the parameter of the event */
+#endif
+                QS_EQC_(me->nUsed); /* # events in the queue */
+            QS_END_NOCRIT_()
+
+            /* is this the first event? */
+            if (me->nUsed == (QEQueueCtr)1) {
+                /* set the corresponding bit in the ready set */
+                QF_readySet_ |= (uint_fast8_t)
+                    ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+                pthread_cond_signal(&l_condVar); /* unblock the event loop */
+            }
+        }
+        else {
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+                QS_U8_(me->prio);   /* the priority of the active object */
+                QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(par);       /* the parameter of the event */
+#endif
+                QS_EQC_(me->nUsed); /* # events in the queue */
+            QS_END_NOCRIT_()
+        }
+    }
+#ifdef QF_TELEMETRY
+    QF_telemPost_(me, (bool)margin);
+#endif /* QF_TELEMETRY */
+#ifdef QF_REPLAY
+    QF_rrPost_(me, (uint_fast8_t)(isr ? QF_RR_EXT_LATEST_ISR
+                                      : QF_RR_EXT_LATEST),
+               (uint32_t)sig, QF_RR_PAR_(par), (bool)margin);
+#endif /* QF_REPLAY */
+
+    return (bool)margin;
 }
 
+#endif /* (QF_COALESCE_SIZE != 0) */
+
 /****************************************************************************/
 #if (Q_PARAM_SIZE != 0)
-bool QActive_postX_(QActive * const me, uint_fast8_t margin,
+bool QActive_postX_(QActive * const me, QEQueueIdx margin,
                     enum_t const sig, QParam const par)
 #else
-bool QActive_postX_(QActive * const me, uint_fast8_t margin,
+bool QActive_postX_(QActive * const me, QEQueueIdx margin,
                     enum_t const sig)
 #endif
 {
+#ifdef QF_REPLAY
+    if ((l_rr.mode == (uint8_t)QF_RR_REPLAY) && (!l_rr.injecting)) {
+        QF_rrSync_(); /* replay the external inputs preceding this post */
+    }
+#endif /* QF_REPLAY */
+
     QF_INT_DISABLE();
 
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              (uint_fast8_t)0);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              (uint_fast8_t)0);
+#endif
+        QF_INT_ENABLE();
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
     if (margin == QF_NO_MARGIN) {
-        if ((uint_fast8_t)QF_FUDGED_QUEUE_LEN > me->nUsed) {
-            margin = (uint_fast8_t)true; /* can post */
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            margin = (QEQueueIdx)true; /* can post */
         }
         else {
-            margin = (uint_fast8_t)false; /* cannot post */
+            margin = (QEQueueIdx)false; /* cannot post */
             Q_ERROR_ID(310); /* must be able to post the event */
         }
     }
-    else if (((uint_fast8_t)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
-        margin = (uint_fast8_t)true; /* can post */
+    else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
     }
     else {
-        margin = (uint_fast8_t)false; /* cannot post */
+        margin = (QEQueueIdx)false; /* cannot post */
     }
 
     if (margin) { /* can post the event? */
@@ -125,20 +660,51 @@ bool QActive_postX_(QActive * const me, uint_fast8_t margin,
 #if (Q_PARAM_SIZE != 0)
         QF_FUDGED_QUEUE_AT_(me, me->head).par = par;
 #endif
-        if (me->head == (uint_fast8_t)0) {
-            me->head = (uint_fast8_t)QF_FUDGED_QUEUE_LEN; /* wrap the head */
+        if (me->head == (QEQueueCtr)0) {
+            me->head = (QEQueueIdx)QF_FUDGED_QUEUE_LEN; /* wrap the head */
         }
         --me->head;
         ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
 
         /* is this the first event? */
-        if (me->nUsed == (uint_fast8_t)1) {
+        if (me->nUsed == (QEQueueCtr)1) {
             /* set the corresponding bit in the ready set */
             QF_readySet_ |= (uint_fast8_t)
                 ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
             pthread_cond_signal(&l_condVar); /* unblock the event loop */
         }
     }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+#ifdef QF_TELEMETRY
+    QF_telemPost_(me, (bool)margin);
+#endif /* QF_TELEMETRY */
+#ifdef QF_REPLAY
+    QF_rrPost_(me, (uint_fast8_t)QF_RR_EXT_POST,
+               (uint32_t)sig, QF_RR_PAR_(par), (bool)margin);
+#endif /* QF_REPLAY */
     QF_INT_ENABLE();
 
     return (bool)margin;
@@ -146,27 +712,40 @@ bool QActive_postX_(QActive * const me, uint_fast8_t margin,
 
 /****************************************************************************/
 #if (Q_PARAM_SIZE != 0)
-bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
+bool QActive_postXISR_(QActive * const me, QEQueueIdx margin,
                        enum_t const sig, QParam const par)
 #else
-bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
+bool QActive_postXISR_(QActive * const me, QEQueueIdx margin,
                        enum_t const sig)
 #endif
 {
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_ISR_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_ISR_);
+#endif
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
     if (margin == QF_NO_MARGIN) {
-        if ((uint_fast8_t)QF_FUDGED_QUEUE_LEN > me->nUsed) {
-            margin = (uint_fast8_t)true; /* can post */
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            margin = (QEQueueIdx)true; /* can post */
         }
         else {
-            margin = (uint_fast8_t)false; /* cannot post */
+            margin = (QEQueueIdx)false; /* cannot post */
             Q_ERROR_ID(310); /* must be able to post the event */
         }
     }
-    else if (((uint_fast8_t)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
-        margin = (uint_fast8_t)true; /* can post */
+    else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
     }
     else {
-        margin = (uint_fast8_t)false; /* cannot post */
+        margin = (QEQueueIdx)false; /* cannot post */
     }
 
     if (margin) { /* can post the event? */
@@ -175,65 +754,529 @@ bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
 #if (Q_PARAM_SIZE != 0)
         QF_FUDGED_QUEUE_AT_(me, me->head).par = par;
 #endif
-        if (me->head == (uint_fast8_t)0) {
-            me->head = (uint_fast8_t)QF_FUDGED_QUEUE_LEN; /* wrap the head */
+        if (me->head == (QEQueueCtr)0) {
+            me->head = (QEQueueIdx)QF_FUDGED_QUEUE_LEN; /* wrap the head */
         }
         --me->head;
         ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ISR)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
         /* is this the first event? */
-        if (me->nUsed == (uint_fast8_t)1) {
+        if (me->nUsed == (QEQueueCtr)1) {
             /* set the bit */
             QF_readySet_ |= (uint_fast8_t)
                 ((uint_fast8_t)1 << (me->prio - (uint_fast8_t)1));
             pthread_cond_signal(&l_condVar); /* unblock the event loop */
         }
     }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+#ifdef QF_TELEMETRY
+    QF_telemPost_(me, (bool)margin);
+#endif /* QF_TELEMETRY */
+#ifdef QF_REPLAY
+    QF_rrPost_(me, (uint_fast8_t)QF_RR_EXT_POST_ISR,
+               (uint32_t)sig, QF_RR_PAR_(par), (bool)margin);
+#endif /* QF_REPLAY */
 
     return (bool)margin;
 }
 
-
-/****************************************************************************/
 /****************************************************************************/
-#if (QF_TIMEEVT_CTR_SIZE != 0)
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLIFOX_(QActive * const me, QEQueueIdx margin,
+                        enum_t const sig, QParam const par)
+#else
+bool QActive_postLIFOX_(QActive * const me, QEQueueIdx margin,
+                        enum_t const sig)
+#endif
+{
+#ifdef QF_REPLAY
+    if ((l_rr.mode == (uint8_t)QF_RR_REPLAY) && (!l_rr.injecting)) {
+        QF_rrSync_(); /* replay the external inputs preceding this post */
+    }
+#endif /* QF_REPLAY */
 
-void QF_tickXISR(uint_fast8_t const tickRate) {
-    uint_fast8_t p = QF_maxActive_;
-    do {
-        QActive *a = QF_ROM_ACTIVE_GET_(p);
-        QTimer *t = &a->tickCtr[tickRate];
+    QF_INT_DISABLE();
 
-        if (t->nTicks != (QTimeEvtCtr)0) {
-            --t->nTicks;
-            if (t->nTicks == (QTimeEvtCtr)0) {
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_LIFO_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_LIFO_);
+#endif
+        QF_INT_ENABLE();
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
 
-#ifdef QF_TIMEEVT_PERIODIC
-                if (t->interval != (QTimeEvtCtr)0) {
-                    t->nTicks = t->interval; /* re-arm the periodic timer */
-                }
-#endif /* QF_TIMEEVT_PERIODIC */
+    if (margin == QF_NO_MARGIN) {
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(320); /* must be able to post the event */
+        }
+    }
+    else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
 
-#ifdef QF_TIMEEVT_USAGE
-                QF_timerSetX_[tickRate] &= (uint_fast8_t)
-                    ~((uint_fast8_t)1 << (p - (uint_fast8_t)1));
-#endif /* QF_TIMEEVT_USAGE */
+    if (margin) { /* can post the event? */
+        /* insert event in front of the ring buffer (LIFO) */
+        ++me->tail;
+        if (me->tail == (QEQueueIdx)QF_FUDGED_QUEUE_LEN) {
+            me->tail = (QEQueueCtr)0; /* wrap the tail */
+        }
+        QF_FUDGED_QUEUE_AT_(me, me->tail).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+        QF_FUDGED_QUEUE_AT_(me, me->tail).par = par;
+#endif
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
 
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_LIFO)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
 #if (Q_PARAM_SIZE != 0)
-                QACTIVE_POST_ISR(a, (enum_t)Q_TIMEOUT_SIG + (enum_t)tickRate,
-                                 (QParam)0);
-#else
-                QACTIVE_POST_ISR(a, (enum_t)Q_TIMEOUT_SIG + (enum_t)tickRate);
-#endif /* (Q_PARAM_SIZE != 0) */
-            }
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+            pthread_cond_signal(&l_condVar); /* unblock the event loop */
         }
-        --p;
-    } while (p != (uint_fast8_t)0);
+    }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+#ifdef QF_TELEMETRY
+    QF_telemPost_(me, (bool)margin);
+#endif /* QF_TELEMETRY */
+#ifdef QF_REPLAY
+    QF_rrPost_(me, (uint_fast8_t)QF_RR_EXT_LIFO,
+               (uint32_t)sig, QF_RR_PAR_(par), (bool)margin);
+#endif /* QF_REPLAY */
+    QF_INT_ENABLE();
+
+    return (bool)margin;
 }
 
 /****************************************************************************/
-#ifdef QF_TIMEEVT_PERIODIC
-void QActive_armX(QActive * const me, uint_fast8_t const tickRate,
-                  QTimeEvtCtr const nTicks, QTimeEvtCtr const interval)
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLIFOXISR_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par)
+#else
+bool QActive_postLIFOXISR_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig)
+#endif
+{
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_LIFO_ | QF_URGENT_ISR_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_LIFO_ | QF_URGENT_ISR_);
+#endif
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (margin == QF_NO_MARGIN) {
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(320); /* must be able to post the event */
+        }
+    }
+    else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        /* insert event in front of the ring buffer (LIFO) */
+        ++me->tail;
+        if (me->tail == (QEQueueIdx)QF_FUDGED_QUEUE_LEN) {
+            me->tail = (QEQueueCtr)0; /* wrap the tail */
+        }
+        QF_FUDGED_QUEUE_AT_(me, me->tail).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+        QF_FUDGED_QUEUE_AT_(me, me->tail).par = par;
+#endif
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_LIFO)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+            pthread_cond_signal(&l_condVar); /* unblock the event loop */
+        }
+    }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+#ifdef QF_TELEMETRY
+    QF_telemPost_(me, (bool)margin);
+#endif /* QF_TELEMETRY */
+#ifdef QF_REPLAY
+    QF_rrPost_(me, (uint_fast8_t)QF_RR_EXT_LIFO_ISR,
+               (uint32_t)sig, QF_RR_PAR_(par), (bool)margin);
+#endif /* QF_REPLAY */
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+bool QActive_postManyX_(QActive * const me, QEQueueIdx margin,
+                        QEvt const * const evts, QEQueueIdx const n)
+{
+#ifdef QF_REPLAY
+    if ((l_rr.mode == (uint8_t)QF_RR_REPLAY) && (!l_rr.injecting)) {
+        QF_rrSync_(); /* replay the external inputs preceding this post */
+    }
+#endif /* QF_REPLAY */
+
+    QF_INT_DISABLE();
+    margin = (QEQueueIdx)QF_postMany_(me, margin, evts, n, false);
+    QF_INT_ENABLE();
+
+    return (bool)margin;
+}
+/****************************************************************************/
+bool QActive_postManyXISR_(QActive * const me, QEQueueIdx margin,
+                           QEvt const * const evts, QEQueueIdx const n)
+{
+    return QF_postMany_(me, margin, evts, n, true);
+}
+
+#if (QF_COALESCE_SIZE != 0)
+
+/****************************************************************************/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLatestX_(QActive * const me, QEQueueIdx margin,
+                          enum_t const sig, QParam const par)
+#else
+bool QActive_postLatestX_(QActive * const me, QEQueueIdx margin,
+                          enum_t const sig)
+#endif
+{
+    /* the signal must have a bit in the QPendSet */
+    Q_REQUIRE_ID(340, QF_IS_COALESCE_SIG_(sig));
+
+#ifdef QF_REPLAY
+    if ((l_rr.mode == (uint8_t)QF_RR_REPLAY) && (!l_rr.injecting)) {
+        QF_rrSync_(); /* replay the external inputs preceding this post */
+    }
+#endif /* QF_REPLAY */
+
+    QF_INT_DISABLE();
+#if (Q_PARAM_SIZE != 0)
+    margin = (QEQueueIdx)QF_postLatest_(me, margin, sig, par, false);
+#else
+    margin = (QEQueueIdx)QF_postLatest_(me, margin, sig, false);
+#endif
+    QF_INT_ENABLE();
+
+    return (bool)margin;
+}
+/****************************************************************************/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLatestXISR_(QActive * const me, QEQueueIdx margin,
+                             enum_t const sig, QParam const par)
+#else
+bool QActive_postLatestXISR_(QActive * const me, QEQueueIdx margin,
+                             enum_t const sig)
+#endif
+{
+    /* the signal must have a bit in the QPendSet */
+    Q_REQUIRE_ID(345, QF_IS_COALESCE_SIG_(sig));
+
+#if (Q_PARAM_SIZE != 0)
+    return QF_postLatest_(me, margin, sig, par, true);
+#else
+    return QF_postLatest_(me, margin, sig, true);
+#endif
+}
+
+#endif /* (QF_COALESCE_SIZE != 0) */
+
+#ifdef QF_EQUEUE_USAGE
+
+/****************************************************************************/
+void QActive_resetQueueMax(QActive * const me) {
+    QF_INT_DISABLE();
+    me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me);
+#ifdef QF_URGENT_QUEUE
+    me->uMax = me->uUsed;
+#endif /* QF_URGENT_QUEUE */
+    QF_INT_ENABLE();
+}
+
+/****************************************************************************/
+void QF_reportQueueUsage(void) {
+    uint_fast8_t p;
+    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
+#ifdef QF_URGENT_QUEUE
+        QF_onQueueUsage(p,
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].qlen),
+            QActive_getQueueMax(QF_ROM_ACTIVE_GET_(p)),
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].uqlen),
+            QActive_getUrgentQueueMax(QF_ROM_ACTIVE_GET_(p)));
+#else
+        QF_onQueueUsage(p,
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].qlen),
+            QActive_getQueueMax(QF_ROM_ACTIVE_GET_(p)));
+#endif /* QF_URGENT_QUEUE */
+    }
+}
+
+#endif /* QF_EQUEUE_USAGE */
+
+#ifdef QF_DEFER
+
+/****************************************************************************/
+bool QActive_defer(QActive * const me) {
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx dlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->dlen);
+    bool deferred;
+
+    if (dlen > (QEQueueIdx)me->dUsed) {
+        /* insert the current event into the deferral ring buffer (FIFO) */
+        QF_ROM_DEFER_AT_(acb, me->dHead) = me->super.evt;
+        if (me->dHead == (QEQueueCtr)0) {
+            me->dHead = (QEQueueCtr)dlen; /* wrap the head */
+        }
+        --me->dHead;
+        ++me->dUsed;
+        deferred = true;
+
+        QS_BEGIN_(QS_QF_ACTIVE_DEFER)
+            QS_U8_(me->prio);       /* the priority of the active object */
+            QS_SIG_(me->super.evt.sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(me->super.evt.par); /* the parameter of the event */
+#endif
+            QS_EQC_(me->dUsed);     /* # deferred events */
+        QS_END_()
+    }
+    else {
+        deferred = false;
+
+        QS_BEGIN_(QS_QF_ACTIVE_DEFER_ATTEMPT)
+            QS_U8_(me->prio);       /* the priority of the active object */
+            QS_SIG_(me->super.evt.sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(me->super.evt.par); /* the parameter of the event */
+#endif
+            QS_EQC_(me->dUsed);     /* # deferred events */
+        QS_END_()
+    }
+    return deferred;
+}
+
+/****************************************************************************/
+bool QActive_recall(QActive * const me) {
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    bool recalled = false;
+
+    if (me->dUsed != (QEQueueCtr)0) { /* any deferred events? */
+        QF_INT_DISABLE();
+
+#ifdef QF_URGENT_QUEUE
+        if (QF_IS_URGENT_SIG_(acb, QF_ROM_DEFER_AT_(acb, me->dTail).sig)) {
+            recalled = QF_postUrgent_(me, (QEQueueIdx)0,
+                (enum_t)QF_ROM_DEFER_AT_(acb, me->dTail).sig,
+#if (Q_PARAM_SIZE != 0)
+                QF_ROM_DEFER_AT_(acb, me->dTail).par,
+#endif
+                QF_URGENT_RECALL_);
+        }
+        else
+#endif /* QF_URGENT_QUEUE */
+        /* free slot in the queue? */
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            /* insert the event in front of the queue (LIFO) */
+            ++me->tail;
+            if (me->tail == (QEQueueIdx)QF_FUDGED_QUEUE_LEN) {
+                me->tail = (QEQueueCtr)0; /* wrap the tail */
+            }
+            QF_FUDGED_QUEUE_AT_(me, me->tail) =
+                QF_ROM_DEFER_AT_(acb, me->dTail);
+            ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+            if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+                me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me);
+            }
+#endif /* QF_EQUEUE_USAGE */
+
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_RECALL)
+                QS_U8_(me->prio);   /* the priority of the active object */
+                QS_SIG_(QF_FUDGED_QUEUE_AT_(me, me->tail).sig);
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(QF_FUDGED_QUEUE_AT_(me, me->tail).par);
+#endif
+                QS_EQC_(me->nUsed); /* # events in the queue */
+            QS_END_NOCRIT_()
+
+            /* is this the first event? */
+            if (me->nUsed == (QEQueueCtr)1) {
+                /* set the bit, the AO is running in the event loop */
+                QF_readySet_ |= (uint_fast8_t)
+                    ((uint_fast8_t)1 << (me->prio - (uint_fast8_t)1));
+            }
+            recalled = true;
+        }
+
+        QF_INT_ENABLE();
+
+        if (recalled) { /* remove the event from the deferral ring buffer */
+            if (me->dTail == (QEQueueCtr)0) {
+                me->dTail = Q_ROM_EQUEUE_CTR(acb->dlen); /* wrap the tail */
+            }
+            --me->dTail;
+            --me->dUsed;
+        }
+    }
+    return recalled;
+}
+
+#endif /* QF_DEFER */
+
+
+/****************************************************************************/
+/****************************************************************************/
+#if (QF_TIMEEVT_CTR_SIZE != 0)
+
+void QF_tickXISR(uint_fast8_t const tickRate) {
+    uint_fast8_t p = QF_maxActive_;
+
+    QS_BEGIN_ISR_(QS_QF_TICK)
+        QS_U8_(tickRate); /* the tick rate */
+    QS_END_ISR_()
+
+#ifdef QF_REPLAY
+    if (l_rr.mode == (uint8_t)QF_RR_RECORD) {
+        QF_rrWrite_((uint_fast8_t)QF_RR_TICK, tickRate, 0U, 0U);
+    }
+    l_rr.inTick = true; /* the timeouts are internal posts */
+#endif /* QF_REPLAY */
+
+    do {
+        QActive *a = QF_ROM_ACTIVE_GET_(p);
+        QTimer *t = &a->tickCtr[tickRate];
+
+        if (t->nTicks != (QTimeEvtCtr)0) {
+            --t->nTicks;
+            if (t->nTicks == (QTimeEvtCtr)0) {
+
+#ifdef QF_TIMEEVT_PERIODIC
+                if (t->interval != (QTimeEvtCtr)0) {
+                    t->nTicks = t->interval; /* re-arm the periodic timer */
+                }
+#endif /* QF_TIMEEVT_PERIODIC */
+
+#ifdef QF_TIMEEVT_USAGE
+                QF_timerSetX_[tickRate] &= (uint_fast8_t)
+                    ~((uint_fast8_t)1 << (p - (uint_fast8_t)1));
+#endif /* QF_TIMEEVT_USAGE */
+
+                QS_BEGIN_ISR_(QS_QF_TIMEEVT_POST)
+                    QS_U8_(p);        /* the priority of the active object */
+                    QS_U8_(tickRate); /* the tick rate */
+                QS_END_ISR_()
+
+#if (Q_PARAM_SIZE != 0)
+                QACTIVE_POST_ISR(a, (enum_t)Q_TIMEOUT_SIG + (enum_t)tickRate,
+                                 (QParam)0);
+#else
+                QACTIVE_POST_ISR(a, (enum_t)Q_TIMEOUT_SIG + (enum_t)tickRate);
+#endif /* (Q_PARAM_SIZE != 0) */
+            }
+        }
+        --p;
+    } while (p != (uint_fast8_t)0);
+
+#ifdef QF_REPLAY
+    l_rr.inTick = false;
+#endif /* QF_REPLAY */
+}
+
+/****************************************************************************/
+#ifdef QF_TIMEEVT_PERIODIC
+void QActive_armX(QActive * const me, uint_fast8_t const tickRate,
+                  QTimeEvtCtr const nTicks, QTimeEvtCtr const interval)
 #else
 void QActive_armX(QActive * const me, uint_fast8_t const tickRate,
                   QTimeEvtCtr const nTicks)
@@ -307,6 +1350,21 @@ void QF_init(uint_fast8_t maxActive) {
     /* init the global mutex with the default non-recursive initializer */
     pthread_mutex_init(&l_pThreadMutex_, NULL);
 
+#ifdef Q_SPY
+    QS_initBuf(l_qsBuf, (uint_fast16_t)sizeof(l_qsBuf));
+#endif /* Q_SPY */
+
+#ifdef QF_TELEMETRY
+    memset(l_telem, 0, sizeof(QFTelemetry));
+    l_telem->magic       = QF_TELEM_MAGIC;
+    l_telem->version     = QF_TELEM_VERSION;
+    l_telem->size        = (uint32_t)sizeof(QFTelemetry);
+    l_telem->pid         = (uint32_t)getpid();
+    l_telem->maxActive   = (uint32_t)QF_maxActive_;
+    l_telem->maxTickRate = (uint32_t)QF_MAX_TICK_RATE;
+    l_telem->tickPeriod  = (uint64_t)NANOSLEEP_NSEC_PER_SEC/100U;
+#endif /* QF_TELEMETRY */
+
     l_tick.tv_sec = 0;
     l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC/100L; /* default clock tick */
 
@@ -338,9 +1396,36 @@ void QF_init(uint_fast8_t maxActive) {
         /* QF_active[p] must be initialized */
         Q_ASSERT_ID(110, a != (QActive *)0);
 
-        a->head    = (uint_fast8_t)0;
-        a->tail    = (uint_fast8_t)0;
-        a->nUsed   = (uint_fast8_t)0;
+#ifdef QF_URGENT_QUEUE
+        /* urgent signals need the urgent ring buffer */
+        Q_ASSERT_ID(120, (Q_ROM_SIG(QF_active[p].usig) == (QSignal)0)
+                         || (Q_ROM_EQUEUE_CTR(QF_active[p].uqlen)
+                             != (QEQueueCtr)0));
+#endif /* QF_URGENT_QUEUE */
+
+        a->prio    = (uint8_t)p; /* known already before QF_run() */
+        a->head    = (QEQueueCtr)0;
+        a->tail    = (QEQueueCtr)0;
+        a->nUsed   = (QEQueueCtr)0;
+#ifdef QF_EQUEUE_USAGE
+        a->nMax    = (QEQueueCtr)0;
+#endif /* QF_EQUEUE_USAGE */
+#ifdef QF_DEFER
+        a->dHead   = (QEQueueCtr)0;
+        a->dTail   = (QEQueueCtr)0;
+        a->dUsed   = (QEQueueCtr)0;
+#endif /* QF_DEFER */
+#ifdef QF_URGENT_QUEUE
+        a->uHead   = (QEQueueCtr)0;
+        a->uTail   = (QEQueueCtr)0;
+        a->uUsed   = (QEQueueCtr)0;
+#ifdef QF_EQUEUE_USAGE
+        a->uMax    = (QEQueueCtr)0;
+#endif /* QF_EQUEUE_USAGE */
+#endif /* QF_URGENT_QUEUE */
+#if (QF_COALESCE_SIZE != 0)
+        a->pend    = (QPendSet)0;
+#endif /* (QF_COALESCE_SIZE != 0) */
 #if (QF_TIMEEVT_CTR_SIZE != 0)
         for (n = (uint_fast8_t)0; n < (uint_fast8_t)QF_MAX_TICK_RATE; ++n) {
             a->tickCtr[n].nTicks   = (QTimeEvtCtr)0;
@@ -355,31 +1440,21 @@ void QF_init(uint_fast8_t maxActive) {
 int_t QF_run(void) {
     uint_fast8_t p;
     QActive *a;
+#ifndef QF_VIRTUAL_TIME
     pthread_t thread;
+#endif /* QF_VIRTUAL_TIME */
 
     pthread_cond_init(&l_condVar, 0);
 
-    /* set priorities all registered active objects... */
-    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
-        a = QF_ROM_ACTIVE_GET_(p);
-
-        /* QF_active[p] must be initialized */
-        Q_ASSERT_ID(810, a != (QActive *)0);
-
-        a->prio = p; /* set the priority of the active object */
-    }
-
-    /* trigger initial transitions in all registered active objects... */
-    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
-        a = QF_ROM_ACTIVE_GET_(p);
-        QHSM_INIT(&a->super); /* take the initial transition in the HSM */
-    }
+    QF_startActives_();
 
     QF_onStartup(); /* invoke startup callback */
 
     l_isRunning = true;
+#ifndef QF_VIRTUAL_TIME
     Q_ALLEGE_ID(810, pthread_create(&thread, (pthread_attr_t *)0,
          &tickerThread, (void *)0) == 0); /* ticker thread must be created */
+#endif /* QF_VIRTUAL_TIME */
 
     /* the event loop of the QV-nano kernel... */
     QF_INT_DISABLE();
@@ -399,44 +1474,139 @@ int_t QF_run(void) {
             a = QF_ROM_ACTIVE_GET_(p);
 
             /* some unsuded events must be available */
-            Q_ASSERT_ID(820, a->nUsed > (uint_fast8_t)0);
+            Q_ASSERT_ID(820, a->nUsed > (QEQueueCtr)0);
 
             --a->nUsed;
-            Q_SIG(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).sig;
+#ifdef QF_URGENT_QUEUE
+            if (a->uUsed != (QEQueueCtr)0) { /* any urgent events? */
+                QF_getUrgent_(a);
+            }
+            else
+#endif /* QF_URGENT_QUEUE */
+            {
+                Q_SIG(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).sig;
 #if (Q_PARAM_SIZE != 0)
-            Q_PAR(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).par;
+                Q_PAR(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).par;
 #endif
-            if (a->tail == (uint_fast8_t)0) { /* wrap around? */
-                a->tail = (uint_fast8_t)QF_FUDGED_QUEUE_LEN;
+#if (QF_COALESCE_SIZE != 0)
+                /* no longer waiting */
+                QF_COALESCE_CLR_(a, Q_SIG(a), a->tail);
+#endif /* (QF_COALESCE_SIZE != 0) */
+                if (a->tail == (QEQueueCtr)0) { /* wrap around? */
+                    a->tail = (QEQueueIdx)QF_FUDGED_QUEUE_LEN;
+                }
+                --a->tail;
             }
-            --a->tail;
+
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_GET)
+                QS_U8_(p);         /* the priority of the active object */
+                QS_SIG_(Q_SIG(a)); /* the signal of the event */
+                QS_EQC_(a->nUsed); /* # events left in the queue */
+            QS_END_NOCRIT_()
+
+#ifdef QF_REPLAY
+            if (l_rr.mode == (uint8_t)QF_RR_RECORD) {
+                QF_rrWrite_((uint_fast8_t)QF_RR_DISPATCH, p,
+                            (uint32_t)Q_SIG(a), QF_RR_PAR_(Q_PAR(a)));
+            }
+#endif /* QF_REPLAY */
+
             QF_INT_ENABLE();
 
             QHSM_DISPATCH(&a->super); /* dispatch to the HSM (RTC step) */
 
+#ifdef Q_SPY
+            QS_output_(false); /* output the trace of the RTC step */
+#endif /* Q_SPY */
+
             QF_INT_DISABLE();
             /* empty queue? */
-            if (a->nUsed == (uint_fast8_t)0) {
+            if (a->nUsed == (QEQueueCtr)0) {
                 /* clear the bit corresponding to 'p' */
                 QF_readySet_ &= (uint_fast8_t)
                     ~((uint_fast8_t)1 << (p - (uint_fast8_t)1));
             }
+#ifdef QF_TELEMETRY
+            QF_telemDone_(a);
+#endif /* QF_TELEMETRY */
         }
         else {
+#ifndef QF_VIRTUAL_TIME
             /* yield the CPU until new event(s) arrive */
             pthread_cond_wait(&l_condVar, &l_pThreadMutex_);
+#else
+            /* all AOs idle: jump to the next clock tick that matters */
+            QF_advanceTime_();
+#endif /* QF_VIRTUAL_TIME */
             QF_INT_ENABLE();
 
+#if defined(Q_SPY) && defined(QF_VIRTUAL_TIME)
+            QS_output_(false); /* output the trace of the clock tick */
+#endif
+
             QF_INT_DISABLE();
         }
     }
     QF_INT_ENABLE();
     QF_onCleanup(); /* cleanup callback */
+
+#ifdef Q_SPY
+    QS_flush(); /* output the rest of the trace */
+    pthread_mutex_lock(&l_qsMutex);
+    if ((l_qsFile != (FILE *)0) && (l_qsFile != stdout)) {
+        fclose(l_qsFile);
+    }
+    l_qsFile = (FILE *)0;
+    pthread_mutex_unlock(&l_qsMutex);
+#endif /* Q_SPY */
+
+#ifdef QF_REPLAY
+    if (l_rr.mode == (uint8_t)QF_RR_RECORD) {
+        QF_INT_DISABLE();
+        QF_rrFlush_(); /* write the rest of the log */
+        fclose(l_rr.file);
+        l_rr.mode = (uint8_t)QF_RR_OFF;
+        QF_INT_ENABLE();
+    }
+#endif /* QF_REPLAY */
+
+#ifdef QF_TELEMETRY
+    if (l_telemName != (char_t const *)0) { /* block in shared memory? */
+        shm_unlink(l_telemName); /* existing mappings remain valid */
+    }
+#endif /* QF_TELEMETRY */
+
     pthread_cond_destroy(&l_condVar); /* cleanup the condition variable */
     pthread_mutex_destroy(&l_pThreadMutex_);
 
     return (int_t)0; /* success */
 }
+/*..........................................................................*/
+static void QF_startActives_(void) {
+    uint_fast8_t p;
+    QActive *a;
+
+    /* set priorities all registered active objects... */
+    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
+        a = QF_ROM_ACTIVE_GET_(p);
+
+        /* QF_active[p] must be initialized */
+        Q_ASSERT_ID(810, a != (QActive *)0);
+
+        a->prio = p; /* set the priority of the active object */
+
+        QS_BEGIN_(QS_QF_ACTIVE_ADD)
+            QS_U8_(p);   /* the priority of the active object */
+            QS_OBJ_(a);  /* the active object */
+        QS_END_()
+    }
+
+    /* trigger initial transitions in all registered active objects... */
+    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
+        a = QF_ROM_ACTIVE_GET_(p);
+        QHSM_INIT(&a->super); /* take the initial transition in the HSM */
+    }
+}
 /****************************************************************************/
 void QF_stop(void) {
     l_isRunning = false;    /* cause exit from the event loop */
@@ -449,20 +1619,648 @@ void QF_setTickRate(uint32_t ticksPerSec) {
     l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC / ticksPerSec;
 }
 
+#ifndef QF_VIRTUAL_TIME
 /*..........................................................................*/
 static void *tickerThread(void *par) { /* the expected P-Thread signature */
     (void)par; /* unused parameter */
 
     while (l_isRunning) {
+#ifdef QF_TELEMETRY
+        struct timespec t0;
+        struct timespec t1;
+        int64_t late;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+#endif /* QF_TELEMETRY */
+
         nanosleep(&l_tick, NULL); /* sleep for the number of ticks, NOTE1 */
 
+#ifdef QF_TELEMETRY
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        late = ((int64_t)(t1.tv_sec - t0.tv_sec) * NANOSLEEP_NSEC_PER_SEC)
+               + (int64_t)(t1.tv_nsec - t0.tv_nsec)
+               - (int64_t)l_tick.tv_nsec;
+#endif /* QF_TELEMETRY */
+
         QF_INT_DISABLE();
         QF_onClockTickISR(); /* call back to the app, see NOTE2 */
+#ifdef QF_TELEMETRY
+        QF_telemTick_((late > 0) ? (uint64_t)late : 0U);
+#endif /* QF_TELEMETRY */
         QF_INT_ENABLE();
+
+#ifdef Q_SPY
+        QS_flush(); /* output the trace at least once per clock tick */
+#endif /* Q_SPY */
     }
     return (void *)0; /* return success */
 }
 
+#else /* QF_VIRTUAL_TIME */
+/*..........................................................................*/
+/**
+* @description
+* Returns the virtual time of the simulation as the number of clock ticks
+* since the start of QF_run(). In the virtual-time configuration the
+* event loop, the clock tick callback, and all AOs execute in the same
+* thread, so this function can be called from any of them without locking.
+*/
+uint64_t QF_getVirtualTicks(void) {
+    return l_virtTicks;
+}
+/*..........................................................................*/
+/* advances the virtual time when all AOs are idle, see NOTE7 */
+static void QF_advanceTime_(void) {
+#if (QF_TIMEEVT_CTR_SIZE != 0)
+    QTimeEvtCtr skip = (QTimeEvtCtr)0;
+    uint_fast8_t p;
+
+    /* find the nearest expiration of the time events at tick rate 0... */
+    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
+        QActive const * const a = QF_ROM_ACTIVE_GET_(p);
+        QTimeEvtCtr const n = a->tickCtr[0].nTicks;
+        if ((n != (QTimeEvtCtr)0)
+            && ((skip == (QTimeEvtCtr)0) || (n < skip)))
+        {
+            skip = n;
+        }
+#if (QF_MAX_TICK_RATE > 1)
+        {
+            uint_fast8_t r;
+            for (r = (uint_fast8_t)1; r < (uint_fast8_t)QF_MAX_TICK_RATE;
+                 ++r)
+            {
+                if (a->tickCtr[r].nTicks != (QTimeEvtCtr)0) {
+                    skip = (QTimeEvtCtr)1; /* app drives the other rates */
+                }
+            }
+        }
+#endif /* (QF_MAX_TICK_RATE > 1) */
+    }
+
+    /* ...and skip all the clock ticks before it */
+    if (skip > (QTimeEvtCtr)1) {
+        --skip;
+        for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
+            QActive * const a = QF_ROM_ACTIVE_GET_(p);
+            if (a->tickCtr[0].nTicks != (QTimeEvtCtr)0) {
+                a->tickCtr[0].nTicks -= skip;
+            }
+        }
+        l_virtTicks += (uint64_t)skip;
+    }
+#endif /* (QF_TIMEEVT_CTR_SIZE != 0) */
+
+    ++l_virtTicks;
+    QF_onClockTickISR(); /* call back to the app, see NOTE2 */
+#ifdef QF_TELEMETRY
+    QF_telemTick_(0U);
+#endif /* QF_TELEMETRY */
+}
+#endif /* QF_VIRTUAL_TIME */
+
+#ifdef Q_SPY
+/*..........................................................................*/
+/**
+* @description
+* Opens the file or pipe for the binary QS-nano trace output. The name "-"
+* denotes the standard output. Until this function is called, the produced
+* trace records are discarded.
+*
+* @returns true if the output could be opened and false otherwise.
+*/
+bool QF_setTraceOutput(char_t const * const fileName) {
+    FILE *f;
+    if ((fileName[0] == '-') && (fileName[1] == '\0')) {
+        f = stdout;
+    }
+    else {
+        f = fopen(fileName, "wb");
+    }
+    if (f != (FILE *)0) {
+        pthread_mutex_lock(&l_qsMutex);
+        if ((l_qsFile != (FILE *)0) && (l_qsFile != stdout)) {
+            fclose(l_qsFile);
+        }
+        l_qsFile = f;
+        pthread_mutex_unlock(&l_qsMutex);
+    }
+    return f != (FILE *)0;
+}
+/*..........................................................................*/
+void QS_flush(void) {
+    QS_output_(true);
+}
+/*..........................................................................*/
+/* QS-nano time stamp in microseconds, see NOTE4 */
+QSTimeCtr QS_onGetTime(void) {
+#ifndef QF_VIRTUAL_TIME
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (QSTimeCtr)(((uint32_t)ts.tv_sec * 1000000U)
+                       + (uint32_t)(ts.tv_nsec / 1000));
+#else
+    /* the virtual time in microseconds (called inside critical section) */
+    return (QSTimeCtr)(l_virtTicks * (uint64_t)(l_tick.tv_nsec / 1000));
+#endif /* QF_VIRTUAL_TIME */
+}
+/*..........................................................................*/
+static void QS_output_(bool const sync) {
+    uint8_t const *block;
+    uint16_t nBytes;
+
+    pthread_mutex_lock(&l_qsMutex); /* only one consumer at a time */
+    do {
+        nBytes = (uint16_t)sizeof(l_qsBuf);
+        block = QS_getBlock(&nBytes);
+        if ((block != (uint8_t const *)0) && (l_qsFile != (FILE *)0)) {
+            fwrite(block, 1U, (size_t)nBytes, l_qsFile);
+        }
+    } while (block != (uint8_t const *)0);
+    if (sync && (l_qsFile != (FILE *)0)) {
+        fflush(l_qsFile); /* make the trace visible to a reader of a pipe */
+    }
+    pthread_mutex_unlock(&l_qsMutex);
+}
+#endif /* Q_SPY */
+
+#ifdef QF_REPLAY
+/*..........................................................................*/
+/**
+* @description
+* Starts recording all event postings, clock ticks, and dispatch decisions
+* into the binary log file, which can be later replayed with QF_replay().
+* This function must be called after QF_init() and from the thread that
+* calls QF_run().
+*
+* @returns true if the log file could be created and false otherwise.
+*/
+bool QF_setRecording(char_t const * const fileName) {
+    FILE *f = fopen(fileName, "wb");
+    if (f != (FILE *)0) {
+        static uint8_t const hdr[4] = { 'Q', 'N', 'R', 'R' };
+        QF_INT_DISABLE();
+        l_rr.file = f;
+        l_rr.len = 0U;
+        l_rr.mainThread = pthread_self();
+        l_rr.mode = (uint8_t)QF_RR_RECORD;
+        memcpy(l_rr.buf, hdr, sizeof(hdr));
+        l_rr.buf[4] = (uint8_t)QF_RR_VERSION;
+        l_rr.buf[5] = (uint8_t)Q_PARAM_SIZE;
+        l_rr.buf[6] = (uint8_t)QF_maxActive_;
+        l_rr.buf[7] = (uint8_t)0; /* reserved */
+        l_rr.len = 8U;
+        QF_INT_ENABLE();
+    }
+    return f != (FILE *)0;
+}
+/*..........................................................................*/
+static void QF_rrFlush_(void) {
+    fwrite(l_rr.buf, 1U, l_rr.len, l_rr.file);
+    l_rr.len = 0U;
+}
+/*..........................................................................*/
+static void QF_rrPutUvar_(uint32_t v) {
+    while (v >= 0x80U) {
+        l_rr.buf[l_rr.len] = (uint8_t)((v & 0x7FU) | 0x80U);
+        ++l_rr.len;
+        v >>= 7;
+    }
+    l_rr.buf[l_rr.len] = (uint8_t)v;
+    ++l_rr.len;
+}
+/*..........................................................................*/
+/* appends a record to the log, must be called inside a critical section */
+static void QF_rrWrite_(uint_fast8_t const kind, uint_fast8_t const arg,
+                        uint32_t const sig, uint32_t const par)
+{
+    if (l_rr.len > (sizeof(l_rr.buf) - 16U)) { /* no room for a record? */
+        QF_rrFlush_();
+    }
+    l_rr.buf[l_rr.len] = (uint8_t)((kind << 4) | arg);
+    ++l_rr.len;
+    if (kind != (uint_fast8_t)QF_RR_TICK) {
+        QF_rrPutUvar_(sig);
+#if (Q_PARAM_SIZE != 0)
+        QF_rrPutUvar_(par);
+#else
+        (void)par;
+#endif
+    }
+}
+/*..........................................................................*/
+static bool QF_rrGetByte_(uint8_t * const b) {
+    if (l_rr.pos == l_rr.len) { /* buffer empty? */
+        l_rr.len = fread(l_rr.buf, 1U, sizeof(l_rr.buf), l_rr.file);
+        l_rr.pos = 0U;
+        if (l_rr.len == 0U) {
+            return false;
+        }
+    }
+    *b = l_rr.buf[l_rr.pos];
+    ++l_rr.pos;
+    return true;
+}
+/*..........................................................................*/
+static bool QF_rrGetUvar_(uint32_t * const v) {
+    uint_fast8_t shift = 0U;
+    uint8_t b;
+    *v = 0U;
+    do {
+        if ((!QF_rrGetByte_(&b)) || (shift > 28U)) {
+            return false;
+        }
+        *v |= (uint32_t)(b & 0x7FU) << shift;
+        shift += 7U;
+    } while ((b & 0x80U) != 0U);
+    return true;
+}
+/*..........................................................................*/
+/* decodes the next record of the replay log, returns false at the end */
+static bool QF_rrPeek_(void) {
+    uint8_t b;
+    if (!l_rr.next.valid) {
+        if (!QF_rrGetByte_(&b)) {
+            return false;
+        }
+        l_rr.next.kind = (uint8_t)(b >> 4);
+        l_rr.next.arg  = (uint8_t)(b & 0x0FU);
+        l_rr.next.sig  = 0U;
+        l_rr.next.par  = 0U;
+        if (l_rr.next.kind != (uint8_t)QF_RR_TICK) {
+            if (!QF_rrGetUvar_(&l_rr.next.sig)) {
+                return false;
+            }
+#if (Q_PARAM_SIZE != 0)
+            if (!QF_rrGetUvar_(&l_rr.next.par)) {
+                return false;
+            }
+#endif
+        }
+        if ((l_rr.next.kind < (uint8_t)QF_RR_POST)
+            || (l_rr.next.kind > (uint8_t)QF_RR_EXT_LATEST_ISR)
+            || ((l_rr.next.kind != (uint8_t)QF_RR_TICK)
+                && ((l_rr.next.arg == 0U)
+                    || (l_rr.next.arg > QF_maxActive_))))
+        {
+            l_rr.diverged = true; /* corrupted log */
+            return false;
+        }
+        l_rr.next.valid = true;
+    }
+    return true;
+}
+/*..........................................................................*/
+/* logs (record) or verifies (replay) a post, inside a critical section */
+static void QF_rrPost_(QActive const * const me, uint_fast8_t const extKind,
+                       uint32_t const sig, uint32_t const par,
+                       bool const posted)
+{
+    if (l_rr.mode == (uint8_t)QF_RR_RECORD) {
+        if (pthread_equal(pthread_self(), l_rr.mainThread) || l_rr.inTick) {
+            QF_rrWrite_((uint_fast8_t)(posted ? QF_RR_POST : QF_RR_POST_FAIL),
+                        me->prio, sig, par);
+        }
+        else if (posted) { /* external input changing the system? */
+            QF_rrWrite_(extKind, me->prio, sig, par);
+        }
+        else {
+            /* failed external post has no effect */
+        }
+    }
+    else if ((l_rr.mode == (uint8_t)QF_RR_REPLAY) && (!l_rr.injecting)
+             && (!l_rr.diverged))
+    {
+        /* the regenerated internal post must match the log */
+        if (QF_rrPeek_()
+            && (l_rr.next.kind == (uint8_t)(posted ? QF_RR_POST
+                                                   : QF_RR_POST_FAIL))
+            && (l_rr.next.arg == (uint8_t)me->prio)
+            && (l_rr.next.sig == sig) && (l_rr.next.par == par))
+        {
+            l_rr.next.valid = false; /* consume the record */
+        }
+        else {
+            l_rr.diverged = true;
+        }
+    }
+    else {
+        /* recording/replay not active */
+    }
+}
+/*..........................................................................*/
+/* replays the external inputs up to the next dispatch or internal post */
+static void QF_rrSync_(void) {
+    while ((!l_rr.diverged) && QF_rrPeek_()) {
+        uint8_t const kind = l_rr.next.kind;
+        if (kind == (uint8_t)QF_RR_TICK) {
+            l_rr.next.valid = false;
+            QF_INT_DISABLE();
+            QF_tickXISR((uint_fast8_t)l_rr.next.arg);
+            QF_INT_ENABLE();
+        }
+        else if ((kind == (uint8_t)QF_RR_EXT_POST)
+                 || (kind == (uint8_t)QF_RR_EXT_POST_ISR)
+                 || (kind == (uint8_t)QF_RR_EXT_LIFO)
+                 || (kind == (uint8_t)QF_RR_EXT_LIFO_ISR))
+        {
+            QActive * const a = QF_ROM_ACTIVE_GET_(l_rr.next.arg);
+            l_rr.next.valid = false;
+            l_rr.injecting = true;
+            if (kind == (uint8_t)QF_RR_EXT_POST) {
+#if (Q_PARAM_SIZE != 0)
+                QActive_postX_(a, QF_NO_MARGIN, (enum_t)l_rr.next.sig,
+                               (QParam)l_rr.next.par);
+#else
+                QActive_postX_(a, QF_NO_MARGIN, (enum_t)l_rr.next.sig);
+#endif
+            }
+            else if (kind == (uint8_t)QF_RR_EXT_LIFO) {
+#if (Q_PARAM_SIZE != 0)
+                QActive_postLIFOX_(a, QF_NO_MARGIN, (enum_t)l_rr.next.sig,
+                                   (QParam)l_rr.next.par);
+#else
+                QActive_postLIFOX_(a, QF_NO_MARGIN, (enum_t)l_rr.next.sig);
+#endif
+            }
+            else {
+                QF_INT_DISABLE();
+#if (Q_PARAM_SIZE != 0)
+                if (kind == (uint8_t)QF_RR_EXT_POST_ISR) {
+                    QActive_postXISR_(a, QF_NO_MARGIN,
+                        (enum_t)l_rr.next.sig, (QParam)l_rr.next.par);
+                }
+                else {
+                    QActive_postLIFOXISR_(a, QF_NO_MARGIN,
+                        (enum_t)l_rr.next.sig, (QParam)l_rr.next.par);
+                }
+#else
+                if (kind == (uint8_t)QF_RR_EXT_POST_ISR) {
+                    QActive_postXISR_(a, QF_NO_MARGIN, (enum_t)l_rr.next.sig);
+                }
+                else {
+                    QActive_postLIFOXISR_(a, QF_NO_MARGIN,
+                                          (enum_t)l_rr.next.sig);
+                }
+#endif
+                QF_INT_ENABLE();
+            }
+            l_rr.injecting = false;
+        }
+#if (QF_COALESCE_SIZE != 0)
+        else if ((kind == (uint8_t)QF_RR_EXT_LATEST)
+                 || (kind == (uint8_t)QF_RR_EXT_LATEST_ISR))
+        {
+            QActive * const a = QF_ROM_ACTIVE_GET_(l_rr.next.arg);
+            l_rr.next.valid = false;
+            l_rr.injecting = true;
+            if (kind == (uint8_t)QF_RR_EXT_LATEST) {
+#if (Q_PARAM_SIZE != 0)
+                QActive_postLatestX_(a, QF_NO_MARGIN, (enum_t)l_rr.next.sig,
+                                     (QParam)l_rr.next.par);
+#else
+                QActive_postLatestX_(a, QF_NO_MARGIN, (enum_t)l_rr.next.sig);
+#endif
+            }
+            else {
+                QF_INT_DISABLE();
+#if (Q_PARAM_SIZE != 0)
+                QActive_postLatestXISR_(a, QF_NO_MARGIN,
+                    (enum_t)l_rr.next.sig, (QParam)l_rr.next.par);
+#else
+                QActive_postLatestXISR_(a, QF_NO_MARGIN,
+                                        (enum_t)l_rr.next.sig);
+#endif
+                QF_INT_ENABLE();
+            }
+            l_rr.injecting = false;
+        }
+#endif /* (QF_COALESCE_SIZE != 0) */
+        else {
+            break; /* internal post or dispatch */
+        }
+    }
+}
+/*..........................................................................*/
+/**
+* @description
+* Replays the log recorded with QF_setRecording() into the same set of
+* active objects, as fast as possible. This function is called instead of
+* QF_run() and executes in the calling thread only (without the ticker
+* thread). The external inputs (external posts and clock ticks) are
+* injected at exactly the recorded points, the events are dispatched in
+* exactly the recorded order, and every event posted internally by the
+* active objects is verified against the log.
+*
+* @returns 0 when the whole log has been replayed, 1 when the log could
+* not be opened or does not match the application, and 2 when the replay
+* diverged from the log.
+*/
+int_t QF_replay(char_t const * const fileName) {
+    uint8_t hdr[8];
+    int_t ret = (int_t)1;
+
+    l_rr.file = fopen(fileName, "rb");
+    if (l_rr.file == (FILE *)0) {
+        return ret;
+    }
+    if ((fread(hdr, 1U, sizeof(hdr), l_rr.file) == sizeof(hdr))
+        && (hdr[0] == (uint8_t)'Q') && (hdr[1] == (uint8_t)'N')
+        && (hdr[2] == (uint8_t)'R') && (hdr[3] == (uint8_t)'R')
+        && (hdr[4] == (uint8_t)QF_RR_VERSION)
+        && (hdr[5] == (uint8_t)Q_PARAM_SIZE)
+        && (hdr[6] == (uint8_t)QF_maxActive_))
+    {
+        pthread_cond_init(&l_condVar, 0);
+        l_rr.len = 0U;
+        l_rr.pos = 0U;
+        l_rr.next.valid = false;
+        l_rr.diverged = false;
+        l_rr.mainThread = pthread_self();
+        l_rr.mode = (uint8_t)QF_RR_REPLAY;
+
+        QF_startActives_();
+
+        for (;;) {
+            QF_rrSync_(); /* replay the external inputs */
+            if (l_rr.diverged || (!QF_rrPeek_())) {
+                break;
+            }
+            if (l_rr.next.kind != (uint8_t)QF_RR_DISPATCH) {
+                l_rr.diverged = true; /* internal post not regenerated */
+                break;
+            }
+            else {
+                uint_fast8_t const p = (uint_fast8_t)l_rr.next.arg;
+                QActive * const a = QF_ROM_ACTIVE_GET_(p);
+                l_rr.next.valid = false;
+
+                QF_INT_DISABLE();
+                if (a->nUsed == (QEQueueCtr)0) {
+                    l_rr.diverged = true; /* no event to dispatch */
+                    QF_INT_ENABLE();
+                    break;
+                }
+                --a->nUsed;
+#ifdef QF_URGENT_QUEUE
+                if (a->uUsed != (QEQueueCtr)0) { /* any urgent events? */
+                    QF_getUrgent_(a);
+                }
+                else
+#endif /* QF_URGENT_QUEUE */
+                {
+                    Q_SIG(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).sig;
+#if (Q_PARAM_SIZE != 0)
+                    Q_PAR(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).par;
+#endif
+#if (QF_COALESCE_SIZE != 0)
+                    /* no longer waiting */
+                    QF_COALESCE_CLR_(a, Q_SIG(a), a->tail);
+#endif /* (QF_COALESCE_SIZE != 0) */
+                    if (a->tail == (QEQueueCtr)0) { /* wrap around? */
+                        a->tail = (QEQueueIdx)QF_FUDGED_QUEUE_LEN;
+                    }
+                    --a->tail;
+                }
+                if (((uint32_t)Q_SIG(a) != l_rr.next.sig)
+                    || (QF_RR_PAR_(Q_PAR(a)) != l_rr.next.par))
+                {
+                    l_rr.diverged = true; /* different event */
+                }
+
+                QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_GET)
+                    QS_U8_(p);         /* the priority of the active object */
+                    QS_SIG_(Q_SIG(a)); /* the signal of the event */
+                    QS_EQC_(a->nUsed); /* # events left in the queue */
+                QS_END_NOCRIT_()
+                QF_INT_ENABLE();
+
+                QHSM_DISPATCH(&a->super); /* dispatch to the HSM (RTC step) */
+
+                QF_INT_DISABLE();
+                if (a->nUsed == (QEQueueCtr)0) { /* empty queue? */
+                    QF_readySet_ &= (uint_fast8_t)
+                        ~((uint_fast8_t)1 << (p - (uint_fast8_t)1));
+                }
+                QF_INT_ENABLE();
+            }
+        }
+        ret = l_rr.diverged ? (int_t)2 : (int_t)0;
+        l_rr.mode = (uint8_t)QF_RR_OFF;
+#ifdef QF_TELEMETRY
+        if (l_telemName != (char_t const *)0) { /* block in shared memory? */
+            shm_unlink(l_telemName);
+        }
+#endif /* QF_TELEMETRY */
+        pthread_cond_destroy(&l_condVar);
+    }
+    fclose(l_rr.file);
+    return ret;
+}
+#endif /* QF_REPLAY */
+
+#ifdef QF_TELEMETRY
+/*..........................................................................*/
+/**
+* @description
+* Publishes the telemetry block in the POSIX shared-memory object of the
+* given name (e.g., "/dpp"), which the monitoring tools can map read-only.
+* Until this function is called, the telemetry is maintained in a private
+* block. This function must be called after QF_init().
+*
+* @returns true if the shared-memory object could be created and mapped
+* and false otherwise, in particular when the object already exists,
+* because another running process publishes its telemetry there. (An
+* object left behind by a killed process must be removed manually, e.g.,
+* rm /dev/shm/dpp.)
+*/
+bool QF_setTelemetry(char_t const * const shmName) {
+    QFTelemetry *blk = (QFTelemetry *)MAP_FAILED;
+    int fd = shm_open(shmName, O_CREAT | O_EXCL | O_RDWR, 0644);
+
+    if (fd >= 0) {
+        if (ftruncate(fd, (off_t)sizeof(QFTelemetry)) == 0) {
+            blk = (QFTelemetry *)mmap((void *)0, sizeof(QFTelemetry),
+                      PROT_READ | PROT_WRITE, MAP_SHARED, fd, (off_t)0);
+        }
+        close(fd); /* the mapping remains valid */
+    }
+    if (blk != (QFTelemetry *)MAP_FAILED) {
+        QF_INT_DISABLE();
+        memcpy(blk, l_telem, sizeof(QFTelemetry));
+        blk->seq = 0U;
+        l_telem = blk; /* publish from now on */
+        l_telemName = shmName;
+        QF_INT_ENABLE();
+    }
+    return blk != (QFTelemetry *)MAP_FAILED;
+}
+/*..........................................................................*/
+/* updates of the telemetry block inside the critical section, see NOTE5 */
+static void QF_telemPost_(QActive const * const me, bool const posted) {
+    QFTelemActive * const t = &l_telem->active[me->prio - 1U];
+
+    ++l_telem->seq; /* odd: update in progress */
+    __sync_synchronize();
+    if (posted) {
+        ++t->nPosted;
+        t->nUsed = (uint32_t)me->nUsed;
+        if (t->nMax < t->nUsed) {
+            t->nMax = t->nUsed;
+        }
+        l_telem->readySet = (uint32_t)QF_readySet_;
+    }
+    else {
+        ++t->nPostFailed;
+    }
+    __sync_synchronize();
+    ++l_telem->seq; /* even: update complete */
+}
+/*..........................................................................*/
+static void QF_telemDone_(QActive const * const a) {
+    QFTelemActive * const t = &l_telem->active[a->prio - 1U];
+
+    ++l_telem->seq;
+    __sync_synchronize();
+    ++t->nDispatched;
+    t->nUsed = (uint32_t)a->nUsed;
+    l_telem->readySet = (uint32_t)QF_readySet_;
+    __sync_synchronize();
+    ++l_telem->seq;
+}
+/*..........................................................................*/
+static void QF_telemTick_(uint64_t const late) {
+    uint_fast8_t p;
+#if (QF_TIMEEVT_CTR_SIZE != 0)
+    uint_fast8_t n;
+#endif /* (QF_TIMEEVT_CTR_SIZE != 0) */
+
+    ++l_telem->seq;
+    __sync_synchronize();
+    ++l_telem->nTicks;
+    l_telem->tickPeriod = (uint64_t)l_tick.tv_nsec;
+    l_telem->tickLate = late;
+    if (l_telem->tickLateMax < late) {
+        l_telem->tickLateMax = late;
+    }
+    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
+#if (QF_TIMEEVT_CTR_SIZE != 0)
+        QActive const * const a = QF_ROM_ACTIVE_GET_(p);
+        for (n = (uint_fast8_t)0; n < (uint_fast8_t)QF_MAX_TICK_RATE; ++n) {
+            l_telem->active[p - 1U].nTicks[n] =
+                (uint32_t)a->tickCtr[n].nTicks;
+#ifdef QF_TIMEEVT_PERIODIC
+            l_telem->active[p - 1U].interval[n] =
+                (uint32_t)a->tickCtr[n].interval;
+#endif /* QF_TIMEEVT_PERIODIC */
+        }
+#endif /* (QF_TIMEEVT_CTR_SIZE != 0) */
+    }
+    __sync_synchronize();
+    ++l_telem->seq;
+}
+#endif /* QF_TELEMETRY */
+
 /* NOTES: ********************************************************************
 *
 * NOTE1:
@@ -486,13 +2284,55 @@ static void *tickerThread(void *par) { /* the expected P-Thread signature */
 * To be able to run the unmodified applications designed originally for
 * RTE systems on POSIX, and to reduce the odds of resource shortages in
 * this case, the event queues of all Active Objects are "fudged" to the
-* maximum dynamic range of uint_fast8_t data type, which is 0xFF
-* (see QF_FUDGED_QUEUE_LEN).
+* maximum dynamic range of the QEQueueCtr data type, which is 0xFF, or
+* 0xFFFF when QF_EQUEUE_CTR_SIZE is 2 (see QF_FUDGED_QUEUE_LEN).
 *
 * NOTE3:
 * The callback QF_onClockTickISR() is invoked with interupts disabled
 * to emulate the ISR level. This means that only the ISR-level APIs are
 * available inside the QF_onClockTickISR() callback.
+*
+* NOTE4:
+* In the Spy configuration, the QS-nano ring buffer is sized to the maximum
+* supported by QS-nano and is emptied after every RTC step and after every
+* clock tick. The records that do not fit into the ring buffer are dropped
+* and show up as gaps in the record sequence numbers. The time stamps are
+* in microseconds of the monotonic clock.
+*
+* NOTE5:
+* All updates of the telemetry block happen inside the QF-nano critical
+* section, so there is only one writer at a time. The writer brackets every
+* update with increments of the sequence counter (sequence lock), which lets
+* the readers in other processes detect and retry torn reads without ever
+* blocking the writer. The telemetry is updated only once per event posting,
+* once per RTC step, and once per clock tick.
+*
+* NOTE6:
+* The behavior of the active objects is fully determined by the sequence
+* of the dispatched events, which in turn depends only on the external
+* inputs and on the interleaving of these inputs with the RTC steps. The
+* recording therefore distinguishes the internal posts (from the thread
+* executing QF_run() and from QF_tickXISR()), which are regenerated during
+* the replay and only verified, from the external posts (from the ticker
+* callback and other threads), which are injected by the replay. Every
+* record is written inside the critical section, so the order of the
+* records is exactly the order of the changes to the event queues.
+* The external LIFO posts are recorded as separate kinds, so that the
+* replay injects them at the front of the queue as well. Likewise, the
+* external latest-value posts are recorded as separate kinds, so that the
+* replay coalesces them with the waiting events exactly as recorded.
+*
+* NOTE7:
+* In the virtual-time configuration (QF_VIRTUAL_TIME defined) the ticker
+* thread is not started. Instead, whenever all AOs are idle, the event
+* loop itself advances the virtual clock and calls QF_onClockTickISR().
+* The clock ticks in which no time event at tick rate 0 could expire are
+* skipped by decrementing all armed down-counters at once, so the callback
+* is invoked only for the tick in which the nearest time event expires
+* (or for every tick when no time event is armed, or any time event at
+* a higher tick rate is armed). Consequently, the application must not
+* assume that QF_onClockTickISR() is called for every clock tick and
+* should use QF_getVirtualTicks() to find out the current time.
 */
 
 
@@ -0,0 +1,90 @@
+/**
+* @file
+* @brief Layout of the shared-memory telemetry block of the POSIX port
+* @cond
+******************************************************************************
+* Last updated for version 6.0.4
+* Last updated on  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, www.state-machine.com.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* Web:   www.state-machine.com
+* Email: info@state-machine.com
+******************************************************************************
+* @endcond
+*/
+#ifndef qfn_telem_h
+#define qfn_telem_h
+
+/* This header is shared between the QF-nano POSIX port (the writer) and
+* the monitoring tools (the readers), so it depends only on <stdint.h> and
+* its layout does not depend on the QP-nano configuration. Any change of
+* the layout must increment QF_TELEM_VERSION.
+*/
+#include <stdint.h>
+
+#define QF_TELEM_MAGIC        0x4C544E51U /* "QNTL" in little endian */
+#define QF_TELEM_VERSION      1U
+#define QF_TELEM_MAX_ACTIVE   8U  /* maximum # active objects in QP-nano */
+#define QF_TELEM_MAX_TICK_RATE 4U /* maximum # tick rates in QP-nano */
+
+/*! telemetry of one active object */
+typedef struct {
+    uint32_t nUsed;       /*!< current # events in the event queue */
+    uint32_t nMax;        /*!< peak # events in the event queue */
+    uint64_t nPosted;     /*!< # events posted (task and ISR level) */
+    uint64_t nPostFailed; /*!< # failed attempts to post an event */
+    uint64_t nDispatched; /*!< # events dispatched (RTC steps) */
+    uint32_t nTicks[QF_TELEM_MAX_TICK_RATE];   /*!< armed time events */
+    uint32_t interval[QF_TELEM_MAX_TICK_RATE]; /*!< periodic intervals */
+} QFTelemActive;
+
+/*! the shared-memory telemetry block */
+/**
+* @description
+* The block is protected by a sequence lock: the writer increments @c seq
+* before and after every update, so @c seq is odd while an update is in
+* progress. A reader copies the block and accepts the copy only if @c seq
+* was even and did not change during the copy. The readers never write
+* to the block, so they have no impact on the QF-nano event loop.
+*/
+typedef struct {
+    uint32_t magic;       /*!< QF_TELEM_MAGIC */
+    uint32_t version;     /*!< QF_TELEM_VERSION */
+    uint32_t size;        /*!< sizeof(QFTelemetry) */
+    uint32_t volatile seq; /*!< sequence lock */
+    uint32_t pid;         /*!< process ID of the writer */
+    uint32_t maxActive;   /*!< # active objects managed by QF-nano */
+    uint32_t maxTickRate; /*!< # tick rates used by the application */
+    uint32_t readySet;    /*!< mirror of QF_readySet_ */
+    uint64_t tickPeriod;  /*!< nominal clock tick period [ns] */
+    uint64_t nTicks;      /*!< # clock ticks processed */
+    uint64_t tickLate;    /*!< lateness of the last clock tick [ns] */
+    uint64_t tickLateMax; /*!< maximum lateness of the clock tick [ns] */
+    QFTelemActive active[QF_TELEM_MAX_ACTIVE]; /*!< [0] is priority 1 */
+} QFTelemetry;
+
+#endif /* qfn_telem_h */
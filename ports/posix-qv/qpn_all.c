@@ -0,0 +1,70 @@
+/**
+* @file
+* @brief Amalgamation of QP-nano and the POSIX port in a single translation unit
+* @ingroup ports
+* @cond
+******************************************************************************
+* Product: QF-nano emulation for POSIX with cooperative QV-nano kernel
+* Last updated for version 6.0.4
+* Last updated on  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* https://state-machine.com
+* mailto:info@state-machine.com
+******************************************************************************
+* @endcond
+*/
+
+/****************************************************************************/
+/**
+* @description
+* This file compiles QEP-nano, the QF-nano POSIX port (which replaces
+* qfn.c and qvn.c) and QS-nano (only when Q_SPY is defined) as one
+* translation unit. Build it *instead* of qepn.c, qfn_posix.c and qsn.c so
+* that a compiler without link-time optimization can inline and specialize
+* the calls between them, such as QActive_postX_() and QF_run() calling
+* QHsm_dispatch_() through the virtual table. See also src/qpn_all.c for
+* the ports based on the generic qfn.c with the QV-nano or QK-nano kernel.
+*
+* The source files are included rather than copied, so the amalgamation
+* cannot go stale. The assertion module name Q_this_module_ (see
+* Q_DEFINE_THIS_MODULE()) is renamed for every file to avoid redefining
+* it, and the assertions still report the original module names.
+*/
+#define Q_this_module_ Q_this_module_qepn_
+#include "../../src/qfn/qepn.c"
+#undef Q_this_module_
+
+#define Q_this_module_ Q_this_module_qfn_posix_
+#include "qfn_posix.c"
+#undef Q_this_module_
+
+#ifdef Q_SPY
+    #define Q_this_module_ Q_this_module_qsn_
+    #include "../../src/qsn/qsn.c"
+    #undef Q_this_module_
+#endif /* Q_SPY */
@@ -73,7 +73,11 @@ static DWORD   l_tickMsec = 10U; /* clock tick in msec (for Sleep()) */
 static bool    l_isRunning;      /* flag indicating when QF is running */
 
 /* "fudged" event queues for AOs, see NOTE2 */
+#if (QF_EQUEUE_CTR_SIZE == 1)
 #define QF_FUDGED_QUEUE_LEN  0xFFU
+#else
+#define QF_FUDGED_QUEUE_LEN  0xFFFFU
+#endif
 static QEvt l_fudgedQueue[8][QF_FUDGED_QUEUE_LEN];
 #define QF_FUDGED_QUEUE_AT_(ao_, i_) (l_fudgedQueue[(ao_)->prio - 1U][(i_)])
 
@@ -81,41 +85,429 @@ static DWORD WINAPI ticker_thread(LPVOID arg);
 
 /****************************************************************************/
 void QActive_ctor(QActive * const me, QStateHandler initial) {
+#ifndef QF_NO_VIRTUAL
     static QActiveVtbl const vtbl = { /* QActive virtual table */
         { &QHsm_init_,
           &QHsm_dispatch_ },
         &QActive_postX_,
         &QActive_postXISR_
     };
+#endif /* QF_NO_VIRTUAL */
     QHsm_ctor(&me->super, initial);
+#ifndef QF_NO_VIRTUAL
     me->super.vptr = &vtbl.super; /* hook the vptr to QActive virtual table */
+#endif /* QF_NO_VIRTUAL */
+}
+
+#ifdef QF_URGENT_QUEUE
+
+/* options of QF_postUrgent_() */
+#define QF_URGENT_LIFO_   ((uint_fast8_t)1) /* insert in front (LIFO) */
+#define QF_URGENT_ISR_    ((uint_fast8_t)2) /* posting from the ISR level */
+#define QF_URGENT_RECALL_ ((uint_fast8_t)4) /* recalling a deferred event */
+
+/****************************************************************************/
+/* must be called inside a critical section */
+#if (Q_PARAM_SIZE != 0)
+static bool QF_postUrgent_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par,
+                           uint_fast8_t const opt)
+#else
+static bool QF_postUrgent_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, uint_fast8_t const opt)
+#endif
+{
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx uqlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->uqlen);
+    QEQueueIdx nFree = uqlen - me->uUsed;
+
+    /* the fudged normal queue shares nUsed with the urgent ring buffer */
+    if (nFree > ((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed)) {
+        nFree = (QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed;
+    }
+
+    if (margin == QF_NO_MARGIN) {
+        if (nFree > (QEQueueIdx)0) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(330); /* must be able to post the urgent event */
+        }
+    }
+    else if (nFree > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        if ((opt & (QF_URGENT_LIFO_ | QF_URGENT_RECALL_)) != (uint_fast8_t)0) {
+            /* insert event in front of the urgent ring buffer (LIFO) */
+            ++me->uTail;
+            if (me->uTail == (QEQueueCtr)uqlen) {
+                me->uTail = (QEQueueCtr)0; /* wrap the tail */
+            }
+            QF_ROM_UQUEUE_AT_(acb, me->uTail).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+            QF_ROM_UQUEUE_AT_(acb, me->uTail).par = par;
+#endif
+        }
+        else {
+            /* insert event into the urgent ring buffer (FIFO) */
+            QF_ROM_UQUEUE_AT_(acb, me->uHead).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+            QF_ROM_UQUEUE_AT_(acb, me->uHead).par = par;
+#endif
+            if (me->uHead == (QEQueueCtr)0) {
+                me->uHead = (QEQueueCtr)uqlen; /* wrap the head */
+            }
+            --me->uHead;
+        }
+        ++me->uUsed;
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if (me->uMax < me->uUsed) {
+            me->uMax = me->uUsed; /* update the urgent high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(((opt & QF_URGENT_RECALL_) != (uint_fast8_t)0)
+                         ? QS_QF_ACTIVE_RECALL
+                         : (((opt & QF_URGENT_LIFO_) != (uint_fast8_t)0)
+                            ? QS_QF_ACTIVE_POST_LIFO
+                            : (((opt & QF_URGENT_ISR_) != (uint_fast8_t)0)
+                               ? QS_QF_ACTIVE_POST_ISR
+                               : QS_QF_ACTIVE_POST)))
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+            SetEvent(l_win32Event);
+        }
+    }
+    else if ((opt & QF_URGENT_RECALL_) == (uint_fast8_t)0) {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+    else {
+        /* the event stays deferred */
+    }
+
+    return (bool)margin;
 }
+/****************************************************************************/
+/* takes the oldest event of the urgent ring buffer into the AO's current
+* event, must be called inside a critical section with uUsed != 0
+*/
+static void QF_getUrgent_(QActive * const a) {
+    QActiveCB const Q_ROM *acb = &QF_active[a->prio];
+
+    --a->uUsed;
+    Q_SIG(a) = QF_ROM_UQUEUE_AT_(acb, a->uTail).sig;
+#if (Q_PARAM_SIZE != 0)
+    Q_PAR(a) = QF_ROM_UQUEUE_AT_(acb, a->uTail).par;
+#endif
+#if (QF_COALESCE_SIZE != 0)
+    QF_COALESCE_CLR_(a, Q_SIG(a), a->uTail); /* no longer waiting */
+#endif /* (QF_COALESCE_SIZE != 0) */
+    if (a->uTail == (QEQueueCtr)0) { /* wrap around? */
+        a->uTail = Q_ROM_EQUEUE_CTR(acb->uqlen);
+    }
+    --a->uTail;
+}
+
+#endif /* QF_URGENT_QUEUE */
 
 /****************************************************************************/
+/* batch posting, must be called inside a critical section */
+static bool QF_postMany_(QActive * const me, QEQueueIdx margin,
+                         QEvt const * const evts, QEQueueIdx const n,
+                         bool const isr)
+{
+    QEQueueIdx nFree = (QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed;
+    bool const guaranteed = (margin == QF_NO_MARGIN);
+    bool post;
+    QEQueueIdx i;
+#ifdef QF_URGENT_QUEUE
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx uqlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->uqlen);
+    QEQueueIdx nUrgent = (QEQueueIdx)0;
+
+    for (i = (QEQueueIdx)0; i < n; ++i) {
+        if (QF_IS_URGENT_SIG_(acb, evts[i].sig)) {
+            ++nUrgent;
+        }
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (guaranteed) {
+        margin = (QEQueueIdx)0; /* all events must fit */
+    }
+
+    /* the fudged queue shares nUsed with the urgent ring buffer */
+    post = (nFree >= n) && ((nFree - n) >= margin);
+#ifdef QF_URGENT_QUEUE
+    nFree = uqlen - me->uUsed;
+    post = post && ((nUrgent == (QEQueueIdx)0)
+           || ((nFree >= nUrgent) && ((nFree - nUrgent) >= margin)));
+#endif /* QF_URGENT_QUEUE */
+
+    if (guaranteed && (!post)) {
+        Q_ERROR_ID(360); /* must be able to post all the events */
+    }
+
+    for (i = (QEQueueIdx)0; i < n; ++i) {
+        if (post) {
+#ifdef QF_URGENT_QUEUE
+            if (QF_IS_URGENT_SIG_(acb, evts[i].sig)) {
+                /* insert event into the urgent ring buffer (FIFO) */
+                QF_ROM_UQUEUE_AT_(acb, me->uHead) = evts[i];
+                if (me->uHead == (QEQueueCtr)0) {
+                    me->uHead = (QEQueueCtr)uqlen; /* wrap the head */
+                }
+                --me->uHead;
+                ++me->uUsed;
+            }
+            else
+#endif /* QF_URGENT_QUEUE */
+            {
+                /* insert event into the ring buffer (FIFO) */
+                QF_FUDGED_QUEUE_AT_(me, me->head) = evts[i];
+                if (me->head == (QEQueueCtr)0) {
+                    me->head = (QEQueueIdx)QF_FUDGED_QUEUE_LEN; /* wrap */
+                }
+                --me->head;
+            }
+            ++me->nUsed;
+        }
+
+        QS_BEGIN_NOCRIT_(post ? (isr ? QS_QF_ACTIVE_POST_ISR
+                                     : QS_QF_ACTIVE_POST)
+                              : QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);     /* the priority of the active object */
+            QS_SIG_(evts[i].sig); /* the signal of the event */
 #if (Q_PARAM_SIZE != 0)
-bool QActive_postX_(QActive * const me, uint_fast8_t margin,
+            QS_PAR_(evts[i].par); /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed);   /* # events in the queue */
+        QS_END_NOCRIT_()
+
+    }
+
+    if (post && (n != (QEQueueIdx)0)) {
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#ifdef QF_URGENT_QUEUE
+        if (me->uMax < me->uUsed) {
+            me->uMax = me->uUsed; /* update the urgent high-water mark */
+        }
+#endif /* QF_URGENT_QUEUE */
+#endif /* QF_EQUEUE_USAGE */
+
+        /* was the queue empty before the batch? */
+        if (me->nUsed == (QEQueueCtr)n) {
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+            SetEvent(l_win32Event);
+        }
+    }
+
+    (void)isr; /* unused parameter in some configurations */
+
+    return post;
+}
+
+#if (QF_COALESCE_SIZE != 0)
+
+/****************************************************************************/
+/* latest-value posting, must be called inside a critical section */
+#if (Q_PARAM_SIZE != 0)
+static bool QF_postLatest_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par,
+                           bool const isr)
+#else
+static bool QF_postLatest_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, bool const isr)
+#endif
+{
+    QPendSet const bit = QF_COALESCE_BIT_(sig);
+
+    (void)isr; /* unused parameter in some configurations */
+
+    if ((me->pend & bit) != (QPendSet)0) { /* event already waiting? */
+#if (Q_PARAM_SIZE != 0)
+        QEQueueCtr const at = me->pendAt[QF_COALESCE_POS_(sig)];
+
+#ifdef QF_URGENT_QUEUE
+        QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+        if (QF_IS_URGENT_SIG_(acb, sig)) { /* in the urgent ring buffer? */
+            QF_ROM_UQUEUE_AT_(acb, at).par = par; /* update it in place */
+        }
+        else
+#endif /* QF_URGENT_QUEUE */
+        {
+            QF_FUDGED_QUEUE_AT_(me, at).par = par; /* update it in place */
+        }
+#endif /* (Q_PARAM_SIZE != 0) */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_COALESCE)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        margin = (QEQueueIdx)true;
+    }
+#ifdef QF_URGENT_QUEUE
+    else if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+        QEQueueCtr const at = me->uHead; /* the FIFO slot of the event */
+
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+            isr ? QF_URGENT_ISR_ : (uint_fast8_t)0);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+            isr ? QF_URGENT_ISR_ : (uint_fast8_t)0);
+#endif
+        if (margin) {
+            me->pendAt[QF_COALESCE_POS_(sig)] = at;
+            me->pend |= bit; /* the event is now waiting in the queue */
+        }
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+    else {
+        if (margin == QF_NO_MARGIN) {
+            if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+                margin = (QEQueueIdx)true; /* can post */
+            }
+            else {
+                margin = (QEQueueIdx)false; /* cannot post */
+                Q_ERROR_ID(310); /* must be able to post the event */
+            }
+        }
+        else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+        }
+
+        if (margin) { /* can post the event? */
+            /* insert event into the ring buffer (FIFO) */
+            QF_FUDGED_QUEUE_AT_(me, me->head).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+            QF_FUDGED_QUEUE_AT_(me, me->head).par = par;
+#endif
+            me->pendAt[QF_COALESCE_POS_(sig)] = me->head;
+            if (me->head == (QEQueueCtr)0) {
+                me->head = (QEQueueIdx)QF_FUDGED_QUEUE_LEN; /* wrap */
+            }
+            --me->head;
+            ++me->nUsed;
+            me->pend |= bit; /* the event is now waiting in the queue */
+#ifdef QF_EQUEUE_USAGE
+            if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+                me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me);
+            }
+#endif /* QF_EQUEUE_USAGE */
+
+            QS_BEGIN_NOCRIT_(isr ? QS_QF_ACTIVE_POST_ISR : QS_QF_ACTIVE_POST)
+                QS_U8_(me->prio);   /* the priority of the active object */
+                QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(par);       /* the parameter of the event */
+#endif
+                QS_EQC_(me->nUsed); /* # events in the queue */
+            QS_END_NOCRIT_()
+
+            /* is this the first event? */
+            if (me->nUsed == (QEQueueCtr)1) {
+                /* set the corresponding bit in the ready set */
+                QF_readySet_ |= (uint_fast8_t)
+                    ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+                SetEvent(l_win32Event);
+            }
+        }
+        else {
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+                QS_U8_(me->prio);   /* the priority of the active object */
+                QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(par);       /* the parameter of the event */
+#endif
+                QS_EQC_(me->nUsed); /* # events in the queue */
+            QS_END_NOCRIT_()
+        }
+    }
+
+    return (bool)margin;
+}
+
+#endif /* (QF_COALESCE_SIZE != 0) */
+
+/****************************************************************************/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postX_(QActive * const me, QEQueueIdx margin,
                     enum_t const sig, QParam const par)
 #else
-bool QActive_postX_(QActive * const me, uint_fast8_t margin,
+bool QActive_postX_(QActive * const me, QEQueueIdx margin,
                     enum_t const sig)
 #endif
 {
     QF_INT_DISABLE();
 
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              (uint_fast8_t)0);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              (uint_fast8_t)0);
+#endif
+        QF_INT_ENABLE();
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
     if (margin == QF_NO_MARGIN) {
-        if ((uint_fast8_t)QF_FUDGED_QUEUE_LEN > me->nUsed) {
-            margin = (uint_fast8_t)true; /* can post */
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            margin = (QEQueueIdx)true; /* can post */
         }
         else {
-            margin = (uint_fast8_t)false; /* cannot post */
+            margin = (QEQueueIdx)false; /* cannot post */
             Q_ERROR_ID(310); /* must be able to post the event */
         }
     }
-    else if (((uint_fast8_t)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
-        margin = (uint_fast8_t)true; /* can post */
+    else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
     }
     else {
-        margin = (uint_fast8_t)false; /* cannot post */
+        margin = (QEQueueIdx)false; /* cannot post */
     }
 
     if (margin) { /* can post the event? */
@@ -124,20 +516,44 @@ bool QActive_postX_(QActive * const me, uint_fast8_t margin,
 #if (Q_PARAM_SIZE != 0)
         QF_FUDGED_QUEUE_AT_(me, me->head).par = par;
 #endif
-        if (me->head == (uint_fast8_t)0) {
-            me->head = (uint_fast8_t)QF_FUDGED_QUEUE_LEN; /* wrap the head */
+        if (me->head == (QEQueueCtr)0) {
+            me->head = (QEQueueIdx)QF_FUDGED_QUEUE_LEN; /* wrap the head */
         }
         --me->head;
         ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
 
         /* is this the first event? */
-        if (me->nUsed == (uint_fast8_t)1) {
+        if (me->nUsed == (QEQueueCtr)1) {
             /* set the corresponding bit in the ready set */
             QF_readySet_ |= (uint_fast8_t)
                 ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
             SetEvent(l_win32Event);
         }
     }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
     QF_INT_ENABLE();
 
     return (bool)margin;
@@ -145,27 +561,40 @@ bool QActive_postX_(QActive * const me, uint_fast8_t margin,
 
 /****************************************************************************/
 #if (Q_PARAM_SIZE != 0)
-bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
+bool QActive_postXISR_(QActive * const me, QEQueueIdx margin,
                        enum_t const sig, QParam const par)
 #else
-bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
+bool QActive_postXISR_(QActive * const me, QEQueueIdx margin,
                        enum_t const sig)
 #endif
 {
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_ISR_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_ISR_);
+#endif
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
     if (margin == QF_NO_MARGIN) {
-        if ((uint_fast8_t)QF_FUDGED_QUEUE_LEN > me->nUsed) {
-            margin = (uint_fast8_t)true; /* can post */
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            margin = (QEQueueIdx)true; /* can post */
         }
         else {
-            margin = (uint_fast8_t)false; /* cannot post */
+            margin = (QEQueueIdx)false; /* cannot post */
             Q_ERROR_ID(310); /* must be able to post the event */
         }
     }
-    else if (((uint_fast8_t)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
-        margin = (uint_fast8_t)true; /* can post */
+    else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
     }
     else {
-        margin = (uint_fast8_t)false; /* cannot post */
+        margin = (QEQueueIdx)false; /* cannot post */
     }
 
     if (margin) { /* can post the event? */
@@ -174,23 +603,427 @@ bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
 #if (Q_PARAM_SIZE != 0)
         QF_FUDGED_QUEUE_AT_(me, me->head).par = par;
 #endif
-        if (me->head == (uint_fast8_t)0) {
-            me->head = (uint_fast8_t)QF_FUDGED_QUEUE_LEN; /* wrap the head */
+        if (me->head == (QEQueueCtr)0) {
+            me->head = (QEQueueIdx)QF_FUDGED_QUEUE_LEN; /* wrap the head */
         }
         --me->head;
         ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ISR)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
         /* is this the first event? */
-        if (me->nUsed == (uint_fast8_t)1) {
+        if (me->nUsed == (QEQueueCtr)1) {
             /* set the bit */
             QF_readySet_ |= (uint_fast8_t)
                 ((uint_fast8_t)1 << (me->prio - (uint_fast8_t)1));
             SetEvent(l_win32Event);
         }
     }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLIFOX_(QActive * const me, QEQueueIdx margin,
+                        enum_t const sig, QParam const par)
+#else
+bool QActive_postLIFOX_(QActive * const me, QEQueueIdx margin,
+                        enum_t const sig)
+#endif
+{
+    QF_INT_DISABLE();
+
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_LIFO_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_LIFO_);
+#endif
+        QF_INT_ENABLE();
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (margin == QF_NO_MARGIN) {
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(320); /* must be able to post the event */
+        }
+    }
+    else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        /* insert event in front of the ring buffer (LIFO) */
+        ++me->tail;
+        if (me->tail == (QEQueueIdx)QF_FUDGED_QUEUE_LEN) {
+            me->tail = (QEQueueCtr)0; /* wrap the tail */
+        }
+        QF_FUDGED_QUEUE_AT_(me, me->tail).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+        QF_FUDGED_QUEUE_AT_(me, me->tail).par = par;
+#endif
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_LIFO)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+            SetEvent(l_win32Event);
+        }
+    }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+    QF_INT_ENABLE();
 
     return (bool)margin;
 }
 
+/****************************************************************************/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLIFOXISR_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par)
+#else
+bool QActive_postLIFOXISR_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig)
+#endif
+{
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(&QF_active[me->prio], sig)) { /* urgent? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_LIFO_ | QF_URGENT_ISR_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_LIFO_ | QF_URGENT_ISR_);
+#endif
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (margin == QF_NO_MARGIN) {
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(320); /* must be able to post the event */
+        }
+    }
+    else if (((QEQueueIdx)QF_FUDGED_QUEUE_LEN - me->nUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        /* insert event in front of the ring buffer (LIFO) */
+        ++me->tail;
+        if (me->tail == (QEQueueIdx)QF_FUDGED_QUEUE_LEN) {
+            me->tail = (QEQueueCtr)0; /* wrap the tail */
+        }
+        QF_FUDGED_QUEUE_AT_(me, me->tail).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+        QF_FUDGED_QUEUE_AT_(me, me->tail).par = par;
+#endif
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_LIFO)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1U << (me->prio - (uint_fast8_t)1));
+            SetEvent(l_win32Event);
+        }
+    }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+bool QActive_postManyX_(QActive * const me, QEQueueIdx margin,
+                        QEvt const * const evts, QEQueueIdx const n)
+{
+    QF_INT_DISABLE();
+    margin = (QEQueueIdx)QF_postMany_(me, margin, evts, n, false);
+    QF_INT_ENABLE();
+
+    return (bool)margin;
+}
+/****************************************************************************/
+bool QActive_postManyXISR_(QActive * const me, QEQueueIdx margin,
+                           QEvt const * const evts, QEQueueIdx const n)
+{
+    return QF_postMany_(me, margin, evts, n, true);
+}
+
+#if (QF_COALESCE_SIZE != 0)
+
+/****************************************************************************/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLatestX_(QActive * const me, QEQueueIdx margin,
+                          enum_t const sig, QParam const par)
+#else
+bool QActive_postLatestX_(QActive * const me, QEQueueIdx margin,
+                          enum_t const sig)
+#endif
+{
+    /* the signal must have a bit in the QPendSet */
+    Q_REQUIRE_ID(340, QF_IS_COALESCE_SIG_(sig));
+
+    QF_INT_DISABLE();
+#if (Q_PARAM_SIZE != 0)
+    margin = (QEQueueIdx)QF_postLatest_(me, margin, sig, par, false);
+#else
+    margin = (QEQueueIdx)QF_postLatest_(me, margin, sig, false);
+#endif
+    QF_INT_ENABLE();
+
+    return (bool)margin;
+}
+/****************************************************************************/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLatestXISR_(QActive * const me, QEQueueIdx margin,
+                             enum_t const sig, QParam const par)
+#else
+bool QActive_postLatestXISR_(QActive * const me, QEQueueIdx margin,
+                             enum_t const sig)
+#endif
+{
+    /* the signal must have a bit in the QPendSet */
+    Q_REQUIRE_ID(345, QF_IS_COALESCE_SIG_(sig));
+
+#if (Q_PARAM_SIZE != 0)
+    return QF_postLatest_(me, margin, sig, par, true);
+#else
+    return QF_postLatest_(me, margin, sig, true);
+#endif
+}
+
+#endif /* (QF_COALESCE_SIZE != 0) */
+
+#ifdef QF_EQUEUE_USAGE
+
+/****************************************************************************/
+void QActive_resetQueueMax(QActive * const me) {
+    QF_INT_DISABLE();
+    me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me);
+#ifdef QF_URGENT_QUEUE
+    me->uMax = me->uUsed;
+#endif /* QF_URGENT_QUEUE */
+    QF_INT_ENABLE();
+}
+
+/****************************************************************************/
+void QF_reportQueueUsage(void) {
+    uint_fast8_t p;
+    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
+#ifdef QF_URGENT_QUEUE
+        QF_onQueueUsage(p,
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].qlen),
+            QActive_getQueueMax(QF_ROM_ACTIVE_GET_(p)),
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].uqlen),
+            QActive_getUrgentQueueMax(QF_ROM_ACTIVE_GET_(p)));
+#else
+        QF_onQueueUsage(p,
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].qlen),
+            QActive_getQueueMax(QF_ROM_ACTIVE_GET_(p)));
+#endif /* QF_URGENT_QUEUE */
+    }
+}
+
+#endif /* QF_EQUEUE_USAGE */
+
+#ifdef QF_DEFER
+
+/****************************************************************************/
+bool QActive_defer(QActive * const me) {
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx dlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->dlen);
+    bool deferred;
+
+    if (dlen > (QEQueueIdx)me->dUsed) {
+        /* insert the current event into the deferral ring buffer (FIFO) */
+        QF_ROM_DEFER_AT_(acb, me->dHead) = me->super.evt;
+        if (me->dHead == (QEQueueCtr)0) {
+            me->dHead = (QEQueueCtr)dlen; /* wrap the head */
+        }
+        --me->dHead;
+        ++me->dUsed;
+        deferred = true;
+
+        QS_BEGIN_(QS_QF_ACTIVE_DEFER)
+            QS_U8_(me->prio);       /* the priority of the active object */
+            QS_SIG_(me->super.evt.sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(me->super.evt.par); /* the parameter of the event */
+#endif
+            QS_EQC_(me->dUsed);     /* # deferred events */
+        QS_END_()
+    }
+    else {
+        deferred = false;
+
+        QS_BEGIN_(QS_QF_ACTIVE_DEFER_ATTEMPT)
+            QS_U8_(me->prio);       /* the priority of the active object */
+            QS_SIG_(me->super.evt.sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(me->super.evt.par); /* the parameter of the event */
+#endif
+            QS_EQC_(me->dUsed);     /* # deferred events */
+        QS_END_()
+    }
+    return deferred;
+}
+
+/****************************************************************************/
+bool QActive_recall(QActive * const me) {
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    bool recalled = false;
+
+    if (me->dUsed != (QEQueueCtr)0) { /* any deferred events? */
+        QF_INT_DISABLE();
+
+#ifdef QF_URGENT_QUEUE
+        if (QF_IS_URGENT_SIG_(acb, QF_ROM_DEFER_AT_(acb, me->dTail).sig)) {
+            recalled = QF_postUrgent_(me, (QEQueueIdx)0,
+                (enum_t)QF_ROM_DEFER_AT_(acb, me->dTail).sig,
+#if (Q_PARAM_SIZE != 0)
+                QF_ROM_DEFER_AT_(acb, me->dTail).par,
+#endif
+                QF_URGENT_RECALL_);
+        }
+        else
+#endif /* QF_URGENT_QUEUE */
+        /* free slot in the queue? */
+        if ((QEQueueIdx)QF_FUDGED_QUEUE_LEN > me->nUsed) {
+            /* insert the event in front of the queue (LIFO) */
+            ++me->tail;
+            if (me->tail == (QEQueueIdx)QF_FUDGED_QUEUE_LEN) {
+                me->tail = (QEQueueCtr)0; /* wrap the tail */
+            }
+            QF_FUDGED_QUEUE_AT_(me, me->tail) =
+                QF_ROM_DEFER_AT_(acb, me->dTail);
+            ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+            if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+                me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me);
+            }
+#endif /* QF_EQUEUE_USAGE */
+
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_RECALL)
+                QS_U8_(me->prio);   /* the priority of the active object */
+                QS_SIG_(QF_FUDGED_QUEUE_AT_(me, me->tail).sig);
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(QF_FUDGED_QUEUE_AT_(me, me->tail).par);
+#endif
+                QS_EQC_(me->nUsed); /* # events in the queue */
+            QS_END_NOCRIT_()
+
+            /* is this the first event? */
+            if (me->nUsed == (QEQueueCtr)1) {
+                /* set the bit, the AO is running in the event loop */
+                QF_readySet_ |= (uint_fast8_t)
+                    ((uint_fast8_t)1 << (me->prio - (uint_fast8_t)1));
+            }
+            recalled = true;
+        }
+
+        QF_INT_ENABLE();
+
+        if (recalled) { /* remove the event from the deferral ring buffer */
+            if (me->dTail == (QEQueueCtr)0) {
+                me->dTail = Q_ROM_EQUEUE_CTR(acb->dlen); /* wrap the tail */
+            }
+            --me->dTail;
+            --me->dUsed;
+        }
+    }
+    return recalled;
+}
+
+#endif /* QF_DEFER */
+
 
 /****************************************************************************/
 /****************************************************************************/
@@ -198,6 +1031,11 @@ bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
 
 void QF_tickXISR(uint_fast8_t const tickRate) {
     uint_fast8_t p = QF_maxActive_;
+
+    QS_BEGIN_ISR_(QS_QF_TICK)
+        QS_U8_(tickRate); /* the tick rate */
+    QS_END_ISR_()
+
     do {
         QActive *a = QF_ROM_ACTIVE_GET_(p);
         QTimer *t = &a->tickCtr[tickRate];
@@ -217,6 +1055,11 @@ void QF_tickXISR(uint_fast8_t const tickRate) {
                     ~((uint_fast8_t)1 << (p - (uint_fast8_t)1));
 #endif /* QF_TIMEEVT_USAGE */
 
+                QS_BEGIN_ISR_(QS_QF_TIMEEVT_POST)
+                    QS_U8_(p);        /* the priority of the active object */
+                    QS_U8_(tickRate); /* the tick rate */
+                QS_END_ISR_()
+
 #if (Q_PARAM_SIZE != 0)
                 QACTIVE_POST_ISR(a, (enum_t)Q_TIMEOUT_SIG + (enum_t)tickRate,
                                  (QParam)0);
@@ -331,9 +1174,36 @@ void QF_init(uint_fast8_t maxActive) {
         /* QF_active[p] must be initialized */
         Q_ASSERT_ID(110, a != (QActive *)0);
 
-        a->head    = (uint_fast8_t)0;
-        a->tail    = (uint_fast8_t)0;
-        a->nUsed   = (uint_fast8_t)0;
+#ifdef QF_URGENT_QUEUE
+        /* urgent signals need the urgent ring buffer */
+        Q_ASSERT_ID(120, (Q_ROM_SIG(QF_active[p].usig) == (QSignal)0)
+                         || (Q_ROM_EQUEUE_CTR(QF_active[p].uqlen)
+                             != (QEQueueCtr)0));
+#endif /* QF_URGENT_QUEUE */
+
+        a->prio    = (uint8_t)p; /* known already before QF_run() */
+        a->head    = (QEQueueCtr)0;
+        a->tail    = (QEQueueCtr)0;
+        a->nUsed   = (QEQueueCtr)0;
+#ifdef QF_EQUEUE_USAGE
+        a->nMax    = (QEQueueCtr)0;
+#endif /* QF_EQUEUE_USAGE */
+#ifdef QF_DEFER
+        a->dHead   = (QEQueueCtr)0;
+        a->dTail   = (QEQueueCtr)0;
+        a->dUsed   = (QEQueueCtr)0;
+#endif /* QF_DEFER */
+#ifdef QF_URGENT_QUEUE
+        a->uHead   = (QEQueueCtr)0;
+        a->uTail   = (QEQueueCtr)0;
+        a->uUsed   = (QEQueueCtr)0;
+#ifdef QF_EQUEUE_USAGE
+        a->uMax    = (QEQueueCtr)0;
+#endif /* QF_EQUEUE_USAGE */
+#endif /* QF_URGENT_QUEUE */
+#if (QF_COALESCE_SIZE != 0)
+        a->pend    = (QPendSet)0;
+#endif /* (QF_COALESCE_SIZE != 0) */
 #if (QF_TIMEEVT_CTR_SIZE != 0)
         for (n = (uint_fast8_t)0; n < (uint_fast8_t)QF_MAX_TICK_RATE; ++n) {
             a->tickCtr[n].nTicks   = (QTimeEvtCtr)0;
@@ -360,6 +1230,11 @@ int_t QF_run(void) {
         Q_ASSERT_ID(810, a != (QActive *)0);
 
         a->prio = p; /* set the priority of the active object */
+
+        QS_BEGIN_(QS_QF_ACTIVE_ADD)
+            QS_U8_(p);   /* the priority of the active object */
+            QS_OBJ_(a);  /* the active object */
+        QS_END_()
     }
 
     /* trigger initial transitions in all registered active objects... */
@@ -392,24 +1267,43 @@ int_t QF_run(void) {
             a = QF_ROM_ACTIVE_GET_(p);
 
             /* some unsuded events must be available */
-            Q_ASSERT_ID(820, a->nUsed > (uint_fast8_t)0);
+            Q_ASSERT_ID(820, a->nUsed > (QEQueueCtr)0);
 
             --a->nUsed;
-            Q_SIG(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).sig;
+#ifdef QF_URGENT_QUEUE
+            if (a->uUsed != (QEQueueCtr)0) { /* any urgent events? */
+                QF_getUrgent_(a);
+            }
+            else
+#endif /* QF_URGENT_QUEUE */
+            {
+                Q_SIG(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).sig;
 #if (Q_PARAM_SIZE != 0)
-            Q_PAR(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).par;
+                Q_PAR(a) = QF_FUDGED_QUEUE_AT_(a, a->tail).par;
 #endif
-            if (a->tail == (uint_fast8_t)0) { /* wrap around? */
-                a->tail = (uint_fast8_t)QF_FUDGED_QUEUE_LEN;
+#if (QF_COALESCE_SIZE != 0)
+                /* no longer waiting */
+                QF_COALESCE_CLR_(a, Q_SIG(a), a->tail);
+#endif /* (QF_COALESCE_SIZE != 0) */
+                if (a->tail == (QEQueueCtr)0) { /* wrap around? */
+                    a->tail = (QEQueueIdx)QF_FUDGED_QUEUE_LEN;
+                }
+                --a->tail;
             }
-            --a->tail;
+
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_GET)
+                QS_U8_(p);         /* the priority of the active object */
+                QS_SIG_(Q_SIG(a)); /* the signal of the event */
+                QS_EQC_(a->nUsed); /* # events left in the queue */
+            QS_END_NOCRIT_()
+
             QF_INT_ENABLE();
 
             QHSM_DISPATCH(&a->super); /* dispatch to the HSM (RTC step) */
 
             QF_INT_DISABLE();
             /* empty queue? */
-            if (a->nUsed == (uint_fast8_t)0) {
+            if (a->nUsed == (QEQueueCtr)0) {
                 /* clear the bit corresponding to 'p' */
                 QF_readySet_ &= (uint_fast8_t)
                     ~((uint_fast8_t)1 << (p - (uint_fast8_t)1));
@@ -480,8 +1374,8 @@ static DWORD WINAPI ticker_thread(LPVOID par) {
 * To be able to run the unmodified applications designed originally for
 * RTE systems on Windows, and to reduce the odds of resource shortages in
 * this case, the event queues of all Active Objects are "fudged" to the
-* maximum dynamic range of uint_fast8_t data type, which is 0xFF
-* (see QF_FUDGED_QUEUE_LEN).
+* maximum dynamic range of the QEQueueCtr data type, which is 0xFF, or
+* 0xFFFF when QF_EQUEUE_CTR_SIZE is 2 (see QF_FUDGED_QUEUE_LEN).
 */
 
 
@@ -40,6 +40,7 @@
 #define QP_IMPL       /* this is QP implementation */
 #include "qpn_conf.h" /* QP-nano configuration file (from the application) */
 #include "qfn_port.h" /* QF-nano port from the port directory */
+#include "qsn.h"      /* QS-nano software tracing interface */
 #include "qassert.h"  /* embedded systems-friendly assertions */
 
 Q_DEFINE_THIS_MODULE("qepn")
@@ -52,15 +53,100 @@ char_t const Q_ROM QP_versionStr[6] = QP_VERSION_STR;
 /*! empty signal for internal use only */
 #define QEP_EMPTY_SIG_        ((QSignal)0)
 
-/*! maximum depth of state nesting in HSMs (including the top level),
-* must be >= 2
-*/
-#define QHSM_MAX_NEST_DEPTH_  ((int_fast8_t)5)
+/*! helper macro to trigger the entry action in an HSM and trace it */
+#define QEP_ENTER_(state_) do { \
+    if ((*(state_))(me) == (QState)Q_RET_HANDLED) { \
+        QS_BEGIN_(QS_QEP_STATE_ENTRY) \
+            QS_OBJ_(me); \
+            QS_FUN_(state_); \
+        QS_END_() \
+    } \
+} while (0)
+
+/*! helper macro to trigger the exit action in an HSM and trace it */
+#define QEP_EXIT_(state_) do { \
+    if ((*(state_))(me) == (QState)Q_RET_HANDLED) { \
+        QS_BEGIN_(QS_QEP_STATE_EXIT) \
+            QS_OBJ_(me); \
+            QS_FUN_(state_); \
+        QS_END_() \
+    } \
+    QEP_SAVE_HIST_(state_); \
+} while (0)
 
 /*! helper function to execute a transition chain in HSM */
 static int_fast8_t QHsm_tran_(QHsm * const me,
                               QStateHandler path[QHSM_MAX_NEST_DEPTH_]);
 
+#ifdef QHSM_HISTORY
+
+/*! helper macro to update the history slot of an exited state (if any) */
+#define QEP_SAVE_HIST_(state_) QHsm_saveHist_(me, (state_))
+
+/*! helper function to update the history slot of an exited state */
+static void QHsm_saveHist_(QHsm * const me, QStateHandler const s);
+
+/*! helper function to enter the substates stored in a history slot */
+static QStateHandler QHsm_restoreHist_(QHsm * const me,
+                                       QStateHandler const s,
+                                       QState const r);
+
+#else
+
+#define QEP_SAVE_HIST_(state_) ((void)0)
+
+#endif /* QHSM_HISTORY */
+
+#ifdef QHSM_SUBMACHINE
+
+/*! helper macro to redirect the initial transition of the submachine
+* state @p t_ that returned @p r_ to the entry point of its submachine
+*/
+#define QEP_ENTRY_POINT_(r_, t_) do { \
+    if ((r_) == (QState)Q_RET_TRAN_EP) { \
+        Q_ASSERT_ID(700, me->temp == (t_)); \
+        me->host = (t_); \
+        me->temp = me->ep; \
+        (r_) = (QState)Q_RET_TRAN; \
+    } \
+} while (0)
+
+#else
+
+#define QEP_ENTRY_POINT_(r_, t_) ((void)0)
+
+#endif /* QHSM_SUBMACHINE */
+
+#if (QHSM_SIG_MASK_SIZE != 0)
+
+/*! helper macro to update the handled signals after a transition to @p t_
+* (an HSM without a table keeps handling all signals)
+*/
+#define QEP_UPDATE_SIGS_(t_) do { \
+    if (me->nMasks != (uint8_t)0) { \
+        me->sigs = QHsm_sigs_(me, (t_)); \
+    } \
+} while (0)
+
+/*! helper macro to test whether any active state handles the signal @p sig_
+* (only the signals covered by ::QSigMask can be discarded)
+*/
+#define QEP_IS_HANDLED_(sig_) \
+    (((QSignal)((QSignal)(sig_) - (QSignal)Q_TIMEOUT_SIG) \
+      >= (QSignal)(8U * QHSM_SIG_MASK_SIZE)) \
+     || ((me->sigs & Q_SIG_BIT(sig_)) != (QSigMask)0))
+
+/*! helper function to combine the handled signals of the state @p t
+* and all its superstates
+*/
+static QSigMask QHsm_sigs_(QHsm * const me, QStateHandler t);
+
+#else
+
+#define QEP_UPDATE_SIGS_(t_) ((void)0)
+
+#endif /* (QHSM_SIG_MASK_SIZE != 0) */
+
 /****************************************************************************/
 /**
 * @description
@@ -82,13 +168,27 @@ static int_fast8_t QHsm_tran_(QHsm * const me,
 * @include qepn_qhsm_ctor.c
 */
 void QHsm_ctor(QHsm * const me, QStateHandler initial) {
+#ifndef QF_NO_VIRTUAL
     static QHsmVtbl const vtbl = { /* QHsm virtual table */
         &QHsm_init_,
         &QHsm_dispatch_
     };
     me->vptr  = &vtbl;
+#endif /* QF_NO_VIRTUAL */
     me->state = Q_STATE_CAST(&QHsm_top);
     me->temp  = initial;
+#ifdef QHSM_HISTORY
+    me->hist  = (QHsmHist *)0;
+#endif /* QHSM_HISTORY */
+#ifdef QHSM_SUBMACHINE
+    me->host  = Q_STATE_CAST(&QHsm_top);
+    me->ep    = Q_STATE_CAST(0);
+#endif /* QHSM_SUBMACHINE */
+#if (QHSM_SIG_MASK_SIZE != 0)
+    me->masks  = (QHsmMask const Q_ROM *)0;
+    me->sigs   = (QSigMask)~(QSigMask)0; /* all signals handled */
+    me->nMasks = (uint8_t)0;
+#endif /* (QHSM_SIG_MASK_SIZE != 0) */
 }
 
 /****************************************************************************/
@@ -109,15 +209,26 @@ void QHsm_init_(QHsm * const me) {
     * transition must be initialized, and the initial transition must not
     * be taken yet.
     */
+#ifndef QF_NO_VIRTUAL
     Q_REQUIRE_ID(200, (me->vptr != (QHsmVtbl const *)0)
                       && (me->temp != Q_STATE_CAST(0))
                       && (t == Q_STATE_CAST(&QHsm_top)));
+#else
+    Q_REQUIRE_ID(200, (me->temp != Q_STATE_CAST(0))
+                      && (t == Q_STATE_CAST(&QHsm_top)));
+#endif /* QF_NO_VIRTUAL */
 
     r = (*me->temp)(me); /* execute the top-most initial transition */
 
     /* the top-most initial transition must be taken */
     Q_ASSERT_ID(210, r == (QState)Q_RET_TRAN);
 
+    QS_BEGIN_(QS_QEP_STATE_INIT)
+        QS_OBJ_(me);        /* this state machine object */
+        QS_FUN_(t);         /* the source state */
+        QS_FUN_(me->temp);  /* the target of the initial transition */
+    QS_END_()
+
     /* drill down into the state hierarchy with initial transitions... */
     do {
         QStateHandler path[QHSM_MAX_NEST_DEPTH_];
@@ -137,7 +248,7 @@ void QHsm_init_(QHsm * const me) {
         /* retrace the entry path in reverse (desired) order... */
         Q_SIG(me) = (QSignal)Q_ENTRY_SIG;
         do {
-            (void)(*path[ip])(me); /* enter path[ip] */
+            QEP_ENTER_(path[ip]); /* enter path[ip] */
             --ip;
         } while (ip >= (int_fast8_t)0);
 
@@ -145,8 +256,23 @@ void QHsm_init_(QHsm * const me) {
 
         Q_SIG(me) = (QSignal)Q_INIT_SIG;
         r = (*t)(me);
+        QEP_ENTRY_POINT_(r, t);
+
+        if (r == (QState)Q_RET_TRAN) {
+            QS_BEGIN_(QS_QEP_STATE_INIT)
+                QS_OBJ_(me);        /* this state machine object */
+                QS_FUN_(t);         /* the source state */
+                QS_FUN_(me->temp);  /* the target of the initial transition */
+            QS_END_()
+        }
     } while (r == (QState)Q_RET_TRAN);
 
+    QS_BEGIN_(QS_QEP_INIT_TRAN)
+        QS_OBJ_(me); /* this state machine object */
+        QS_FUN_(t);  /* the new active state */
+    QS_END_()
+
+    QEP_UPDATE_SIGS_(t);
     me->state = t; /* change the current active state */
     me->temp  = t; /* mark the configuration as stable */
 }
@@ -188,7 +314,7 @@ void QHsm_dispatch_(QHsm * const me) {
     QStateHandler t = me->state;
     QStateHandler s;
     QState r;
-    int_fast8_t iq; /* helper transition entry path index */
+    QSignal sig; /* the original signal of the event */
 
     /** @pre the current state must be initialized and
     * the state configuration must be stable
@@ -196,18 +322,34 @@ void QHsm_dispatch_(QHsm * const me) {
     Q_REQUIRE_ID(400, (t != Q_STATE_CAST(0))
                       && (t == me->temp));
 
+    QS_BEGIN_(QS_QEP_DISPATCH)
+        QS_OBJ_(me);        /* this state machine object */
+        QS_SIG_(Q_SIG(me)); /* the signal of the event */
+        QS_FUN_(t);         /* the current state */
+    QS_END_()
+
+#if (QHSM_SIG_MASK_SIZE != 0)
+    if (!QEP_IS_HANDLED_(Q_SIG(me))) { /* no active state handles it? */
+        QS_BEGIN_(QS_QEP_IGNORED)
+            QS_OBJ_(me); /* this state machine object */
+            QS_FUN_(t);  /* the current state */
+        QS_END_()
+        return; /* discard the event without calling any state handler */
+    }
+#endif /* (QHSM_SIG_MASK_SIZE != 0) */
+
     /* process the event hierarchically... */
     do {
         s = me->temp;
         r = (*s)(me); /* invoke state handler s */
 
         if (r == (QState)Q_RET_UNHANDLED) { /* unhandled due to a guard? */
-            iq = (int_fast8_t)Q_SIG(me); /* save the original signal */
+            sig = Q_SIG(me); /* save the original signal */
             Q_SIG(me) = (QSignal)QEP_EMPTY_SIG_; /* find the superstate */
             r = (*s)(me); /* invoke state handler s */
-            Q_SIG(me) = (QSignal)iq; /* restore the original signal */
+            Q_SIG(me) = sig; /* restore the original signal */
         }
-    } while (r == (QState)Q_RET_SUPER);
+    } while (r <= (QState)Q_RET_SUPER_SUB); /* superstate or host state? */
 
     /* transition taken? */
     if (r >= (QState)Q_RET_TRAN) {
@@ -218,15 +360,27 @@ void QHsm_dispatch_(QHsm * const me) {
         path[1] = t;
         path[2] = s;
 
+#ifdef QHSM_HISTORY
+        if (r > (QState)Q_RET_TRAN_HIST) { /* transition to native history? */
+            QHsm_saveHist_(me, path[0]); /* the target might not be exited */
+        }
+#endif /* QHSM_HISTORY */
+
         /* exit current state to transition source s... */
         for (; t != s; t = me->temp) {
             Q_SIG(me) = (QSignal)Q_EXIT_SIG; /* find superstate of t */
 
             /* take the exit action and check if it was handled? */
             if ((*t)(me) == (QState)Q_RET_HANDLED) {
+                QS_BEGIN_(QS_QEP_STATE_EXIT)
+                    QS_OBJ_(me); /* this state machine object */
+                    QS_FUN_(t);  /* the exited state */
+                QS_END_()
+
                 Q_SIG(me) = (QSignal)QEP_EMPTY_SIG_;
                 (void)(*t)(me); /* find superstate of t */
             }
+            QEP_SAVE_HIST_(t);
         }
 
         ip = QHsm_tran_(me, path); /* take the state transition */
@@ -234,14 +388,30 @@ void QHsm_dispatch_(QHsm * const me) {
         /* retrace the entry path in reverse (desired) order... */
         Q_SIG(me) = (QSignal)Q_ENTRY_SIG;
         for (; ip >= (int_fast8_t)0; --ip) {
-            (void)(*path[ip])(me); /* enter path[ip] */
+            QEP_ENTER_(path[ip]); /* enter path[ip] */
         }
         t = path[0];      /* stick the target into register */
+#ifdef QHSM_HISTORY
+        if (r > (QState)Q_RET_TRAN_HIST) { /* transition to native history? */
+            t = QHsm_restoreHist_(me, t, r); /* enter the stored substates */
+        }
+#endif /* QHSM_HISTORY */
         me->temp = t; /* update the current state */
 
         /* drill into the target hierarchy... */
         Q_SIG(me) = (QSignal)Q_INIT_SIG;
-        while ((*t)(me) == (QState)Q_RET_TRAN) {
+        if (r != (QState)Q_RET_TRAN_EP) { /* not an entry point of t? */
+            r = (*t)(me);
+        }
+        QEP_ENTRY_POINT_(r, t);
+        while (r == (QState)Q_RET_TRAN) {
+
+            QS_BEGIN_(QS_QEP_STATE_INIT)
+                QS_OBJ_(me);        /* this state machine object */
+                QS_FUN_(t);         /* the source state */
+                QS_FUN_(me->temp);  /* the target of the initial transition */
+            QS_END_()
+
             ip = (int_fast8_t)0;
 
             path[0] = me->temp;
@@ -260,13 +430,34 @@ void QHsm_dispatch_(QHsm * const me) {
             /* retrace the entry path in reverse (correct) order... */
             Q_SIG(me) = (QSignal)Q_ENTRY_SIG;
             do {
-                (void)(*path[ip])(me); /* enter path[ip] */
+                QEP_ENTER_(path[ip]); /* enter path[ip] */
                 --ip;
             } while (ip >= (int_fast8_t)0);
 
             t = path[0];
             Q_SIG(me) = (QSignal)Q_INIT_SIG;
+            r = (*t)(me);
+            QEP_ENTRY_POINT_(r, t);
         }
+        QEP_UPDATE_SIGS_(t);
+
+        QS_BEGIN_(QS_QEP_TRAN)
+            QS_OBJ_(me); /* this state machine object */
+            QS_FUN_(s);  /* the source of the transition */
+            QS_FUN_(t);  /* the new active state */
+        QS_END_()
+    }
+    else if (r == (QState)Q_RET_HANDLED) {
+        QS_BEGIN_(QS_QEP_INTERN_TRAN)
+            QS_OBJ_(me); /* this state machine object */
+            QS_FUN_(s);  /* the state that handled the event */
+        QS_END_()
+    }
+    else {
+        QS_BEGIN_(QS_QEP_IGNORED)
+            QS_OBJ_(me); /* this state machine object */
+            QS_FUN_(t);  /* the current state */
+        QS_END_()
     }
 
     me->state = t; /* change the current active state */
@@ -297,7 +488,7 @@ static int_fast8_t QHsm_tran_(QHsm * const me,
     /* (a) check source==target (transition to self) */
     if (s == t) {
         Q_SIG(me) = (QSignal)Q_EXIT_SIG;
-        (void)(*s)(me);      /* exit the source */
+        QEP_EXIT_(s);        /* exit the source */
         ip = (int_fast8_t)0; /* enter the target */
     }
     else {
@@ -316,14 +507,14 @@ static int_fast8_t QHsm_tran_(QHsm * const me,
             /* (c) check source->super==target->super */
             if (me->temp == t) {
                 Q_SIG(me) = (QSignal)Q_EXIT_SIG;
-                (void)(*s)(me);     /* exit the source */
+                QEP_EXIT_(s);       /* exit the source */
                 ip = (int_fast8_t)0; /* enter the target */
             }
             else {
                 /* (d) check source->super==target */
                 if (me->temp == path[0]) {
                     Q_SIG(me) = (QSignal)Q_EXIT_SIG;
-                    (void)(*s)(me); /* exit the source */
+                    QEP_EXIT_(s);   /* exit the source */
                 }
                 else {
                     /* (e) check rest of source==target->super->super..
@@ -337,7 +528,7 @@ static int_fast8_t QHsm_tran_(QHsm * const me,
                     /* find target->super->super... */
                     Q_SIG(me) = (QSignal)QEP_EMPTY_SIG_;
                     r = (*path[1])(me);
-                    while (r == (QState)Q_RET_SUPER) {
+                    while (r <= (QState)Q_RET_SUPER_SUB) {
                         ++ip;
                         path[ip] = me->temp; /* store the entry path */
                         if (me->temp == s) { /* is it the source? */
@@ -361,7 +552,7 @@ static int_fast8_t QHsm_tran_(QHsm * const me,
                         Q_ASSERT_ID(520, ip < QHSM_MAX_NEST_DEPTH_);
 
                         Q_SIG(me) = (QSignal)Q_EXIT_SIG;
-                        (void)(*s)(me); /* exit the source */
+                        QEP_EXIT_(s);   /* exit the source */
 
                         /* (f) check the rest of source->super
                         *                  == target->super->super...
@@ -391,9 +582,14 @@ static int_fast8_t QHsm_tran_(QHsm * const me,
                                 /* exit t unhandled? */
                                 Q_SIG(me) = (QSignal)Q_EXIT_SIG;
                                 if ((*t)(me) == (QState)Q_RET_HANDLED) {
+                                    QS_BEGIN_(QS_QEP_STATE_EXIT)
+                                        QS_OBJ_(me);
+                                        QS_FUN_(t);
+                                    QS_END_()
                                     Q_SIG(me) = (QSignal)QEP_EMPTY_SIG_;
                                     (void)(*t)(me); /* find super of t */
                                 }
+                                QEP_SAVE_HIST_(t);
                                 t = me->temp; /* set to super of t */
                                 iq = ip;
                                 do {
@@ -471,3 +667,263 @@ QStateHandler QHsm_childState_(QHsm * const me,
 
     return child; /* return the child */
 }
+
+#ifdef QHSM_HISTORY
+
+/****************************************************************************/
+/**
+* @description
+* Registers the history slot @p hist of the composite state @p state, so
+* that QEP-nano keeps the history of the state and the state can be the
+* target of Q_TRAN_HIST_SHALLOW() and Q_TRAN_HIST_DEEP().
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in,out] hist  pointer to the history slot
+* @param[in]     state the composite state (must not be the top state)
+*
+* @note
+* Must be called in the "constructor" of the derived state machine, after
+* QHsm_ctor() (or QActive_ctor()) and before QHSM_INIT().
+*/
+void QHsm_addHist(QHsm * const me, QHsmHist * const hist,
+                  QStateHandler const state)
+{
+    hist->state = state;
+    hist->depth = (uint8_t)0; /* no history until the first exit */
+    hist->next  = me->hist;
+    me->hist    = hist;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Static helper function, which stores the path from the current leaf
+* state up to (but not including) the state @p s in the history slot of
+* @p s, if @p s has one and is the leaf state or its superstate. It is
+* called after every exit of a state and before a transition to native
+* history (whose target might not be exited). Both happen only during
+* transitions, while me->state still holds the leaf state of the
+* configuration before the transition.
+*
+* @param[in,out] me pointer (see @ref oop)
+* @param[in]     s  the exited state or the target of the transition
+*/
+static void QHsm_saveHist_(QHsm * const me, QStateHandler const s) {
+    QHsmHist *hist = me->hist;
+
+    while ((hist != (QHsmHist *)0) && (hist->state != s)) {
+        hist = hist->next;
+    }
+    if (hist != (QHsmHist *)0) { /* does the state keep history? */
+        QStateHandler path[QHSM_MAX_NEST_DEPTH_];
+        QStateHandler const temp = me->temp; /* preserve the transition */
+        QSignal const sig = Q_SIG(me);
+        QStateHandler t = me->state; /* start with the leaf state */
+        int_fast8_t ip = (int_fast8_t)0;
+        QState r = (QState)Q_RET_SUPER;
+
+        Q_SIG(me) = (QSignal)QEP_EMPTY_SIG_;
+        while ((t != s) && (r <= (QState)Q_RET_SUPER_SUB)) {
+            /* the path must not overflow */
+            Q_ASSERT_ID(610, ip < QHSM_MAX_NEST_DEPTH_);
+
+            path[ip] = t;
+            ++ip;
+            r = (*t)(me); /* find superstate of t */
+            t = me->temp;
+        }
+        if (t == s) { /* the state is the leaf state or its superstate? */
+            /* the history path must fit in the slot */
+            Q_ASSERT_ID(620, ip <= (int_fast8_t)Q_DIM(hist->path));
+
+            hist->depth = (uint8_t)ip;
+#ifdef QHSM_SUBMACHINE
+            hist->host  = me->host; /* the submachine active in the path */
+#endif /* QHSM_SUBMACHINE */
+            while (ip > (int_fast8_t)0) {
+                --ip;
+                hist->path[ip] = path[ip];
+            }
+        }
+        Q_SIG(me) = sig;
+        me->temp  = temp;
+    }
+}
+
+/****************************************************************************/
+/**
+* @description
+* Static helper function to complete a transition to the native history
+* of the composite state @p s, which has just been entered. Enters the
+* substates stored in the history slot of @p s (only the direct substate
+* for the shallow history), without discovering them through superstates.
+*
+* @param[in,out] me pointer (see @ref oop)
+* @param[in]     s  the composite state with history
+* @param[in]     r  #Q_RET_TRAN_HIST_SHALLOW or #Q_RET_TRAN_HIST_DEEP
+*
+* @returns the last entered state, from which the transition continues
+* with the nested initial transitions.
+*/
+static QStateHandler QHsm_restoreHist_(QHsm * const me,
+                                       QStateHandler const s,
+                                       QState const r)
+{
+    QHsmHist const *hist = me->hist;
+    QStateHandler t = s;
+    int_fast8_t ip;
+    int_fast8_t iq;
+
+    while ((hist != (QHsmHist *)0) && (hist->state != s)) {
+        hist = hist->next;
+    }
+
+    /** @pre the target of the history transition must have a history slot
+    * registered with QHsm_addHist()
+    */
+    Q_REQUIRE_ID(600, hist != (QHsmHist *)0);
+
+    ip = (int_fast8_t)((int_fast8_t)hist->depth - (int_fast8_t)1);
+    iq = (int_fast8_t)0; /* enter the whole stored path (deep history) */
+    if ((r != (QState)Q_RET_TRAN_HIST_DEEP) && (ip > (int_fast8_t)0)) {
+        iq = ip; /* enter only the direct substate of s (shallow history) */
+    }
+
+#ifdef QHSM_SUBMACHINE
+    if (ip >= (int_fast8_t)0) { /* any history stored? */
+        me->host = hist->host; /* restore the active submachine */
+    }
+#endif /* QHSM_SUBMACHINE */
+
+    Q_SIG(me) = (QSignal)Q_ENTRY_SIG;
+    for (; ip >= iq; --ip) {
+        t = hist->path[ip];
+        QEP_ENTER_(t); /* enter t */
+    }
+    return t;
+}
+
+#endif /* QHSM_HISTORY */
+
+#if (QHSM_SIG_MASK_SIZE != 0)
+
+/****************************************************************************/
+/**
+* @description
+* Registers the table of the signals handled by the states of the HSM.
+* After every transition, QEP-nano combines the masks of all states in the
+* active configuration, and QHSM_DISPATCH() discards the events that none
+* of these states handles without invoking any state handler.
+*
+* @param[in,out] me    pointer (see @ref oop)
+* @param[in]     masks pointer to the table of the handled signals
+*                      (typically in ROM)
+* @param[in]     n     the number of entries in the table
+*
+* @note
+* Must be called in the "constructor" of the derived state machine, after
+* QHsm_ctor() (or QActive_ctor()) and before QHSM_INIT(). This function
+* should be called only via the macro QHSM_SET_MASKS().
+*/
+void QHsm_setMasks(QHsm * const me, QHsmMask const Q_ROM * const masks,
+                   uint_fast8_t const n)
+{
+    /** @pre the initial transition must not be taken yet */
+    Q_REQUIRE_ID(800, me->state == Q_STATE_CAST(&QHsm_top));
+
+    me->masks  = masks;
+    me->nMasks = (uint8_t)n;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Static helper function, which combines the masks of the handled signals
+* of the state @p t and all its superstates. A state missing in the table
+* registered with QHsm_setMasks() handles all signals. It is called only
+* after transitions, so the cost of looking up the table does not burden
+* the processing of the events.
+*
+* @param[in,out] me pointer (see @ref oop)
+* @param[in]     t  the new leaf state of the active configuration
+*
+* @returns the mask of the signals handled by any of the active states
+*/
+static QSigMask QHsm_sigs_(QHsm * const me, QStateHandler t) {
+    QStateHandler const temp = me->temp; /* preserve the current state */
+    QSignal const sig = Q_SIG(me);
+    QSigMask sigs = (QSigMask)0;
+
+    Q_SIG(me) = (QSignal)QEP_EMPTY_SIG_;
+    while ((t != Q_STATE_CAST(&QHsm_top))
+           && (sigs != (QSigMask)~(QSigMask)0))
+    {
+        uint_fast8_t i = (uint_fast8_t)0;
+
+        while ((i < (uint_fast8_t)me->nMasks)
+               && (Q_ROM_PTR(me->masks[i].state) != t))
+        {
+            ++i;
+        }
+        if (i < (uint_fast8_t)me->nMasks) { /* is t in the table? */
+            sigs |= Q_ROM_SIG_MASK(me->masks[i].sigs);
+        }
+        else {
+            sigs = (QSigMask)~(QSigMask)0; /* t handles all signals */
+        }
+        (void)(*t)(me); /* find superstate of t */
+        t = me->temp;
+    }
+    Q_SIG(me) = sig;
+    me->temp  = temp;
+    return sigs;
+}
+
+#endif /* (QHSM_SIG_MASK_SIZE != 0) */
+
+/****************************************************************************/
+/**
+* @description
+* Forwards the currently processed event of the container state machine
+* to all orthogonal components in the given routing table, whose signal
+* range contains the signal of the event. Each such component receives
+* the signal and parameter of the event in its own @c evt member, which
+* its state handlers use also for the entry/exit/init signals, and then
+* processes the event in a synchronous run-to-completion step.
+*
+* @param[in,out] me    pointer (see @ref oop) of the container
+* @param[in]     route pointer to the routing table (typically in ROM)
+* @param[in]     n     the number of entries in the routing table
+*
+* @returns the number of components that received the event
+*
+* @note
+* This function should be called only via the macro QHSM_FORWARD().
+*/
+uint_fast8_t QHsm_forward(QHsm * const me,
+                          QHsmRoute const Q_ROM * const route,
+                          uint_fast8_t const n)
+{
+    QSignal const sig = Q_SIG(me);
+    uint_fast8_t nComp = (uint_fast8_t)0;
+    uint_fast8_t i;
+
+    for (i = (uint_fast8_t)0; i < n; ++i) {
+        if ((Q_ROM_SIG(route[i].first) <= sig)
+            && (sig <= Q_ROM_SIG(route[i].last)))
+        {
+            QHsm * const comp = (QHsm *)Q_ROM_PTR(route[i].comp);
+
+            /** @pre the component must not be the container itself */
+            Q_REQUIRE_ID(900, comp != me);
+
+            Q_SIG(comp) = sig;
+#if (Q_PARAM_SIZE != 0)
+            Q_PAR(comp) = Q_PAR(me);
+#endif
+            QHSM_DISPATCH(comp);
+            ++nComp;
+        }
+    }
+    return nComp;
+}
@@ -40,6 +40,7 @@
 #define QP_IMPL       /* this is QP implementation */
 #include "qpn_conf.h" /* QP-nano configuration file (from the application) */
 #include "qfn_port.h" /* QF-nano port from the port directory */
+#include "qsn.h"      /* QS-nano software tracing interface */
 #include "qassert.h"  /* embedded systems-friendly assertions */
 
 Q_DEFINE_THIS_MODULE("qfn")
@@ -97,12 +98,14 @@ uint8_t const Q_ROM QF_log2Lkup[16] = {
 
 /****************************************************************************/
 void QActive_ctor(QActive * const me, QStateHandler initial) {
+#ifndef QF_NO_VIRTUAL
     static QActiveVtbl const vtbl = { /* QActive virtual table */
         { &QHsm_init_,
           &QHsm_dispatch_ },
         &QActive_postX_,
         &QActive_postXISR_
     };
+#endif /* QF_NO_VIRTUAL */
 
     /**
     * @note QActive inherits QActive, so by the @ref oop convention
@@ -114,86 +117,1008 @@ void QActive_ctor(QActive * const me, QStateHandler initial) {
     * in the code for QHsm.
     */
     QHsm_ctor(&me->super, initial);
+#ifndef QF_NO_VIRTUAL
     me->super.vptr = &vtbl.super; /* hook the vptr to QActive virtual table */
+#endif /* QF_NO_VIRTUAL */
+}
+
+#ifdef QF_URGENT_QUEUE
+
+/* options of QF_postUrgent_() */
+#define QF_URGENT_LIFO_   ((uint_fast8_t)1) /* insert in front (LIFO) */
+#define QF_URGENT_ISR_    ((uint_fast8_t)2) /* posting from the ISR level */
+#define QF_URGENT_RECALL_ ((uint_fast8_t)4) /* recalling a deferred event */
+
+/****************************************************************************/
+/**
+* @description
+* Inserts an event with an urgent signal into the urgent ring buffer of
+* the active object. The margin works exactly as in QActive_postX_(),
+* but it applies to the urgent ring buffer alone, so the urgent events
+* never compete for the free slots with the normal events. The event is
+* counted in @c nUsed as well, so the rest of QF-nano treats both ring
+* buffers as one event queue.
+*
+* @note
+* Must be called inside a critical section.
+*/
+#if (Q_PARAM_SIZE != 0)
+static bool QF_postUrgent_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par,
+                           uint_fast8_t const opt)
+#else
+static bool QF_postUrgent_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, uint_fast8_t const opt)
+#endif
+{
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx uqlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->uqlen);
+
+    if (margin == QF_NO_MARGIN) {
+        if (uqlen > (QEQueueIdx)me->uUsed) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(330); /* must be able to post the urgent event */
+        }
+    }
+    else if ((uqlen - (QEQueueIdx)me->uUsed) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        if ((opt & (QF_URGENT_LIFO_ | QF_URGENT_RECALL_)) != (uint_fast8_t)0) {
+            /* insert event in front of the urgent ring buffer (LIFO) */
+            ++me->uTail;
+            if (me->uTail == (QEQueueCtr)uqlen) {
+                me->uTail = (QEQueueCtr)0; /* wrap the tail */
+            }
+            QF_ROM_UQUEUE_AT_(acb, me->uTail).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+            QF_ROM_UQUEUE_AT_(acb, me->uTail).par = par;
+#endif
+        }
+        else {
+            /* insert event into the urgent ring buffer (FIFO) */
+            QF_ROM_UQUEUE_AT_(acb, me->uHead).sig = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+            QF_ROM_UQUEUE_AT_(acb, me->uHead).par = par;
+#endif
+            if (me->uHead == (QEQueueCtr)0) {
+                me->uHead = (QEQueueCtr)uqlen; /* wrap the head */
+            }
+            --me->uHead;
+        }
+        ++me->uUsed;
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if (me->uMax < me->uUsed) {
+            me->uMax = me->uUsed; /* update the urgent high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(((opt & QF_URGENT_RECALL_) != (uint_fast8_t)0)
+                         ? QS_QF_ACTIVE_RECALL
+                         : (((opt & QF_URGENT_LIFO_) != (uint_fast8_t)0)
+                            ? QS_QF_ACTIVE_POST_LIFO
+                            : (((opt & QF_URGENT_ISR_) != (uint_fast8_t)0)
+                               ? QS_QF_ACTIVE_POST_ISR
+                               : QS_QF_ACTIVE_POST)))
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
+
+#ifdef QK_PREEMPTIVE
+            if ((opt & (QF_URGENT_ISR_ | QF_URGENT_RECALL_))
+                == (uint_fast8_t)0)
+            {
+                if (QK_sched_() != (uint_fast8_t)0) {
+                    QK_activate_(); /* activate the next active object */
+                }
+            }
+#endif
+        }
+    }
+    else if ((opt & QF_URGENT_RECALL_) == (uint_fast8_t)0) {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+    else {
+        /* the event stays deferred */
+    }
+
+    return (bool)margin;
+}
+
+#endif /* QF_URGENT_QUEUE */
+
+/****************************************************************************/
+/**
+* @description
+* Direct event posting is the simplest asynchronous communication method
+* available in QF-nano.
+*
+* @attention
+* This function should be called only via the macro QACTIVE_POST()
+* or QACTIVE_POST_X(). This function should be only used in the
+* __task__ context.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     margin number of required free slots in the queue after
+*                       posting the event. The special value #QF_NO_MARGIN
+*                       means that this function will assert if posting fails.
+* @param[in]     sig    signal of the event to be posted
+* @param[in]     par    parameter of the event to be posted
+*
+* @usage
+* @include qfn_postx.c
+*/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postX_(QActive * const me, QEQueueIdx margin,
+                    enum_t const sig, QParam const par)
+#else
+bool QActive_postX_(QActive * const me, QEQueueIdx margin,
+                    enum_t const sig)
+#endif
+{
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx qlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->qlen);
+
+    QF_INT_DISABLE();
+
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(acb, sig)) { /* urgent signal? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              (uint_fast8_t)0);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              (uint_fast8_t)0);
+#endif
+        QF_INT_ENABLE();
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (margin == QF_NO_MARGIN) {
+        if (qlen > QF_NORMAL_USED_(me)) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(310); /* must be able to post the event */
+        }
+    }
+    else if ((qlen - QF_NORMAL_USED_(me)) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        /* insert event into the ring buffer (FIFO) */
+        QF_ROM_QSIG_AT_(acb, me->head) = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+        QF_ROM_QPAR_AT_(acb, me->head) = par;
+#endif
+        if (me->head == (QEQueueCtr)0) {
+            me->head = (QEQueueCtr)qlen; /* wrap the head */
+        }
+        --me->head;
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
+
+#ifdef QK_PREEMPTIVE
+            if (QK_sched_() != (uint_fast8_t)0) {
+                QK_activate_(); /* activate the next active object */
+            }
+#endif
+        }
+    }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+    QF_INT_ENABLE();
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Direct event posting is the simplest asynchronous communication method
+* available in QF-nano.
+*
+* @attention
+* This function should be called only via the macro QACTIVE_POST_ISR()
+* or QACTIVE_POST_X_ISR(). This function should be only used in the
+* __ISR__ context.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     margin number of required free slots in the queue after
+*                       posting the event. The special value #QF_NO_MARGIN
+*                       means that this function will assert if posting fails.
+* @param[in]     sig    signal of the event to be posted
+* @param[in]     par    parameter of the event to be posted
+*
+* @usage
+* @include qfn_postx.c
+*/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postXISR_(QActive * const me, QEQueueIdx margin,
+                       enum_t const sig, QParam const par)
+#else
+bool QActive_postXISR_(QActive * const me, QEQueueIdx margin,
+                       enum_t const sig)
+#endif
+{
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_STAT_TYPE stat;
+#endif
+#endif
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx qlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->qlen);
+
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_DISABLE(stat);
+#else
+    QF_INT_DISABLE();
+#endif
+#endif
+
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(acb, sig)) { /* urgent signal? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_ISR_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_ISR_);
+#endif
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+        QF_ISR_RESTORE(stat);
+#else
+        QF_INT_ENABLE();
+#endif
+#endif
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (margin == QF_NO_MARGIN) {
+        if (qlen > QF_NORMAL_USED_(me)) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(310); /* must be able to post the event */
+        }
+    }
+    else if ((qlen - QF_NORMAL_USED_(me)) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        /* insert event into the ring buffer (FIFO) */
+        QF_ROM_QSIG_AT_(acb, me->head) = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+        QF_ROM_QPAR_AT_(acb, me->head) = par;
+#endif
+        if (me->head == (QEQueueCtr)0) {
+            me->head = (QEQueueCtr)qlen; /* wrap the head */
+        }
+        --me->head;
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ISR)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+            /* set the bit */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
+        }
+    }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_RESTORE(stat);
+#else
+    QF_INT_ENABLE();
+#endif
+#endif
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+/**
+* @description
+* LIFO event posting inserts the event at the __front__ of the event queue
+* (at the tail of the ring buffer, from which QF-nano takes the events for
+* dispatching), so the event is dispatched next, ahead of all the events
+* already waiting in the queue. The margin works exactly as in
+* QActive_postX_().
+*
+* @attention
+* This function should be called only via the macro QACTIVE_POST_LIFO()
+* or QACTIVE_POST_LIFO_X(). This function should be only used in the
+* __task__ context.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     margin number of required free slots in the queue after
+*                       posting the event. The special value #QF_NO_MARGIN
+*                       means that this function will assert if posting fails.
+* @param[in]     sig    signal of the event to be posted
+* @param[in]     par    parameter of the event to be posted
+*/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLIFOX_(QActive * const me, QEQueueIdx margin,
+                        enum_t const sig, QParam const par)
+#else
+bool QActive_postLIFOX_(QActive * const me, QEQueueIdx margin,
+                        enum_t const sig)
+#endif
+{
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx qlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->qlen);
+
+    QF_INT_DISABLE();
+
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(acb, sig)) { /* urgent signal? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_LIFO_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_LIFO_);
+#endif
+        QF_INT_ENABLE();
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (margin == QF_NO_MARGIN) {
+        if (qlen > QF_NORMAL_USED_(me)) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(320); /* must be able to post the event */
+        }
+    }
+    else if ((qlen - QF_NORMAL_USED_(me)) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        /* insert event in front of the ring buffer (LIFO) */
+        ++me->tail;
+        if (me->tail == (QEQueueCtr)qlen) {
+            me->tail = (QEQueueCtr)0; /* wrap the tail */
+        }
+        QF_ROM_QSIG_AT_(acb, me->tail) = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+        QF_ROM_QPAR_AT_(acb, me->tail) = par;
+#endif
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_LIFO)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
+
+#ifdef QK_PREEMPTIVE
+            if (QK_sched_() != (uint_fast8_t)0) {
+                QK_activate_(); /* activate the next active object */
+            }
+#endif
+        }
+    }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+    QF_INT_ENABLE();
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+/**
+* @description
+* The ISR-level counterpart of QActive_postLIFOX_().
+*
+* @attention
+* This function should be called only via the macro QACTIVE_POST_LIFO_ISR()
+* or QACTIVE_POST_LIFO_X_ISR(). This function should be only used in the
+* __ISR__ context.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     margin number of required free slots in the queue after
+*                       posting the event. The special value #QF_NO_MARGIN
+*                       means that this function will assert if posting fails.
+* @param[in]     sig    signal of the event to be posted
+* @param[in]     par    parameter of the event to be posted
+*/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLIFOXISR_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par)
+#else
+bool QActive_postLIFOXISR_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig)
+#endif
+{
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_STAT_TYPE stat;
+#endif
+#endif
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx qlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->qlen);
+
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_DISABLE(stat);
+#else
+    QF_INT_DISABLE();
+#endif
+#endif
+
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(acb, sig)) { /* urgent signal? */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                                              QF_URGENT_LIFO_ | QF_URGENT_ISR_);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                                              QF_URGENT_LIFO_ | QF_URGENT_ISR_);
+#endif
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+        QF_ISR_RESTORE(stat);
+#else
+        QF_INT_ENABLE();
+#endif
+#endif
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
+
+    if (margin == QF_NO_MARGIN) {
+        if (qlen > QF_NORMAL_USED_(me)) {
+            margin = (QEQueueIdx)true; /* can post */
+        }
+        else {
+            margin = (QEQueueIdx)false; /* cannot post */
+            Q_ERROR_ID(320); /* must be able to post the event */
+        }
+    }
+    else if ((qlen - QF_NORMAL_USED_(me)) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
+    }
+    else {
+        margin = (QEQueueIdx)false; /* cannot post */
+    }
+
+    if (margin) { /* can post the event? */
+        /* insert event in front of the ring buffer (LIFO) */
+        ++me->tail;
+        if (me->tail == (QEQueueCtr)qlen) {
+            me->tail = (QEQueueCtr)0; /* wrap the tail */
+        }
+        QF_ROM_QSIG_AT_(acb, me->tail) = (QSignal)sig;
+#if (Q_PARAM_SIZE != 0)
+        QF_ROM_QPAR_AT_(acb, me->tail) = par;
+#endif
+        ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_LIFO)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+        /* is this the first event? */
+        if (me->nUsed == (QEQueueCtr)1) {
+            /* set the bit */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
+        }
+    }
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
+
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_RESTORE(stat);
+#else
+    QF_INT_ENABLE();
+#endif
+#endif
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Performs the batch posting for QActive_postManyX_() and
+* QActive_postManyXISR_(). The margin is checked once for the whole batch
+* and applies to every ring buffer receiving the events, so either all
+* events are posted or none. The events are copied into the ring buffer(s)
+* in the order of the array, and the ready set (and the QK-nano scheduler
+* at the task level) is updated only once.
+*
+* @note
+* Must be called inside a critical section.
+*/
+static bool QF_postMany_(QActive * const me, QEQueueIdx margin,
+                         QEvt const * const evts, QEQueueIdx const n,
+                         bool const isr)
+{
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx qlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->qlen);
+    QEQueueIdx nNormal = n; /* # events for the normal ring buffer */
+    QEQueueIdx nFree = qlen - QF_NORMAL_USED_(me);
+    bool const guaranteed = (margin == QF_NO_MARGIN);
+    bool post;
+    QEQueueIdx i;
+#ifdef QF_URGENT_QUEUE
+    QEQueueIdx uqlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->uqlen);
+    QEQueueIdx nUrgent = (QEQueueIdx)0;
+
+    for (i = (QEQueueIdx)0; i < n; ++i) {
+        if (QF_IS_URGENT_SIG_(acb, evts[i].sig)) {
+            ++nUrgent;
+        }
+    }
+    nNormal -= nUrgent;
+#endif /* QF_URGENT_QUEUE */
+
+    if (guaranteed) {
+        margin = (QEQueueIdx)0; /* all events must fit */
+    }
+
+    /* the margin must remain in every ring buffer receiving events */
+    post = (nNormal == (QEQueueIdx)0)
+           || ((nFree >= nNormal) && ((nFree - nNormal) >= margin));
+#ifdef QF_URGENT_QUEUE
+    nFree = uqlen - (QEQueueIdx)me->uUsed;
+    post = post && ((nUrgent == (QEQueueIdx)0)
+           || ((nFree >= nUrgent) && ((nFree - nUrgent) >= margin)));
+#endif /* QF_URGENT_QUEUE */
+
+    if (guaranteed && (!post)) {
+        Q_ERROR_ID(360); /* must be able to post all the events */
+    }
+
+    if (post) { /* can post all the events? */
+        for (i = (QEQueueIdx)0; i < n; ++i) {
+#ifdef QF_URGENT_QUEUE
+            if (QF_IS_URGENT_SIG_(acb, evts[i].sig)) {
+                /* insert event into the urgent ring buffer (FIFO) */
+                QF_ROM_UQUEUE_AT_(acb, me->uHead) = evts[i];
+                if (me->uHead == (QEQueueCtr)0) {
+                    me->uHead = (QEQueueCtr)uqlen; /* wrap the head */
+                }
+                --me->uHead;
+                ++me->uUsed;
+            }
+            else
+#endif /* QF_URGENT_QUEUE */
+            {
+                /* insert event into the ring buffer (FIFO) */
+                QF_ROM_QUEUE_PUT_(acb, me->head, evts[i]);
+                if (me->head == (QEQueueCtr)0) {
+                    me->head = (QEQueueCtr)qlen; /* wrap the head */
+                }
+                --me->head;
+            }
+            ++me->nUsed;
+
+            QS_BEGIN_NOCRIT_(isr ? QS_QF_ACTIVE_POST_ISR : QS_QF_ACTIVE_POST)
+                QS_U8_(me->prio);     /* the priority of the active object */
+                QS_SIG_(evts[i].sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(evts[i].par); /* the parameter of the event */
+#endif
+                QS_EQC_(me->nUsed);   /* # events in the queue */
+            QS_END_NOCRIT_()
+        }
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#ifdef QF_URGENT_QUEUE
+        if (me->uMax < me->uUsed) {
+            me->uMax = me->uUsed; /* update the urgent high-water mark */
+        }
+#endif /* QF_URGENT_QUEUE */
+#endif /* QF_EQUEUE_USAGE */
+
+        /* was the queue empty before the batch? */
+        if ((n != (QEQueueIdx)0) && (me->nUsed == (QEQueueCtr)n)) {
+
+            /* set the corresponding bit in the ready set */
+            QF_readySet_ |= (uint_fast8_t)
+                ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
+
+#ifdef QK_PREEMPTIVE
+            if (!isr) {
+                if (QK_sched_() != (uint_fast8_t)0) {
+                    QK_activate_(); /* activate the next active object */
+                }
+            }
+#endif
+        }
+    }
+    else {
+        for (i = (QEQueueIdx)0; i < n; ++i) {
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+                QS_U8_(me->prio);     /* the priority of the active object */
+                QS_SIG_(evts[i].sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(evts[i].par); /* the parameter of the event */
+#endif
+                QS_EQC_(me->nUsed);   /* # events in the queue */
+            QS_END_NOCRIT_()
+        }
+    }
+
+    (void)isr; /* unused parameter in some configurations */
+
+    return post;
 }
 
 /****************************************************************************/
 /**
 * @description
-* Direct event posting is the simplest asynchronous communication method
-* available in QF-nano.
+* Batch event posting copies an array of events into the queue of the
+* active object under a single critical section. Compared to posting the
+* events one by one, the margin is checked and the scheduler is invoked
+* only once for the whole batch.
 *
 * @attention
-* This function should be called only via the macro QACTIVE_POST()
-* or QACTIVE_POST_X(). This function should be only used in the
+* This function should be called only via the macro QACTIVE_POST_MANY()
+* or QACTIVE_POST_MANY_X(). This function should be only used in the
 * __task__ context.
 *
 * @param[in,out] me     pointer (see @ref oop)
 * @param[in]     margin number of required free slots in the queue after
-*                       posting the event. The special value #QF_NO_MARGIN
-*                       means that this function will assert if posting fails.
-* @param[in]     sig    signal of the event to be posted
-* @param[in]     par    parameter of the event to be posted
+*                       posting all the events. The special value
+*                       #QF_NO_MARGIN means that this function will assert
+*                       if posting of the batch fails.
+* @param[in]     evts   array of events (signals and parameters) to post
+* @param[in]     n      number of events in the array
 *
-* @usage
-* @include qfn_postx.c
+* @returns
+* 'true' if all the events were posted, and 'false' if none was posted.
+*/
+bool QActive_postManyX_(QActive * const me, QEQueueIdx margin,
+                        QEvt const * const evts, QEQueueIdx const n)
+{
+    QF_INT_DISABLE();
+    margin = (QEQueueIdx)QF_postMany_(me, margin, evts, n, false);
+    QF_INT_ENABLE();
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+/**
+* @description
+* The same as QActive_postManyX_(), but for the ISR context.
+*
+* @attention
+* This function should be called only via the macro QACTIVE_POST_MANY_ISR()
+* or QACTIVE_POST_MANY_X_ISR(). This function should be only used in the
+* __ISR__ context.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     margin number of required free slots in the queue after
+*                       posting all the events. The special value
+*                       #QF_NO_MARGIN means that this function will assert
+*                       if posting of the batch fails.
+* @param[in]     evts   array of events (signals and parameters) to post
+* @param[in]     n      number of events in the array
+*
+* @returns
+* 'true' if all the events were posted, and 'false' if none was posted.
+*/
+bool QActive_postManyXISR_(QActive * const me, QEQueueIdx margin,
+                           QEvt const * const evts, QEQueueIdx const n)
+{
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_STAT_TYPE stat;
+#endif
+#endif
+
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_DISABLE(stat);
+#else
+    QF_INT_DISABLE();
+#endif
+#endif
+
+    margin = (QEQueueIdx)QF_postMany_(me, margin, evts, n, true);
+
+#ifdef QF_ISR_NEST
+#ifdef QF_ISR_STAT_TYPE
+    QF_ISR_RESTORE(stat);
+#else
+    QF_INT_ENABLE();
+#endif
+#endif
+
+    return (bool)margin;
+}
+
+#if (QF_COALESCE_SIZE != 0)
+
+/****************************************************************************/
+/**
+* @description
+* Performs the latest-value posting for QActive_postLatestX_() and
+* QActive_postLatestXISR_(). If an event with the coalescing signal @p sig
+* is still waiting in the queue (its bit is set in the ::QPendSet of the
+* active object), only the parameter of that event is updated in place, in
+* the ring-buffer slot recorded when the event was posted. Otherwise the
+* event is posted (FIFO), and its slot is recorded and its bit is set before
+* the QK-nano scheduler has a chance to dispatch it.
+*
+* @note
+* Must be called inside a critical section.
 */
 #if (Q_PARAM_SIZE != 0)
-bool QActive_postX_(QActive * const me, uint_fast8_t margin,
-                    enum_t const sig, QParam const par)
+static bool QF_postLatest_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, QParam const par,
+                           bool const isr)
 #else
-bool QActive_postX_(QActive * const me, uint_fast8_t margin,
-                    enum_t const sig)
+static bool QF_postLatest_(QActive * const me, QEQueueIdx margin,
+                           enum_t const sig, bool const isr)
 #endif
 {
     QActiveCB const Q_ROM *acb = &QF_active[me->prio];
-    uint_fast8_t qlen = (uint_fast8_t)Q_ROM_BYTE(acb->qlen);
+    QEQueueIdx qlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->qlen);
+    QPendSet const bit = QF_COALESCE_BIT_(sig);
 
-    QF_INT_DISABLE();
+    (void)isr; /* unused parameter in some configurations */
+
+    if ((me->pend & bit) != (QPendSet)0) { /* event already waiting? */
+#if (Q_PARAM_SIZE != 0)
+        QEQueueCtr const at = me->pendAt[QF_COALESCE_POS_(sig)];
+
+#ifdef QF_URGENT_QUEUE
+        if (QF_IS_URGENT_SIG_(acb, sig)) { /* in the urgent ring buffer? */
+            QF_ROM_UQUEUE_AT_(acb, at).par = par; /* update it in place */
+        }
+        else
+#endif /* QF_URGENT_QUEUE */
+        {
+            QF_ROM_QPAR_AT_(acb, at) = par; /* update the event in place */
+        }
+#endif /* (Q_PARAM_SIZE != 0) */
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_COALESCE)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+
+        return true;
+    }
+
+#ifdef QF_URGENT_QUEUE
+    if (QF_IS_URGENT_SIG_(acb, sig)) { /* urgent signal? */
+        me->pendAt[QF_COALESCE_POS_(sig)] = me->uHead; /* the FIFO slot */
+        me->pend |= bit; /* set before QK-nano can dispatch the event */
+#if (Q_PARAM_SIZE != 0)
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig, par,
+                     isr ? QF_URGENT_ISR_ : (uint_fast8_t)0);
+#else
+        margin = (QEQueueIdx)QF_postUrgent_(me, margin, sig,
+                     isr ? QF_URGENT_ISR_ : (uint_fast8_t)0);
+#endif
+        if (!margin) {
+            me->pend &= (QPendSet)~bit; /* the event was not posted */
+        }
+        return (bool)margin;
+    }
+#endif /* QF_URGENT_QUEUE */
 
     if (margin == QF_NO_MARGIN) {
-        if (qlen > (uint_fast8_t)me->nUsed) {
-            margin = (uint_fast8_t)true; /* can post */
+        if (qlen > QF_NORMAL_USED_(me)) {
+            margin = (QEQueueIdx)true; /* can post */
         }
         else {
-            margin = (uint_fast8_t)false; /* cannot post */
+            margin = (QEQueueIdx)false; /* cannot post */
             Q_ERROR_ID(310); /* must be able to post the event */
         }
     }
-    else if ((qlen - (uint_fast8_t)me->nUsed) > margin) {
-        margin = (uint_fast8_t)true; /* can post */
+    else if ((qlen - QF_NORMAL_USED_(me)) > margin) {
+        margin = (QEQueueIdx)true; /* can post */
     }
     else {
-        margin = (uint_fast8_t)false; /* cannot post */
+        margin = (QEQueueIdx)false; /* cannot post */
     }
 
     if (margin) { /* can post the event? */
         /* insert event into the ring buffer (FIFO) */
-        QF_ROM_QUEUE_AT_(acb, me->head).sig = (QSignal)sig;
+        QF_ROM_QSIG_AT_(acb, me->head) = (QSignal)sig;
 #if (Q_PARAM_SIZE != 0)
-        QF_ROM_QUEUE_AT_(acb, me->head).par = par;
+        QF_ROM_QPAR_AT_(acb, me->head) = par;
 #endif
-        if (me->head == (uint8_t)0) {
-            me->head = (uint8_t)qlen; /* wrap the head */
+        me->pendAt[QF_COALESCE_POS_(sig)] = me->head; /* slot of the event */
+        if (me->head == (QEQueueCtr)0) {
+            me->head = (QEQueueCtr)qlen; /* wrap the head */
         }
         --me->head;
         ++me->nUsed;
+        me->pend |= bit; /* the event is now waiting in the queue */
+#ifdef QF_EQUEUE_USAGE
+        if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+            me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me); /* high-water mark */
+        }
+#endif /* QF_EQUEUE_USAGE */
+
+        QS_BEGIN_NOCRIT_(isr ? QS_QF_ACTIVE_POST_ISR : QS_QF_ACTIVE_POST)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
 
         /* is this the first event? */
-        if (me->nUsed == (uint8_t)1) {
+        if (me->nUsed == (QEQueueCtr)1) {
 
             /* set the corresponding bit in the ready set */
             QF_readySet_ |= (uint_fast8_t)
                 ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
 
 #ifdef QK_PREEMPTIVE
-            if (QK_sched_() != (uint_fast8_t)0) {
-                QK_activate_(); /* activate the next active object */
+            if (!isr) {
+                if (QK_sched_() != (uint_fast8_t)0) {
+                    QK_activate_(); /* activate the next active object */
+                }
             }
 #endif
         }
     }
-    QF_INT_ENABLE();
+    else {
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT)
+            QS_U8_(me->prio);   /* the priority of the active object */
+            QS_SIG_(sig);       /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(par);       /* the parameter of the event */
+#endif
+            QS_EQC_(me->nUsed); /* # events in the queue */
+        QS_END_NOCRIT_()
+    }
 
     return (bool)margin;
 }
@@ -201,30 +1126,67 @@ bool QActive_postX_(QActive * const me, uint_fast8_t margin,
 /****************************************************************************/
 /**
 * @description
-* Direct event posting is the simplest asynchronous communication method
-* available in QF-nano.
+* Latest-value event posting replaces the event of the same signal still
+* waiting in the queue instead of enqueuing another one, so the queue holds
+* at most one event of every coalescing signal posted this way.
 *
 * @attention
-* This function should be called only via the macro QACTIVE_POST_ISR()
-* or QACTIVE_POST_X_ISR(). This function should be only used in the
-* __ISR__ context.
+* This function should be called only via the macro QACTIVE_POST_LATEST()
+* or QACTIVE_POST_LATEST_X(). This function should be only used in the
+* __task__ context.
 *
 * @param[in,out] me     pointer (see @ref oop)
 * @param[in]     margin number of required free slots in the queue after
-*                       posting the event. The special value #QF_NO_MARGIN
+*                       posting a new event. The special value #QF_NO_MARGIN
 *                       means that this function will assert if posting fails.
-* @param[in]     sig    signal of the event to be posted
+* @param[in]     sig    coalescing signal of the event to be posted
 * @param[in]     par    parameter of the event to be posted
+*/
+#if (Q_PARAM_SIZE != 0)
+bool QActive_postLatestX_(QActive * const me, QEQueueIdx margin,
+                          enum_t const sig, QParam const par)
+#else
+bool QActive_postLatestX_(QActive * const me, QEQueueIdx margin,
+                          enum_t const sig)
+#endif
+{
+    /** @pre the signal must have a bit in the ::QPendSet */
+    Q_REQUIRE_ID(340, QF_IS_COALESCE_SIG_(sig));
+
+    QF_INT_DISABLE();
+#if (Q_PARAM_SIZE != 0)
+    margin = (QEQueueIdx)QF_postLatest_(me, margin, sig, par, false);
+#else
+    margin = (QEQueueIdx)QF_postLatest_(me, margin, sig, false);
+#endif
+    QF_INT_ENABLE();
+
+    return (bool)margin;
+}
+
+/****************************************************************************/
+/**
+* @description
+* The same as QActive_postLatestX_(), but for the ISR context.
 *
-* @usage
-* @include qfn_postx.c
+* @attention
+* This function should be called only via the macro
+* QACTIVE_POST_LATEST_ISR() or QACTIVE_POST_LATEST_X_ISR(). This function
+* should be only used in the __ISR__ context.
+*
+* @param[in,out] me     pointer (see @ref oop)
+* @param[in]     margin number of required free slots in the queue after
+*                       posting a new event. The special value #QF_NO_MARGIN
+*                       means that this function will assert if posting fails.
+* @param[in]     sig    coalescing signal of the event to be posted
+* @param[in]     par    parameter of the event to be posted
 */
 #if (Q_PARAM_SIZE != 0)
-bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
-                       enum_t const sig, QParam const par)
+bool QActive_postLatestXISR_(QActive * const me, QEQueueIdx margin,
+                             enum_t const sig, QParam const par)
 #else
-bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
-                       enum_t const sig)
+bool QActive_postLatestXISR_(QActive * const me, QEQueueIdx margin,
+                             enum_t const sig)
 #endif
 {
 #ifdef QF_ISR_NEST
@@ -232,8 +1194,9 @@ bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
     QF_ISR_STAT_TYPE stat;
 #endif
 #endif
-    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
-    uint_fast8_t qlen = (uint_fast8_t)Q_ROM_BYTE(acb->qlen);
+
+    /** @pre the signal must have a bit in the ::QPendSet */
+    Q_REQUIRE_ID(345, QF_IS_COALESCE_SIG_(sig));
 
 #ifdef QF_ISR_NEST
 #ifdef QF_ISR_STAT_TYPE
@@ -243,40 +1206,11 @@ bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
 #endif
 #endif
 
-    if (margin == QF_NO_MARGIN) {
-        if (qlen > (uint_fast8_t)me->nUsed) {
-            margin = (uint_fast8_t)true; /* can post */
-        }
-        else {
-            margin = (uint_fast8_t)false; /* cannot post */
-            Q_ERROR_ID(310); /* must be able to post the event */
-        }
-    }
-    else if ((qlen - (uint_fast8_t)me->nUsed) > margin) {
-        margin = (uint_fast8_t)true; /* can post */
-    }
-    else {
-        margin = (uint_fast8_t)false; /* cannot post */
-    }
-
-    if (margin) { /* can post the event? */
-        /* insert event into the ring buffer (FIFO) */
-        QF_ROM_QUEUE_AT_(acb, me->head).sig = (QSignal)sig;
 #if (Q_PARAM_SIZE != 0)
-        QF_ROM_QUEUE_AT_(acb, me->head).par = par;
+    margin = (QEQueueIdx)QF_postLatest_(me, margin, sig, par, true);
+#else
+    margin = (QEQueueIdx)QF_postLatest_(me, margin, sig, true);
 #endif
-        if (me->head == (uint8_t)0) {
-            me->head = (uint8_t)qlen; /* wrap the head */
-        }
-        --me->head;
-        ++me->nUsed;
-        /* is this the first event? */
-        if (me->nUsed == (uint8_t)1) {
-            /* set the bit */
-            QF_readySet_ |= (uint_fast8_t)
-                ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
-        }
-    }
 
 #ifdef QF_ISR_NEST
 #ifdef QF_ISR_STAT_TYPE
@@ -289,6 +1223,8 @@ bool QActive_postXISR_(QActive * const me, uint_fast8_t margin,
     return (bool)margin;
 }
 
+#endif /* (QF_COALESCE_SIZE != 0) */
+
 /****************************************************************************/
 /**
 * @description
@@ -341,9 +1277,41 @@ void QF_init(uint_fast8_t maxActive) {
         /* QF_active[p] must be initialized */
         Q_ASSERT_ID(110, a != (QActive *)0);
 
-        a->head    = (uint8_t)0;
-        a->tail    = (uint8_t)0;
-        a->nUsed   = (uint8_t)0;
+#ifdef QF_URGENT_QUEUE
+        /* both ring buffers must fit in nUsed, and urgent signals need
+        * the urgent ring buffer
+        */
+        Q_ASSERT_ID(120,
+            (((uint_fast32_t)Q_ROM_EQUEUE_CTR(QF_active[p].qlen)
+              + (uint_fast32_t)Q_ROM_EQUEUE_CTR(QF_active[p].uqlen))
+             <= (uint_fast32_t)(QEQueueCtr)~(QEQueueCtr)0)
+            && ((Q_ROM_SIG(QF_active[p].usig) == (QSignal)0)
+                || (Q_ROM_EQUEUE_CTR(QF_active[p].uqlen) != (QEQueueCtr)0)));
+#endif /* QF_URGENT_QUEUE */
+
+        a->prio    = (uint8_t)p; /* known already before QF_run() */
+        a->head    = (QEQueueCtr)0;
+        a->tail    = (QEQueueCtr)0;
+        a->nUsed   = (QEQueueCtr)0;
+#ifdef QF_EQUEUE_USAGE
+        a->nMax    = (QEQueueCtr)0;
+#endif /* QF_EQUEUE_USAGE */
+#ifdef QF_DEFER
+        a->dHead   = (QEQueueCtr)0;
+        a->dTail   = (QEQueueCtr)0;
+        a->dUsed   = (QEQueueCtr)0;
+#endif /* QF_DEFER */
+#ifdef QF_URGENT_QUEUE
+        a->uHead   = (QEQueueCtr)0;
+        a->uTail   = (QEQueueCtr)0;
+        a->uUsed   = (QEQueueCtr)0;
+#ifdef QF_EQUEUE_USAGE
+        a->uMax    = (QEQueueCtr)0;
+#endif /* QF_EQUEUE_USAGE */
+#endif /* QF_URGENT_QUEUE */
+#if (QF_COALESCE_SIZE != 0)
+        a->pend    = (QPendSet)0;
+#endif /* (QF_COALESCE_SIZE != 0) */
 #if (QF_TIMEEVT_CTR_SIZE != 0)
         for (n = (uint_fast8_t)0; n < (uint_fast8_t)QF_MAX_TICK_RATE; ++n) {
             a->tickCtr[n].nTicks   = (QTimeEvtCtr)0;
@@ -361,6 +1329,218 @@ void QF_init(uint_fast8_t maxActive) {
 #endif
 }
 
+#ifdef QF_EQUEUE_USAGE
+
+/****************************************************************************/
+/**
+* @description
+* Resets the high-water mark of the event queue of the given active object
+* to the number of events currently present in the queue (and likewise
+* the high-water mark of the urgent ring buffer with #QF_URGENT_QUEUE).
+* This allows the application to measure the queue usage over a specific
+* time window.
+*
+* @param[in,out] me  pointer (see @ref oop)
+*
+* @sa QActive_getQueueMax(), QF_reportQueueUsage()
+*/
+void QActive_resetQueueMax(QActive * const me) {
+    QF_INT_DISABLE();
+    me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me);
+#ifdef QF_URGENT_QUEUE
+    me->uMax = me->uUsed;
+#endif /* QF_URGENT_QUEUE */
+    QF_INT_ENABLE();
+}
+
+/****************************************************************************/
+/**
+* @description
+* Walks all entries of QF_active[] and calls the application callback
+* QF_onQueueUsage() with the queue length configured in ::QActiveCB and
+* the high-water mark measured for every active object. With
+* #QF_URGENT_QUEUE, the length and the high-water mark of the urgent ring
+* buffer are reported separately, so each high-water mark can be compared
+* directly with the length of its own ring buffer.
+*
+* @note
+* QF_reportQueueUsage() can be called only after QF_init() and should be
+* called from the task level. The callback QF_onQueueUsage() is called
+* outside of any critical section.
+*/
+void QF_reportQueueUsage(void) {
+    uint_fast8_t p;
+    for (p = (uint_fast8_t)1; p <= QF_maxActive_; ++p) {
+#ifdef QF_URGENT_QUEUE
+        QF_onQueueUsage(p,
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].qlen),
+            QActive_getQueueMax(QF_ROM_ACTIVE_GET_(p)),
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].uqlen),
+            QActive_getUrgentQueueMax(QF_ROM_ACTIVE_GET_(p)));
+#else
+        QF_onQueueUsage(p,
+            (QEQueueIdx)Q_ROM_EQUEUE_CTR(QF_active[p].qlen),
+            QActive_getQueueMax(QF_ROM_ACTIVE_GET_(p)));
+#endif /* QF_URGENT_QUEUE */
+    }
+}
+
+#endif /* QF_EQUEUE_USAGE */
+
+#ifdef QF_DEFER
+
+/****************************************************************************/
+/**
+* @description
+* Saves the current event of the active object (the event being processed
+* in the current RTC step) in the deferral ring buffer configured in
+* ::QActiveCB, so that it can be recalled later with QActive_recall().
+* The deferral ring buffer is separate from the event queue, so deferring
+* an event never competes with the events posted to the active object.
+*
+* @param[in,out] me pointer (see @ref oop)
+*
+* @returns
+* 'true' if the event has been deferred, and 'false' if the deferral ring
+* buffer is full (or not configured), in which case the event is lost
+* unless the application handles it otherwise.
+*
+* @note
+* QActive_defer() must be called only from the state machine of the
+* active object @p me (task context).
+*
+* @sa QActive_recall(), QActive_getDeferred()
+*/
+bool QActive_defer(QActive * const me) {
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx dlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->dlen);
+    bool deferred;
+
+    if (dlen > (QEQueueIdx)me->dUsed) {
+        /* insert the current event into the deferral ring buffer (FIFO) */
+        QF_ROM_DEFER_AT_(acb, me->dHead) = me->super.evt;
+        if (me->dHead == (QEQueueCtr)0) {
+            me->dHead = (QEQueueCtr)dlen; /* wrap the head */
+        }
+        --me->dHead;
+        ++me->dUsed;
+        deferred = true;
+
+        QS_BEGIN_(QS_QF_ACTIVE_DEFER)
+            QS_U8_(me->prio);       /* the priority of the active object */
+            QS_SIG_(me->super.evt.sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(me->super.evt.par); /* the parameter of the event */
+#endif
+            QS_EQC_(me->dUsed);     /* # deferred events */
+        QS_END_()
+    }
+    else {
+        deferred = false;
+
+        QS_BEGIN_(QS_QF_ACTIVE_DEFER_ATTEMPT)
+            QS_U8_(me->prio);       /* the priority of the active object */
+            QS_SIG_(me->super.evt.sig); /* the signal of the event */
+#if (Q_PARAM_SIZE != 0)
+            QS_PAR_(me->super.evt.par); /* the parameter of the event */
+#endif
+            QS_EQC_(me->dUsed);     /* # deferred events */
+        QS_END_()
+    }
+    return deferred;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Removes the oldest event from the deferral ring buffer of the active
+* object and inserts it directly at the __front__ of the event queue
+* (LIFO), so that it is dispatched in the very next RTC step of the active
+* object, ahead of the events posted in the meantime. Unlike re-posting
+* with QACTIVE_POST(), the recalled event does not wait behind the other
+* queued events and does not trigger another scheduler pass.
+*
+* @param[in,out] me pointer (see @ref oop)
+*
+* @returns
+* 'true' if an event has been recalled, and 'false' if no events are
+* deferred or the event queue has no free slot. In the latter case the
+* event stays deferred, so no event is ever lost by QActive_recall().
+*
+* @note
+* QActive_recall() must be called only from the state machine of the
+* active object @p me (task context), typically in the entry action of
+* the state that can handle the deferred events.
+*
+* @sa QActive_defer(), QActive_getDeferred()
+*/
+bool QActive_recall(QActive * const me) {
+    QActiveCB const Q_ROM *acb = &QF_active[me->prio];
+    QEQueueIdx qlen = (QEQueueIdx)Q_ROM_EQUEUE_CTR(acb->qlen);
+    bool recalled = false;
+
+    if (me->dUsed != (QEQueueCtr)0) { /* any deferred events? */
+        QF_INT_DISABLE();
+
+#ifdef QF_URGENT_QUEUE
+        if (QF_IS_URGENT_SIG_(acb, QF_ROM_DEFER_AT_(acb, me->dTail).sig)) {
+            recalled = QF_postUrgent_(me, (QEQueueIdx)0,
+                (enum_t)QF_ROM_DEFER_AT_(acb, me->dTail).sig,
+#if (Q_PARAM_SIZE != 0)
+                QF_ROM_DEFER_AT_(acb, me->dTail).par,
+#endif
+                QF_URGENT_RECALL_);
+        }
+        else
+#endif /* QF_URGENT_QUEUE */
+        if (qlen > QF_NORMAL_USED_(me)) { /* free slot in the queue? */
+            /* insert the event in front of the queue (LIFO) */
+            ++me->tail;
+            if (me->tail == (QEQueueCtr)qlen) {
+                me->tail = (QEQueueCtr)0; /* wrap the tail */
+            }
+            QF_ROM_QUEUE_PUT_(acb, me->tail,
+                              QF_ROM_DEFER_AT_(acb, me->dTail));
+            ++me->nUsed;
+#ifdef QF_EQUEUE_USAGE
+            if ((QEQueueIdx)me->nMax < QF_NORMAL_USED_(me)) {
+                me->nMax = (QEQueueCtr)QF_NORMAL_USED_(me);
+            }
+#endif /* QF_EQUEUE_USAGE */
+
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_RECALL)
+                QS_U8_(me->prio);   /* the priority of the active object */
+                QS_SIG_(QF_ROM_QSIG_AT_(acb, me->tail));
+#if (Q_PARAM_SIZE != 0)
+                QS_PAR_(QF_ROM_QPAR_AT_(acb, me->tail));
+#endif
+                QS_EQC_(me->nUsed); /* # events in the queue */
+            QS_END_NOCRIT_()
+
+            /* is this the first event? */
+            if (me->nUsed == (QEQueueCtr)1) {
+                /* set the bit, the AO is running, so no scheduling needed */
+                QF_readySet_ |= (uint_fast8_t)
+                    ((uint_fast8_t)1 << (me->prio - (uint8_t)1));
+            }
+            recalled = true;
+        }
+
+        QF_INT_ENABLE();
+
+        if (recalled) { /* remove the event from the deferral ring buffer */
+            if (me->dTail == (QEQueueCtr)0) {
+                me->dTail = Q_ROM_EQUEUE_CTR(acb->dlen); /* wrap the tail */
+            }
+            --me->dTail;
+            --me->dUsed;
+        }
+    }
+    return recalled;
+}
+
+#endif /* QF_DEFER */
+
 /****************************************************************************/
 /****************************************************************************/
 #if (QF_TIMEEVT_CTR_SIZE != 0)
@@ -387,6 +1567,11 @@ void QF_init(uint_fast8_t maxActive) {
 */
 void QF_tickXISR(uint_fast8_t const tickRate) {
     uint_fast8_t p = QF_maxActive_;
+
+    QS_BEGIN_ISR_(QS_QF_TICK)
+        QS_U8_(tickRate); /* the tick rate */
+    QS_END_ISR_()
+
     do {
         QActive *a = QF_ROM_ACTIVE_GET_(p);
         QTimer *t = &a->tickCtr[tickRate];
@@ -406,6 +1591,11 @@ void QF_tickXISR(uint_fast8_t const tickRate) {
                     ~((uint_fast8_t)1 << (p - (uint_fast8_t)1));
 #endif /* QF_TIMEEVT_USAGE */
 
+                QS_BEGIN_ISR_(QS_QF_TIMEEVT_POST)
+                    QS_U8_(p);        /* the priority of the active object */
+                    QS_U8_(tickRate); /* the tick rate */
+                QS_END_ISR_()
+
 #if (Q_PARAM_SIZE != 0)
                 QACTIVE_POST_ISR(a, (enum_t)Q_TIMEOUT_SIG + (enum_t)tickRate,
                                  (QParam)0);
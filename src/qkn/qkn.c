@@ -40,6 +40,7 @@
 #define QP_IMPL       /* this is QP implementation */
 #include "qpn_conf.h" /* QP-nano configuration file (from the application) */
 #include "qfn_port.h" /* QF-nano port from the port directory */
+#include "qsn.h"      /* QS-nano software tracing interface */
 #include "qassert.h"  /* embedded systems-friendly assertions */
 
 Q_DEFINE_THIS_MODULE("qkn")
@@ -96,6 +97,11 @@ static void initialize(void) {
         Q_ASSERT_ID(110, a != (QActive *)0);
 
         a->prio = (uint8_t)p; /* set the priority of the active object */
+
+        QS_BEGIN_(QS_QF_ACTIVE_ADD)
+            QS_U8_(p);   /* the priority of the active object */
+            QS_OBJ_(a);  /* the active object */
+        QS_END_()
     }
 
     /* trigger initial transitions in all registered active objects... */
@@ -317,18 +323,48 @@ void QK_activate_(void) {
         QF_INT_DISABLE(); /* get ready to access the queue */
 
         /* some unused events must be available */
-        Q_ASSERT_ID(810, a->nUsed > (uint8_t)0);
+        Q_ASSERT_ID(810, a->nUsed > (QEQueueCtr)0);
         --a->nUsed;
 
-        Q_SIG(a) = QF_ROM_QUEUE_AT_(acb, a->tail).sig;
+#ifdef QF_URGENT_QUEUE
+        if (a->uUsed != (QEQueueCtr)0) { /* any urgent events? */
+            --a->uUsed;
+            Q_SIG(a) = QF_ROM_UQUEUE_AT_(acb, a->uTail).sig;
+#if (Q_PARAM_SIZE != 0)
+            Q_PAR(a) = QF_ROM_UQUEUE_AT_(acb, a->uTail).par;
+#endif
+#if (QF_COALESCE_SIZE != 0)
+            QF_COALESCE_CLR_(a, Q_SIG(a), a->uTail); /* no longer waiting */
+#endif /* (QF_COALESCE_SIZE != 0) */
+            /* wrap around? */
+            if (a->uTail == (QEQueueCtr)0) {
+                a->uTail = Q_ROM_EQUEUE_CTR(acb->uqlen);
+            }
+            --a->uTail;
+        }
+        else
+#endif /* QF_URGENT_QUEUE */
+        {
+            Q_SIG(a) = QF_ROM_QSIG_AT_(acb, a->tail);
 #if (Q_PARAM_SIZE != 0)
-        Q_PAR(a) = QF_ROM_QUEUE_AT_(acb, a->tail).par;
+            Q_PAR(a) = QF_ROM_QPAR_AT_(acb, a->tail);
 #endif
-        /* wrap around? */
-        if (a->tail == (uint8_t)0) {
-            a->tail = Q_ROM_BYTE(acb->qlen);
+#if (QF_COALESCE_SIZE != 0)
+            QF_COALESCE_CLR_(a, Q_SIG(a), a->tail); /* no longer waiting */
+#endif /* (QF_COALESCE_SIZE != 0) */
+            /* wrap around? */
+            if (a->tail == (QEQueueCtr)0) {
+                a->tail = Q_ROM_EQUEUE_CTR(acb->qlen);
+            }
+            --a->tail;
         }
-        --a->tail;
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_GET)
+            QS_U8_(p);         /* the priority of the active object */
+            QS_SIG_(Q_SIG(a)); /* the signal of the event */
+            QS_EQC_(a->nUsed); /* # events left in the queue */
+        QS_END_NOCRIT_()
+
         QF_INT_ENABLE(); /* enable interrupts to launch a task */
 
         QHSM_DISPATCH(&a->super); /* dispatch to the SM (execute RTC step) */
@@ -336,7 +372,7 @@ void QK_activate_(void) {
         QF_INT_DISABLE();
 
 
-        if (a->nUsed == (uint8_t)0) { /* empty queue? */
+        if (a->nUsed == (QEQueueCtr)0) { /* empty queue? */
             /* clear the ready bit */
             QF_readySet_ &= (uint_fast8_t)
                 ~((uint_fast8_t)1 << (p - (uint_fast8_t)1));
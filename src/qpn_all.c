@@ -0,0 +1,89 @@
+/**
+* @file
+* @brief Amalgamation of the QP-nano core in a single translation unit
+* @ingroup qepn qfn qvn qkn
+* @cond
+******************************************************************************
+* Last updated for version 6.0.4
+* Last updated on  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* http://www.state-machine.com
+* mailto:info@state-machine.com
+******************************************************************************
+* @endcond
+*/
+#define QP_IMPL       /* this is QP implementation */
+#include "qpn_conf.h" /* QP-nano configuration file (from the application) */
+#include "qfn_port.h" /* QF-nano port from the port directory */
+
+/****************************************************************************/
+/**
+* @description
+* This file compiles the QEP-nano, QF-nano, the kernel (QV-nano or QK-nano,
+* as selected by the port), and QS-nano (only when Q_SPY is defined) as
+* one translation unit. It is built *instead* of qepn.c, qfn.c, qvn.c/qkn.c
+* and qsn.c, so that a compiler without link-time optimization can inline
+* and specialize the calls between them (e.g., QActive_postX_(), QF_run()
+* and the QHsm_dispatch_() reached through the virtual table). The
+* port-specific source files (e.g., qvn_port.c) are still built separately.
+*
+* The amalgamation includes the original source files, so it is always in
+* sync with them. The only conflict between the files is the assertion
+* module name Q_this_module_ (see Q_DEFINE_THIS_MODULE()), which is renamed
+* for every file, so the assertions still report the original module name.
+*
+* @note
+* The include directories must be the same as for the separate source
+* files (the application directory with qpn_conf.h, the port directory and
+* the QP-nano include directory).
+*/
+#define Q_this_module_ Q_this_module_qepn_
+#include "qfn/qepn.c"
+#undef Q_this_module_
+
+#define Q_this_module_ Q_this_module_qfn_
+#include "qfn/qfn.c"
+#undef Q_this_module_
+
+#if defined(QK_PREEMPTIVE)
+    #define Q_this_module_ Q_this_module_qkn_
+    #include "qkn/qkn.c"
+    #undef Q_this_module_
+#elif defined(QV_COOPERATIVE)
+    #define Q_this_module_ Q_this_module_qvn_
+    #include "qvn/qvn.c"
+    #undef Q_this_module_
+#else
+    #error "The port must be based on the QV-nano or QK-nano kernel"
+#endif
+
+#ifdef Q_SPY
+    #define Q_this_module_ Q_this_module_qsn_
+    #include "qsn/qsn.c"
+    #undef Q_this_module_
+#endif /* Q_SPY */
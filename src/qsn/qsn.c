@@ -0,0 +1,390 @@
+/**
+* @file
+* @brief QS-nano implementation.
+* @ingroup qsn
+* @cond
+******************************************************************************
+* Last updated for version 6.0.4
+* Last updated on  2018-01-16
+*
+*                    Q u a n t u m     L e a P s
+*                    ---------------------------
+*                    innovating embedded systems
+*
+* Copyright (C) Quantum Leaps, LLC. All rights reserved.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* Alternatively, this program may be distributed and modified under the
+* terms of Quantum Leaps commercial licenses, which expressly supersede
+* the GNU General Public License and are specifically designed for
+* licensees interested in retaining the proprietary status of their code.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+* Contact information:
+* https://state-machine.com
+* mailto:info@state-machine.com
+******************************************************************************
+* @endcond
+*/
+#define QP_IMPL       /* this is QP implementation */
+#include "qpn_conf.h" /* QP-nano configuration file (from the application) */
+#include "qfn_port.h" /* QF-nano port from the port directory */
+#include "qsn.h"      /* QS-nano software tracing interface */
+#include "qassert.h"  /* embedded systems-friendly assertions */
+
+#ifndef Q_SPY
+    #error "Q_SPY must be defined to compile qsn.c"
+#endif /* Q_SPY */
+
+Q_DEFINE_THIS_MODULE("qsn")
+
+/* Public-scope objects *****************************************************/
+QSPriv QS_priv_; /* QS-nano private attributes */
+
+/****************************************************************************/
+/**
+* @description
+* Initializes the QS-nano ring buffer and produces the ::QS_TARGET_INFO
+* record, which allows the host to decode the configuration-dependent
+* parts of the subsequent records.
+*
+* @param[in] sto     memory block for the QS-nano ring buffer
+* @param[in] stoSize size of the memory block [bytes], must be at least
+*                    16 bytes and must not exceed 0xFFFF bytes.
+*
+* @note QS_initBuf() must be called before any other QS-nano service and
+* before QF_init().
+*/
+void QS_initBuf(uint8_t sto[], uint_fast16_t const stoSize) {
+    /** @pre the buffer must be big enough and within the QSCtr range */
+    Q_REQUIRE_ID(100, ((uint_fast16_t)16 <= stoSize)
+                      && (stoSize <= (uint_fast16_t)0xFFFF));
+
+    QS_priv_.buf      = &sto[0];
+    QS_priv_.end      = (QSCtr)stoSize;
+    QS_priv_.head     = (QSCtr)0;
+    QS_priv_.tail     = (QSCtr)0;
+    QS_priv_.rd       = (QSCtr)0;
+    QS_priv_.wr       = (QSCtr)0;
+    QS_priv_.seq      = (uint8_t)0;
+    QS_priv_.ovf      = (uint8_t)0;
+    QS_priv_.dropped  = (uint16_t)0;
+    QS_priv_.lastTime = QS_onGetTime();
+
+    QF_INT_DISABLE();
+    QS_beginRec_((uint_fast8_t)QS_TARGET_INFO);
+    QS_uvar_((uint32_t)QP_VERSION);
+    QS_u8_((uint8_t)Q_PARAM_SIZE);
+    QS_u8_((uint8_t)QF_TIMEEVT_CTR_SIZE);
+    QS_u8_((uint8_t)QF_MAX_TICK_RATE);
+    QS_u8_((uint8_t)QS_TIME_SIZE);
+    QS_u8_((uint8_t)sizeof(void *));
+    QS_u8_((uint8_t)QF_EQUEUE_CTR_SIZE);
+    QS_endRec_();
+    QF_INT_ENABLE();
+}
+
+/****************************************************************************/
+/**
+* @description
+* Starts a new trace record with the record header. The header consists
+* of the record type, the sequence number, and the time elapsed since the
+* last committed record.
+*
+* @note This internal function must be called inside a critical section.
+*/
+void QS_beginRec_(uint_fast8_t const rec) {
+    QS_priv_.wr   = QS_priv_.head; /* start right after the last record */
+    QS_priv_.ovf  = (uint8_t)0;
+    QS_priv_.time = QS_onGetTime();
+    QS_u8_((uint8_t)rec);
+    QS_u8_(QS_priv_.seq);
+    QS_uvar_((uint32_t)(QSTimeCtr)(QS_priv_.time - QS_priv_.lastTime));
+}
+
+/****************************************************************************/
+/**
+* @description
+* Commits the current record by publishing the new head of the ring buffer
+* to the consumer. If the record did not fit into the ring buffer, it is
+* dropped as a whole, which leaves the consumer's data intact.
+*
+* @note This internal function must be called inside a critical section.
+*/
+void QS_endRec_(void) {
+    if (QS_priv_.ovf == (uint8_t)0) {
+        QS_MEM_BARRIER(); /* the data must be written before the head */
+        QS_priv_.head     = QS_priv_.wr; /* publish the record */
+        QS_priv_.lastTime = QS_priv_.time;
+        ++QS_priv_.seq;
+    }
+    else {
+        ++QS_priv_.dropped;
+    }
+}
+
+/****************************************************************************/
+/**
+* @description
+* Appends one byte to the current record. Once the current record
+* overflows the ring buffer, all remaining bytes of the record are ignored.
+*/
+void QS_u8_(uint8_t const d) {
+    QSCtr wr = QS_priv_.wr;
+    QSCtr next = (QSCtr)(wr + (QSCtr)1);
+
+    if (next == QS_priv_.end) { /* wrap around? */
+        next = (QSCtr)0;
+    }
+    if (QS_priv_.ovf == (uint8_t)0) {
+        if (next != QS_priv_.tail) { /* any free space left? */
+            QS_priv_.buf[wr] = d;
+            QS_priv_.wr = next;
+        }
+        else {
+            QS_priv_.ovf = (uint8_t)1; /* the record does not fit */
+        }
+    }
+}
+
+/****************************************************************************/
+/**
+* @description
+* Appends an unsigned variable-length integer to the current record,
+* 7 bits at a time, starting with the least-significant group.
+*/
+void QS_uvar_(uint32_t d) {
+    while (d >= (uint32_t)0x80) {
+        QS_u8_((uint8_t)((d & (uint32_t)0x7F) | (uint32_t)0x80));
+        d >>= 7;
+    }
+    QS_u8_((uint8_t)d);
+}
+
+/****************************************************************************/
+/*! helper function to output a signed address offset in zig-zag encoding */
+static void QS_zigzag_(uintptr_t const addr, uintptr_t const ref) {
+    uintptr_t d;
+    if (addr >= ref) {
+        d = (uintptr_t)((addr - ref) << 1);
+    }
+    else {
+        d = (uintptr_t)((((ref - addr) - (uintptr_t)1) << 1) | (uintptr_t)1);
+    }
+    while (d >= (uintptr_t)0x80) { /* the offset can exceed 32 bits */
+        QS_u8_((uint8_t)((d & (uintptr_t)0x7F) | (uintptr_t)0x80));
+        d >>= 7;
+    }
+    QS_u8_((uint8_t)d);
+}
+
+/****************************************************************************/
+/**
+* @description
+* Appends a state-handler function to the current record as the signed
+* offset from QHsm_top().
+*/
+void QS_fun_(QStateHandler const fun) {
+    QS_zigzag_((uintptr_t)fun, (uintptr_t)Q_STATE_CAST(&QHsm_top));
+}
+
+/****************************************************************************/
+/**
+* @description
+* Appends an object pointer to the current record as the signed offset
+* from the ::QS_priv_ object.
+*/
+void QS_obj_(void const * const obj) {
+    QS_zigzag_((uintptr_t)obj, (uintptr_t)&QS_priv_);
+}
+
+/****************************************************************************/
+/**
+* @description
+* Appends a zero-terminated string to the current record.
+*/
+void QS_str_(char_t const *s) {
+    while (*s != (char_t)'\0') {
+        QS_u8_((uint8_t)*s);
+        ++s;
+    }
+    QS_u8_((uint8_t)0); /* zero-terminate the string */
+}
+
+/****************************************************************************/
+/**
+* @description
+* Produces the signal dictionary record. This function should be called
+* only through the macro QS_SIG_DICTIONARY().
+*/
+void QS_sigDict_(enum_t const sig, void const * const obj,
+                 char_t const *name)
+{
+    QF_INT_DISABLE();
+    QS_beginRec_((uint_fast8_t)QS_SIG_DICT);
+    QS_uvar_((uint32_t)sig);
+    QS_obj_(obj);
+    QS_str_(name);
+    QS_endRec_();
+    QF_INT_ENABLE();
+}
+
+/****************************************************************************/
+/**
+* @description
+* Produces the object dictionary record. This function should be called
+* only through the macro QS_OBJ_DICTIONARY().
+*/
+void QS_objDict_(void const * const obj, char_t const *name) {
+    if (*name == (char_t)'&') { /* skip the address-of operator */
+        ++name;
+    }
+    QF_INT_DISABLE();
+    QS_beginRec_((uint_fast8_t)QS_OBJ_DICT);
+    QS_obj_(obj);
+    QS_str_(name);
+    QS_endRec_();
+    QF_INT_ENABLE();
+}
+
+/****************************************************************************/
+/**
+* @description
+* Produces the object dictionary record of the element @p idx of the
+* array @p name, with the name of the form "name[idx]". This function
+* should be called only through the macro QS_OBJ_ARR_DICTIONARY().
+*/
+void QS_objArrDict_(void const * const obj, uint_fast16_t const idx,
+                    char_t const *name)
+{
+    uint_fast16_t div = (uint_fast16_t)1;
+
+    while ((idx / div) >= (uint_fast16_t)10) { /* the most significant */
+        div *= (uint_fast16_t)10;
+    }
+    QF_INT_DISABLE();
+    QS_beginRec_((uint_fast8_t)QS_OBJ_DICT);
+    QS_obj_(obj);
+    while (*name != (char_t)'\0') { /* the array name, not terminated */
+        QS_u8_((uint8_t)*name);
+        ++name;
+    }
+    QS_u8_((uint8_t)'[');
+    for (; div > (uint_fast16_t)0; div /= (uint_fast16_t)10) {
+        QS_u8_((uint8_t)((uint_fast16_t)'0' + ((idx / div) % 10U)));
+    }
+    QS_u8_((uint8_t)']');
+    QS_u8_((uint8_t)0); /* zero-terminate the name */
+    QS_endRec_();
+    QF_INT_ENABLE();
+}
+
+/****************************************************************************/
+/**
+* @description
+* Produces the function dictionary record. This function should be called
+* only through the macro QS_FUN_DICTIONARY().
+*/
+void QS_funDict_(QStateHandler const fun, char_t const *name) {
+    if (*name == (char_t)'&') { /* skip the address-of operator */
+        ++name;
+    }
+    QF_INT_DISABLE();
+    QS_beginRec_((uint_fast8_t)QS_FUN_DICT);
+    QS_fun_(fun);
+    QS_str_(name);
+    QS_endRec_();
+    QF_INT_ENABLE();
+}
+
+/****************************************************************************/
+/**
+* @description
+* Extracts one byte from the QS-nano ring buffer. This function can be
+* called concurrently with the QP-nano code producing the trace records.
+*
+* @returns the byte in the least-significant 8 bits of the 16-bit return
+* value, or #QS_EOD if no more data is available.
+*/
+uint16_t QS_getByte(void) {
+    QSCtr rd = QS_priv_.rd;
+    uint16_t ret;
+
+    if (rd != QS_priv_.head) { /* any data available? */
+        QS_MEM_BARRIER(); /* the head must be read before the data */
+        ret = (uint16_t)QS_priv_.buf[rd];
+        ++rd;
+        if (rd == QS_priv_.end) { /* wrap around? */
+            rd = (QSCtr)0;
+        }
+        QS_priv_.rd = rd;
+        QS_MEM_BARRIER(); /* the data must be read before freeing it */
+        QS_priv_.tail = rd; /* free the space for the producer */
+    }
+    else {
+        ret = QS_EOD;
+    }
+    return ret;
+}
+
+/****************************************************************************/
+/**
+* @description
+* Extracts a contiguous block of data from the QS-nano ring buffer. This
+* function can be called concurrently with the QP-nano code producing the
+* trace records.
+*
+* @param[in,out] pNbytes on input the maximum number of bytes to extract,
+*                        on output the actual number of bytes extracted
+*
+* @returns pointer to the block of data, or NULL if no data is available.
+*
+* @note The returned block remains reserved (the producer cannot overwrite
+* it) until the next call to QS_getBlock() or QS_getByte(), so the caller
+* can send the data directly from the ring buffer. The block might be
+* shorter than the available data when the data wraps around the end of
+* the ring buffer. In that case, the next call to QS_getBlock() returns
+* the rest of the data.
+*/
+uint8_t const *QS_getBlock(uint16_t * const pNbytes) {
+    QSCtr rd = QS_priv_.rd;
+    QSCtr head = QS_priv_.head;
+    uint8_t const *block = (uint8_t const *)0;
+    QSCtr n;
+
+    QS_priv_.tail = rd; /* free the previously returned block */
+    if (rd != head) { /* any data available? */
+        QS_MEM_BARRIER(); /* the head must be read before the data */
+        if (rd < head) {
+            n = (QSCtr)(head - rd);
+        }
+        else {
+            n = (QSCtr)(QS_priv_.end - rd); /* up to the end of buffer */
+        }
+        if (n > (QSCtr)*pNbytes) {
+            n = (QSCtr)*pNbytes;
+        }
+        block = &QS_priv_.buf[rd];
+        rd = (QSCtr)(rd + n);
+        if (rd == QS_priv_.end) { /* wrap around? */
+            rd = (QSCtr)0;
+        }
+        QS_priv_.rd = rd; /* the block stays reserved until the next call */
+        *pNbytes = (uint16_t)n;
+    }
+    else {
+        *pNbytes = (uint16_t)0;
+    }
+    return block;
+}